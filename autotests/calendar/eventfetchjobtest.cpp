@@ -67,6 +67,27 @@ private Q_SLOTS:
         QVERIFY(returnedEvent);
         QCOMPARE(*returnedEvent, *event);
     }
+
+    void testFetchProjected()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/events_fetch_projected_request.txt"), QFINDTESTDATA("data/events_fetch_projected_response.txt"))});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new EventFetchJob(QStringLiteral("MockAccount"), account);
+        job->setMaxResults(5000);
+        QCOMPARE(job->maxResults(), 2500);
+        job->setFields(EventFetchJob::FieldShorthands::summaryFields());
+        QVERIFY(execJob(job));
+        const auto items = job->items();
+        QCOMPARE(items.count(), 1);
+        const auto returnedEvent = items.at(0).dynamicCast<Event>();
+        QVERIFY(returnedEvent);
+        QCOMPARE(returnedEvent->summary(), QStringLiteral("Test event"));
+        QCOMPARE(returnedEvent->status(), KCalendarCore::Incidence::StatusConfirmed);
+        QVERIFY(returnedEvent->attendees().isEmpty());
+        QCOMPARE(job->syncToken(), QStringLiteral("CKDXoLWdm9oCEKDXoLWdm9oCGAU="));
+    }
 };
 
 QTEST_GUILESS_MAIN(EventFetchJobTest)
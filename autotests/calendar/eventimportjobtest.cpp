@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "calendartestutils.h"
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "event.h"
+#include "eventimportjob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+Q_DECLARE_METATYPE(QList<FakeNetworkAccessManager::Scenario>)
+
+class EventImportJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testImportSkipsExisting()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/events_fetch_uids_request.txt"), QFINDTESTDATA("data/events_fetch_uids_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/event1_create_request.txt"), QFINDTESTDATA("data/event1_create_response.txt"))});
+
+        const auto event1 = eventFromFile(QFINDTESTDATA("data/event1.json"));
+        const auto event2 = eventFromFile(QFINDTESTDATA("data/event2.json"));
+        const auto event1Duplicate = EventPtr::create(*event1);
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new EventImportJob(EventsList{event1, event2, event1Duplicate}, QStringLiteral("MockAccount"), account);
+        QSignalSpy processedSpy(job, &EventImportJob::eventProcessed);
+        QVERIFY(execJob(job));
+
+        QCOMPARE(processedSpy.count(), 3);
+        const auto items = job->items();
+        QCOMPARE(items.count(), 1);
+        const auto returnedEvent = items.at(0).dynamicCast<Event>();
+        QVERIFY(returnedEvent);
+        QCOMPARE(*returnedEvent, *event1);
+
+        QCOMPARE(job->skippedEvents(), EventsList({event2, event1Duplicate}));
+        QVERIFY(job->failedEvents().isEmpty());
+    }
+
+    void testImportWithKnownUids()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/event1_create_request.txt"), QFINDTESTDATA("data/event1_create_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/event2_create_request.txt"), QFINDTESTDATA("data/event2_create_response.txt"))});
+
+        const auto event1 = eventFromFile(QFINDTESTDATA("data/event1.json"));
+        const auto event2 = eventFromFile(QFINDTESTDATA("data/event2.json"));
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new EventImportJob(EventsList{event1, event2}, QStringLiteral("MockAccount"), account);
+        job->setExistingUids({});
+        QVERIFY(execJob(job));
+
+        const auto items = job->items();
+        QCOMPARE(items.count(), 2);
+        QCOMPARE(*items.at(0).dynamicCast<Event>(), *event1);
+        QCOMPARE(*items.at(1).dynamicCast<Event>(), *event2);
+        QVERIFY(job->skippedEvents().isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(EventImportJobTest)
+
+#include "eventimportjobtest.moc"
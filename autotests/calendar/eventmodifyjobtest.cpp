@@ -71,6 +71,26 @@ private Q_SLOTS:
             QCOMPARE(*returnedEvent, *events.at(i));
         }
     }
+
+    void testPatch()
+    {
+        const auto original = eventFromFile(QFINDTESTDATA("data/event1.json"));
+        auto modified = EventPtr::create(*original);
+        modified->setSummary(QStringLiteral("Cooler Meeting about stuff"));
+
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/event1_patch_request.txt"), QFINDTESTDATA("data/event1_patch_response.txt"))});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new EventModifyJob(modified, QStringLiteral("MockAccount"), account);
+        job->setOriginalEvents({original});
+        QVERIFY(execJob(job));
+        const auto items = job->items();
+        QCOMPARE(items.count(), 1);
+        const auto returnedEvent = items.at(0).dynamicCast<Event>();
+        QVERIFY(returnedEvent);
+        QCOMPARE(*returnedEvent, *modified);
+    }
 };
 
 QTEST_GUILESS_MAIN(EventModifyJobTest)
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QTest>
+
+#include "calendartestutils.h"
+
+#include "event.h"
+#include "freebusyindex.h"
+#include "types.h"
+
+#include <KCalendarCore/Recurrence>
+
+using namespace KGAPI2;
+
+namespace
+{
+const QTimeZone tz("Europe/Prague");
+
+EventPtr makeEvent(const QString &uid, const QDateTime &start, const QDateTime &end)
+{
+    auto event = EventPtr::create();
+    event->setUid(uid);
+    event->setDtStart(start);
+    event->setDtEnd(end);
+    event->setStatus(KCalendarCore::Incidence::StatusConfirmed);
+    event->setTransparency(Event::Opaque);
+    return event;
+}
+
+QDateTime dt(int day, int hour, int minute = 0)
+{
+    return QDateTime({2018, 4, day}, {hour, minute, 0}, tz);
+}
+}
+
+class FreeBusyIndexTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testBusyMerged()
+    {
+        FreeBusyIndex index(dt(1, 0), dt(8, 0));
+        auto transparent = makeEvent(QStringLiteral("transparent"), dt(2, 8), dt(2, 18));
+        transparent->setTransparency(Event::Transparent);
+        auto cancelled = makeEvent(QStringLiteral("cancelled"), dt(2, 14), dt(2, 15));
+        cancelled->setStatus(KCalendarCore::Incidence::StatusCanceled);
+        index.setEvents(QStringLiteral("cal1"),
+                        {makeEvent(QStringLiteral("a"), dt(2, 10), dt(2, 11)),
+                         makeEvent(QStringLiteral("b"), dt(2, 10, 30), dt(2, 12)),
+                         makeEvent(QStringLiteral("c"), dt(2, 16), dt(2, 17)),
+                         transparent,
+                         cancelled});
+
+        const auto busy = index.busy(QStringLiteral("cal1"), dt(2, 0), dt(3, 0));
+        QCOMPARE(busy, FreeBusyQueryJob::BusyRangeList({{dt(2, 10), dt(2, 12)}, {dt(2, 16), dt(2, 17)}}));
+
+        // Clipped to the queried range
+        QCOMPARE(index.busy(QStringLiteral("cal1"), dt(2, 11), dt(2, 16, 30)),
+                 FreeBusyQueryJob::BusyRangeList({{dt(2, 11), dt(2, 12)}, {dt(2, 16), dt(2, 16, 30)}}));
+
+        QVERIFY(index.isFree(QStringLiteral("cal1"), dt(2, 12), dt(2, 16)));
+        QVERIFY(index.isFree(QStringLiteral("cal1"), dt(2, 14), dt(2, 15)));
+        QVERIFY(!index.isFree(QStringLiteral("cal1"), dt(2, 11, 59), dt(2, 13)));
+        QVERIFY(!index.isFree(QStringLiteral("unknown"), dt(2, 12), dt(2, 16)));
+    }
+
+    void testRecurrence()
+    {
+        FreeBusyIndex index(dt(1, 0), dt(8, 0));
+        auto daily = makeEvent(QStringLiteral("daily"), dt(1, 9), dt(1, 10));
+        daily->recurrence()->setDaily(1);
+        daily->recurrence()->setDuration(5);
+
+        // Occurrence on the 3rd moved to the afternoon, the one on the 4th cancelled
+        auto moved = makeEvent(QStringLiteral("daily"), dt(3, 14), dt(3, 15));
+        moved->setRecurrenceId(dt(3, 9));
+        auto cancelled = makeEvent(QStringLiteral("daily"), dt(4, 9), dt(4, 10));
+        cancelled->setRecurrenceId(dt(4, 9));
+        cancelled->setStatus(KCalendarCore::Incidence::StatusCanceled);
+
+        index.setEvents(QStringLiteral("cal1"), {daily, moved, cancelled});
+
+        QCOMPARE(index.busy(QStringLiteral("cal1"), dt(1, 0), dt(8, 0)),
+                 FreeBusyQueryJob::BusyRangeList({{dt(1, 9), dt(1, 10)},
+                                                  {dt(2, 9), dt(2, 10)},
+                                                  {dt(3, 14), dt(3, 15)},
+                                                  {dt(5, 9), dt(5, 10)}}));
+    }
+
+    void testMultipleCalendars()
+    {
+        FreeBusyIndex index(dt(1, 0), dt(8, 0));
+        index.setEvents(QStringLiteral("room1"), {makeEvent(QStringLiteral("a"), dt(2, 10), dt(2, 11))});
+        index.setEvents(QStringLiteral("room2"), {makeEvent(QStringLiteral("b"), dt(2, 10, 30), dt(2, 12))});
+        index.setEvents(QStringLiteral("room3"), {makeEvent(QStringLiteral("c"), dt(2, 13), dt(2, 14))});
+
+        const QStringList rooms = {QStringLiteral("room1"), QStringLiteral("room2"), QStringLiteral("room3")};
+        QCOMPARE(index.mergedBusy(rooms, dt(2, 0), dt(3, 0)), FreeBusyQueryJob::BusyRangeList({{dt(2, 10), dt(2, 12)}, {dt(2, 13), dt(2, 14)}}));
+        QCOMPARE(index.freeCalendars(rooms, dt(2, 11), dt(2, 13)), QStringList({QStringLiteral("room1"), QStringLiteral("room3")}));
+
+        const auto busyMap = index.busy(rooms, dt(2, 0), dt(3, 0));
+        QCOMPARE(busyMap.size(), 3);
+        QCOMPARE(busyMap.value(QStringLiteral("room3")), FreeBusyQueryJob::BusyRangeList({{dt(2, 13), dt(2, 14)}}));
+
+        index.removeCalendar(QStringLiteral("room2"));
+        QCOMPARE(index.freeCalendars(rooms, dt(2, 11), dt(2, 13)), QStringList({QStringLiteral("room1"), QStringLiteral("room3")}));
+        QCOMPARE(index.mergedBusy(rooms, dt(2, 0), dt(3, 0)), FreeBusyQueryJob::BusyRangeList({{dt(2, 10), dt(2, 11)}, {dt(2, 13), dt(2, 14)}}));
+    }
+};
+
+QTEST_GUILESS_MAIN(FreeBusyIndexTest)
+
+#include "freebusyindextest.moc"
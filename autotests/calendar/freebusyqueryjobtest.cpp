@@ -70,6 +70,36 @@ private Q_SLOTS:
             QCOMPARE(returnedFreeBusy, ranges.at(i));
         }
     }
+
+    void testMultiQuery()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/freebusy2_query_request.txt"), QFINDTESTDATA("data/freebusy2_query_response.txt"))});
+
+        const QStringList ids = {QStringLiteral("MockAccount"),
+                                 QStringLiteral("room1@resource.calendar.google.com"),
+                                 QStringLiteral("missing@resource.calendar.google.com")};
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new FreeBusyQueryJob(ids,
+                                        QDateTime({2018, 4, 1}, {10, 0, 0}, QTimeZone("Europe/Prague")),
+                                        QDateTime({2018, 4, 2}, {16, 0, 0}, QTimeZone("Europe/Prague")),
+                                        account);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+
+        const auto busy = job->busyMap();
+        QCOMPARE(busy.size(), 2);
+        QCOMPARE(busy.value(ids[0]),
+                 FreeBusyQueryJob::BusyRangeList({{{{2018, 4, 1}, {12, 30, 0}, QTimeZone("Europe/Prague")},
+                                                   {{2018, 4, 1}, {13, 30, 0}, QTimeZone("Europe/Prague")}}}));
+        QCOMPARE(busy.value(ids[1]),
+                 FreeBusyQueryJob::BusyRangeList({{{{2018, 4, 1}, {15, 0, 0}, QTimeZone("Europe/Prague")},
+                                                   {{2018, 4, 1}, {16, 30, 0}, QTimeZone("Europe/Prague")}}}));
+
+        const auto errors = job->calendarErrors();
+        QCOMPARE(errors.size(), 1);
+        QCOMPARE(errors.value(ids[2]), QStringLiteral("notFound"));
+    }
 };
 
 QTEST_GUILESS_MAIN(FreeBusyQueryJobTest)
@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QTest>
+
+#include "bandwidthlimiter.h"
+
+using namespace KGAPI2::Drive;
+
+static const QString Account1 = QStringLiteral("account1@gmail.com");
+static const QString Account2 = QStringLiteral("account2@gmail.com");
+static constexpr qint64 Rate = 10000;
+static constexpr qint64 ChunkSize = 1024 * 1024;
+
+class BandwidthLimiterTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testUnlimited()
+    {
+        BandwidthLimiter limiter;
+        QVERIFY(!limiter.isLimited(Account1, BandwidthLimiter::Download));
+        QCOMPARE(limiter.acquire(Account1, BandwidthLimiter::Download, BandwidthLimiter::Background, ChunkSize), ChunkSize);
+        QCOMPARE(limiter.msecsUntilAvailable(Account1, BandwidthLimiter::Download), 0);
+    }
+
+    void testGlobalLimit()
+    {
+        BandwidthLimiter limiter;
+        limiter.setRate(BandwidthLimiter::Download, Rate);
+        QCOMPARE(limiter.rate(BandwidthLimiter::Download), Rate);
+        QVERIFY(limiter.isLimited(Account1, BandwidthLimiter::Download));
+        QVERIFY(!limiter.isLimited(Account1, BandwidthLimiter::Upload));
+
+        // At most one second worth of data at once
+        QCOMPARE(limiter.acquire(Account1, BandwidthLimiter::Download, BandwidthLimiter::Background, ChunkSize), Rate);
+        QVERIFY(limiter.acquire(Account2, BandwidthLimiter::Download, BandwidthLimiter::Background, ChunkSize) < 5000);
+        QVERIFY(limiter.msecsUntilAvailable(Account1, BandwidthLimiter::Download) > 0);
+
+        // Uploads have a separate budget
+        QCOMPARE(limiter.acquire(Account1, BandwidthLimiter::Upload, BandwidthLimiter::Background, ChunkSize), ChunkSize);
+    }
+
+    void testInteractive()
+    {
+        BandwidthLimiter limiter;
+        limiter.setRate(BandwidthLimiter::Upload, Rate);
+
+        // Interactive transfers are never delayed, but background ones have to wait for them
+        QCOMPARE(limiter.acquire(Account1, BandwidthLimiter::Upload, BandwidthLimiter::Interactive, 5 * Rate), 5 * Rate);
+        QCOMPARE(limiter.acquire(Account1, BandwidthLimiter::Upload, BandwidthLimiter::Background, 1000), qint64(0));
+        QVERIFY(limiter.msecsUntilAvailable(Account1, BandwidthLimiter::Upload) > 1000);
+    }
+
+    void testInteractiveDebt()
+    {
+        BandwidthLimiter limiter;
+        limiter.setRate(BandwidthLimiter::Download, Rate);
+
+        // A huge interactive transfer does not block background ones for minutes
+        QCOMPARE(limiter.acquire(Account1, BandwidthLimiter::Download, BandwidthLimiter::Interactive, 100 * Rate), 100 * Rate);
+        QCOMPARE(limiter.acquire(Account1, BandwidthLimiter::Download, BandwidthLimiter::Background, 1000), qint64(0));
+        const int wait = limiter.msecsUntilAvailable(Account1, BandwidthLimiter::Download);
+        QVERIFY(wait > 1000);
+        QVERIFY(wait <= 2000);
+    }
+
+    void testAccountLimit()
+    {
+        BandwidthLimiter limiter;
+        limiter.setAccountRate(Account1, BandwidthLimiter::Download, Rate);
+        QCOMPARE(limiter.accountRate(Account1, BandwidthLimiter::Download), Rate);
+        QVERIFY(limiter.isLimited(Account1, BandwidthLimiter::Download));
+        QVERIFY(!limiter.isLimited(Account2, BandwidthLimiter::Download));
+
+        QCOMPARE(limiter.acquire(Account1, BandwidthLimiter::Download, BandwidthLimiter::Background, ChunkSize), Rate);
+        QCOMPARE(limiter.acquire(Account2, BandwidthLimiter::Download, BandwidthLimiter::Background, ChunkSize), ChunkSize);
+
+        // The stricter of the global and the account limit applies
+        limiter.setRate(BandwidthLimiter::Download, Rate / 2);
+        QCOMPARE(limiter.acquire(Account2, BandwidthLimiter::Download, BandwidthLimiter::Background, ChunkSize), Rate / 2);
+
+        limiter.setAccountRate(Account1, BandwidthLimiter::Download, 0);
+        QCOMPARE(limiter.accountRate(Account1, BandwidthLimiter::Download), qint64(0));
+    }
+};
+
+QTEST_GUILESS_MAIN(BandwidthLimiterTest)
+
+#include "bandwidthlimitertest.moc"
@@ -40,6 +40,7 @@ private Q_SLOTS:
         auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
         auto job = new Drive::ChangeFetchJob(account);
         QVERIFY(execJob(job));
+        QCOMPARE(job->largestChangeId(), qlonglong(82418));
         const auto items = job->items();
         QCOMPARE(items.count(), changes.count());
         for (int i = 0; i < changes.count(); ++i) {
@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "drivetestutils.h"
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "drivemirror.h"
+#include "file.h"
+#include "parentreference.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+class DriveMirrorTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testSynchronize()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString storePath = dir.filePath(QStringLiteral("mirror.json"));
+
+        const auto file1 = fileFromFile(QFINDTESTDATA("data/file1.json"));
+        const auto file2 = fileFromFile(QFINDTESTDATA("data/file2.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+
+        {
+            FakeNetworkAccessManagerFactory::get()->setScenarios(
+                {scenarioFromFile(QFINDTESTDATA("data/about_fetch_request.txt"), QFINDTESTDATA("data/about_fetch_response.txt")),
+                 scenarioFromFile(QFINDTESTDATA("data/mirror_files_request.txt"), QFINDTESTDATA("data/mirror_files_response.txt"))});
+
+            Drive::DriveMirror mirror(account, storePath);
+            QVERIFY(!mirror.isValid());
+            QSignalSpy syncSpy(&mirror, &Drive::DriveMirror::synchronized);
+            mirror.synchronize();
+            QVERIFY(mirror.isSynchronizing());
+            QVERIFY(syncSpy.wait());
+            QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+            QVERIFY(mirror.isValid());
+            QCOMPARE(mirror.largestChangeId(), qlonglong(82418));
+            QCOMPARE(mirror.rootFolderId(), QStringLiteral("0AL9w2vIqdW-OUk9PVA"));
+            QCOMPARE(mirror.files().count(), 2);
+            QCOMPARE(*mirror.file(file1->id()), *file1);
+            QCOMPARE(mirror.children(QStringLiteral("someparentfolderid")).count(), 1);
+            QCOMPARE(mirror.search(QStringLiteral("dsc_")).count(), 1);
+            QCOMPARE(mirror.search(QStringLiteral("dsc_")).constFirst()->id(), file2->id());
+        }
+
+        // The state is persisted, so only the changes are fetched
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/mirror_changes_request.txt"), QFINDTESTDATA("data/mirror_changes_response.txt"))});
+
+        Drive::DriveMirror mirror(account, storePath);
+        QVERIFY(mirror.isValid());
+        QCOMPARE(mirror.files().count(), 2);
+        QCOMPARE(*mirror.file(file1->id()), *file1);
+        QCOMPARE(*mirror.file(file2->id()), *file2);
+        QCOMPARE(mirror.children(QStringLiteral("someparentfolderid")).count(), 1);
+
+        QSignalSpy syncSpy(&mirror, &Drive::DriveMirror::synchronized);
+        QSignalSpy removedSpy(&mirror, &Drive::DriveMirror::fileRemoved);
+        QSignalSpy changedSpy(&mirror, &Drive::DriveMirror::fileChanged);
+        mirror.synchronize();
+        QVERIFY(syncSpy.wait());
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        QCOMPARE(mirror.largestChangeId(), qlonglong(82420));
+        QCOMPARE(removedSpy.count(), 1);
+        QCOMPARE(removedSpy.at(0).at(1).toString(), file1->id());
+        QCOMPARE(changedSpy.count(), 1);
+        QCOMPARE(changedSpy.at(0).at(1).toString(), file2->id());
+        QVERIFY(!mirror.file(file1->id()));
+        QCOMPARE(mirror.files().count(), 1);
+        QVERIFY(mirror.children(QStringLiteral("someparentfolderid")).isEmpty());
+        const auto moved = mirror.children(QStringLiteral("newparentfolderid"));
+        QCOMPARE(moved.count(), 1);
+        QCOMPARE(moved.constFirst()->id(), file2->id());
+    }
+};
+
+QTEST_GUILESS_MAIN(DriveMirrorTest)
+
+#include "drivemirrortest.moc"
@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "drivepathresolver.h"
+#include "file.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+Drive::FilePtr makeFile(const QString &id, const QString &title, const QString &parentId, bool folder = false)
+{
+    const QString parent = parentId.isEmpty() ? QStringLiteral(R"({"kind": "drive#parentReference", "id": "rootid", "isRoot": true})")
+                                              : QStringLiteral(R"({"kind": "drive#parentReference", "id": "%1", "isRoot": false})").arg(parentId);
+    const QString json = QStringLiteral(R"({"kind": "drive#file", "id": "%1", "title": "%2", "mimeType": "%3", "parents": [%4]})")
+                             .arg(id, title, folder ? Drive::File::folderMimeType() : QStringLiteral("application/pdf"), parent);
+    return Drive::File::fromJSON(json.toUtf8());
+}
+}
+
+class DrivePathResolverTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testCachedPaths()
+    {
+        // No requests are expected, all paths are resolved from the cache
+        FakeNetworkAccessManagerFactory::get()->setScenarios({});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        Drive::DrivePathResolver resolver(account);
+        resolver.updateFile(makeFile(QStringLiteral("projects"), QStringLiteral("Projects"), QString(), true));
+        resolver.updateFile(makeFile(QStringLiteral("2026"), QStringLiteral("2026"), QStringLiteral("projects"), true));
+        resolver.updateFile(makeFile(QStringLiteral("report"), QStringLiteral("report.pdf"), QStringLiteral("2026")));
+        resolver.updateFile(makeFile(QStringLiteral("archive"), QStringLiteral("Archive"), QString(), true));
+
+        QCOMPARE(resolver.cachedFileId(QStringLiteral("/")), QStringLiteral("root"));
+        QCOMPARE(resolver.cachedFileId(QStringLiteral("/Projects")), QStringLiteral("projects"));
+        QCOMPARE(resolver.cachedFileId(QStringLiteral("/Projects/2026/report.pdf")), QStringLiteral("report"));
+        QCOMPARE(resolver.cachedFileId(QStringLiteral("Projects//2026/report.pdf/")), QStringLiteral("report"));
+        QVERIFY(resolver.cachedFileId(QStringLiteral("/Projects/2025/report.pdf")).isEmpty());
+
+        QSignalSpy spy(&resolver, &Drive::DrivePathResolver::resolved);
+        resolver.resolve(QStringLiteral("/Projects/2026/report.pdf"));
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(1).toString(), QStringLiteral("/Projects/2026/report.pdf"));
+        QCOMPARE(spy.at(0).at(2).toString(), QStringLiteral("report"));
+
+        // Moving a folder invalidates paths of everything inside it
+        resolver.updateFile(makeFile(QStringLiteral("2026"), QStringLiteral("2026"), QStringLiteral("archive"), true));
+        QVERIFY(resolver.cachedFileId(QStringLiteral("/Projects/2026/report.pdf")).isEmpty());
+        QCOMPARE(resolver.cachedFileId(QStringLiteral("/Archive/2026/report.pdf")), QStringLiteral("report"));
+
+        resolver.removeFile(QStringLiteral("report"));
+        QVERIFY(resolver.cachedFileId(QStringLiteral("/Archive/2026/report.pdf")).isEmpty());
+        QCOMPARE(resolver.cachedFileId(QStringLiteral("/Archive/2026")), QStringLiteral("2026"));
+
+        // Trashed files are not resolvable, even when nothing else changed
+        auto trashed = makeFile(QStringLiteral("2026"), QStringLiteral("2026"), QStringLiteral("archive"), true);
+        trashed->labels()->setTrashed(true);
+        resolver.updateFile(trashed);
+        QVERIFY(resolver.cachedFileId(QStringLiteral("/Archive/2026")).isEmpty());
+
+        resolver.clear();
+        QVERIFY(resolver.cachedFileId(QStringLiteral("/Archive")).isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(DrivePathResolverTest)
+
+#include "drivepathresolvertest.moc"
@@ -18,6 +18,7 @@
  * License along with this library.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <QFileInfo>
 #include <QObject>
 #include <QTest>
 
@@ -28,6 +29,7 @@
 #include "account.h"
 #include "file.h"
 #include "filecreatejob.h"
+#include "filehashindex.h"
 #include "types.h"
 
 using namespace KGAPI2;
@@ -80,11 +82,77 @@ private Q_SLOTS:
             job = new Drive::FileCreateJob(uploadFilePath, sourceFile, account);
         }
 
+        // Progress is reported even when there are no bytes to count
+        QList<QPair<int, int>> progress;
+        connect(job, &Job::progress, this, [&progress](Job *, int processed, int total) {
+            progress.push_back({processed, total});
+        });
+
         QVERIFY(execJob(job));
         const auto items = job->files();
         QCOMPARE(items.count(), 1);
         QVERIFY(*items.cbegin());
         QCOMPARE(**items.cbegin(), *expectedResult);
+        QVERIFY(!progress.isEmpty());
+        QCOMPARE(progress.constLast().first, progress.constLast().second);
+    }
+
+    void testCreateMultiple()
+    {
+        // Both files are uploaded at the same time, the requests are sent in the order of file paths
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/file2_create_request.txt"), QFINDTESTDATA("data/file2_create_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/file1_create_request.txt"), QFINDTESTDATA("data/file1_create_response.txt"))});
+
+        const auto file1 = fileFromFile(QFINDTESTDATA("data/file1.json"));
+        const auto file2 = fileFromFile(QFINDTESTDATA("data/file2.json"));
+        const QString uploadFilePath = QFINDTESTDATA("data/DSC_1287.JPG");
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileCreateJob(QMap<QString, Drive::FilePtr>{{QStringLiteral("?=0"), file1}, {uploadFilePath, file2}}, account);
+        QCOMPARE(job->maxConcurrentRequests(), 4);
+
+        QList<QPair<int, int>> progress;
+        connect(job, &Job::progress, this, [&progress](Job *, int processed, int total) {
+            progress.push_back({processed, total});
+        });
+
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        const auto items = job->files();
+        QCOMPARE(items.count(), 2);
+        QCOMPARE(*items.value(QStringLiteral("?=0")), *file1);
+        QCOMPARE(*items.value(uploadFilePath), *file2);
+        for (const auto &step : std::as_const(progress)) {
+            QVERIFY(step.first <= step.second);
+            QCOMPARE(step.second, static_cast<int>(QFileInfo(uploadFilePath).size()));
+        }
+    }
+
+    void testDeduplicate()
+    {
+        // The file is already in the index, nothing should be sent to the server
+        FakeNetworkAccessManagerFactory::get()->setScenarios({});
+
+        const auto existing = fileFromFile(QFINDTESTDATA("data/file2_existing.json"));
+        Drive::FileHashIndex index;
+        index.addFile(existing);
+        QCOMPARE(index.count(), 1);
+
+        const QString uploadFilePath = QFINDTESTDATA("data/DSC_1287.JPG");
+        QCOMPARE(Drive::FileHashIndex::md5Checksum(uploadFilePath), existing->md5Checksum());
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileCreateJob(uploadFilePath, fileFromFile(QFINDTESTDATA("data/file2.json")), account);
+        job->setDeduplicate(true);
+        job->setHashIndex(index);
+
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->deduplicatedFiles(), QStringList{uploadFilePath});
+        const auto items = job->files();
+        QCOMPARE(items.count(), 1);
+        QCOMPARE(items.value(uploadFilePath)->id(), existing->id());
     }
 };
 
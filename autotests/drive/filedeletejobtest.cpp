@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "filedeletejob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+class FileDeleteJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testDeleteMultiple()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/file1_delete_request.txt"), QFINDTESTDATA("data/generic_no_content_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/file_missing_delete_request.txt"), QFINDTESTDATA("data/file_missing_fetch_response.txt"))});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileDeleteJob(QStringList{QStringLiteral("abcdefghijklmnopqrstuvwxyz"), QStringLiteral("nonexistentfileid")}, account);
+        QSignalSpy processedSpy(job, &Drive::FileDeleteJob::fileProcessed);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        // A missing file does not fail the whole job
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(processedSpy.count(), 2);
+        QCOMPARE(job->failedFilesIds(), QStringList{QStringLiteral("nonexistentfileid")});
+        QCOMPARE(job->fileError(QStringLiteral("nonexistentfileid")), KGAPI2::NotFound);
+        QCOMPARE(job->fileError(QStringLiteral("abcdefghijklmnopqrstuvwxyz")), KGAPI2::NoError);
+    }
+
+    void testDeleteRateLimited()
+    {
+        // A rate limit is not a failure of the file, the request is sent again later
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/file1_delete_request.txt"), QFINDTESTDATA("data/rate_limit_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/file1_delete_request.txt"), QFINDTESTDATA("data/generic_no_content_response.txt"))});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileDeleteJob(QStringList{QStringLiteral("abcdefghijklmnopqrstuvwxyz")}, account);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QVERIFY(job->failedFilesIds().isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(FileDeleteJobTest)
+
+#include "filedeletejobtest.moc"
@@ -0,0 +1,96 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QBuffer>
+#include <QFile>
+#include <QObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "drivetestutils.h"
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "file.h"
+#include "fileexportjob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+static const QByteArray ExportedContent = QByteArrayLiteral("%PDF-1.4\n%Exported spreadsheet\n");
+
+class FileExportJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testSelectMimeType()
+    {
+        const auto file = fileFromFile(QFINDTESTDATA("data/file1.json"));
+        QCOMPARE(Drive::FileExportJob::selectMimeType(file, {QStringLiteral("application/vnd.oasis.opendocument.text"), QStringLiteral("text/csv")}),
+                 QStringLiteral("text/csv"));
+        QVERIFY(Drive::FileExportJob::selectMimeType(file, {QStringLiteral("application/vnd.oasis.opendocument.text")}).isEmpty());
+    }
+
+    void testExportToDevice()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/file1_export_pdf_request.txt"), QFINDTESTDATA("data/file1_export_pdf_response.txt"))});
+        const auto file = fileFromFile(QFINDTESTDATA("data/file1.json"));
+
+        QBuffer buffer;
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileExportJob(file, QStringLiteral("application/pdf"), &buffer, account);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->exportedMimeType(file->id()), QStringLiteral("application/pdf"));
+        QCOMPARE(buffer.data(), ExportedContent);
+    }
+
+    void testExportToDirectory()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/file1_export_pdf_request.txt"), QFINDTESTDATA("data/file1_export_pdf_response.txt"))});
+        const auto file1 = fileFromFile(QFINDTESTDATA("data/file1.json"));
+        const auto file2 = fileFromFile(QFINDTESTDATA("data/file2.json"));
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileExportJob(Drive::FilesList{file1, file2},
+                                            QStringList{QStringLiteral("application/vnd.oasis.opendocument.text"), QStringLiteral("application/pdf")},
+                                            dir.path(),
+                                            account);
+        QSignalSpy exportedSpy(job, &Drive::FileExportJob::fileExported);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        // A file that can't be exported does not fail the whole job
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(exportedSpy.count(), 1);
+        QCOMPARE(job->failedFilesIds(), QStringList{file2->id()});
+        QCOMPARE(job->fileError(file2->id()), KGAPI2::BadRequest);
+
+        QCOMPARE(job->exportedMimeType(file1->id()), QStringLiteral("application/pdf"));
+        const QString path = job->exportedFilePath(file1->id());
+        QCOMPARE(path, dir.filePath(file1->title() + QStringLiteral(".pdf")));
+        QFile exported(path);
+        QVERIFY(exported.open(QIODevice::ReadOnly));
+        QCOMPARE(exported.readAll(), ExportedContent);
+    }
+};
+
+QTEST_GUILESS_MAIN(FileExportJobTest)
+
+#include "fileexportjobtest.moc"
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QBuffer>
+#include <QObject>
+#include <QTest>
+
+#include "drivetestutils.h"
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "file.h"
+#include "filefetchcontentjob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+Q_DECLARE_METATYPE(QList<FakeNetworkAccessManager::Scenario>)
+
+class FileFetchContentJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testFetch()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/content1_fetch_request.txt"), QFINDTESTDATA("data/content1_fetch_response.txt"))});
+
+        const auto file = fileFromFile(QFINDTESTDATA("data/content1.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileFetchContentJob(file, account);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->data(), QByteArray("Hello, Drive!"));
+    }
+
+    void testFetchToDevice_data()
+    {
+        QTest::addColumn<QList<FakeNetworkAccessManager::Scenario>>("scenarios");
+        QTest::addColumn<int>("error");
+
+        QTest::newRow("valid") << QList<FakeNetworkAccessManager::Scenario>{scenarioFromFile(QFINDTESTDATA("data/content1_fetch_request.txt"),
+                                                                                             QFINDTESTDATA("data/content1_fetch_response.txt"))}
+                               << static_cast<int>(KGAPI2::NoError);
+        QTest::newRow("corrupted") << QList<FakeNetworkAccessManager::Scenario>{scenarioFromFile(
+            QFINDTESTDATA("data/content1_fetch_request.txt"),
+            QFINDTESTDATA("data/content1_fetch_corrupted_response.txt"))}
+                                   << static_cast<int>(KGAPI2::InvalidResponse);
+    }
+
+    void testFetchToDevice()
+    {
+        QFETCH(QList<FakeNetworkAccessManager::Scenario>, scenarios);
+        QFETCH(int, error);
+
+        FakeNetworkAccessManagerFactory::get()->setScenarios(scenarios);
+
+        QBuffer buffer;
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+
+        const auto file = fileFromFile(QFINDTESTDATA("data/content1.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileFetchContentJob(file, account);
+        job->setDestination(&buffer);
+        QVERIFY(execJob(job));
+        QCOMPARE(static_cast<int>(job->error()), error);
+        QVERIFY(job->data().isEmpty());
+        QCOMPARE(buffer.data().size(), 13);
+        QCOMPARE(job->md5Checksum() == file->md5Checksum(), error == KGAPI2::NoError);
+    }
+
+    void testResume()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/content1_fetch_resume_request.txt"), QFINDTESTDATA("data/content1_fetch_resume_response.txt"))});
+
+        QBuffer buffer;
+        buffer.setData("Hello, ");
+        QVERIFY(buffer.open(QIODevice::ReadWrite));
+
+        const auto file = fileFromFile(QFINDTESTDATA("data/content1.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileFetchContentJob(file, account);
+        job->setDestination(&buffer);
+        job->setResumeFromDestination(true);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(buffer.data(), QByteArray("Hello, Drive!"));
+        QCOMPARE(job->md5Checksum(), file->md5Checksum());
+    }
+
+    void testSegmented()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/content1_fetch_segment1_request.txt"), QFINDTESTDATA("data/content1_fetch_segment1_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/content1_fetch_segment2_request.txt"), QFINDTESTDATA("data/content1_fetch_segment2_response.txt"))});
+
+        QBuffer buffer;
+        QVERIFY(buffer.open(QIODevice::ReadWrite));
+
+        const auto file = fileFromFile(QFINDTESTDATA("data/content1.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileFetchContentJob(file, account);
+        job->setDestination(&buffer);
+        job->setSegmentCount(2);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(buffer.data(), QByteArray("Hello, Drive!"));
+        QCOMPARE(job->md5Checksum(), file->md5Checksum());
+    }
+};
+
+QTEST_GUILESS_MAIN(FileFetchContentJobTest)
+
+#include "filefetchcontentjobtest.moc"
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QTest>
+
+#include "drivetestutils.h"
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "file.h"
+#include "filefetchjob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+class FileFetchJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testFetchMultiple()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/file2_fetch_request.txt"), QFINDTESTDATA("data/file2_create_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/file_missing_fetch_request.txt"), QFINDTESTDATA("data/file_missing_fetch_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/file1_fetch_request.txt"), QFINDTESTDATA("data/file1_create_response.txt"))});
+        const auto file1 = fileFromFile(QFINDTESTDATA("data/file1.json"));
+        const auto file2 = fileFromFile(QFINDTESTDATA("data/file2.json"));
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileFetchJob({file2->id(), QStringLiteral("nonexistentfileid"), file1->id()}, account);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        // A missing file does not fail the whole job
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(job->notFoundFilesIds(), QStringList{QStringLiteral("nonexistentfileid")});
+
+        // Files are returned in the requested order
+        const auto items = job->items();
+        QCOMPARE(items.count(), 2);
+        QCOMPARE(*items.at(0).dynamicCast<Drive::File>(), *file2);
+        QCOMPARE(*items.at(1).dynamicCast<Drive::File>(), *file1);
+    }
+
+    void testSearchParameters()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/files_search_paged_request.txt"), QFINDTESTDATA("data/mirror_files_response.txt"))});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileFetchJob(account);
+        job->setMaxResults(5000);
+        QCOMPARE(job->maxResults(), 1000);
+        job->setCorpora(Drive::FileFetchJob::AllDrivesCorpora);
+        job->setSpaces(Drive::FileFetchJob::DriveSpace | Drive::FileFetchJob::AppDataFolderSpace);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QCOMPARE(job->items().count(), 2);
+    }
+};
+
+QTEST_GUILESS_MAIN(FileFetchJobTest)
+
+#include "filefetchjobtest.moc"
@@ -0,0 +1,263 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "bandwidthlimiter.h"
+#include "chunksizing_p.h"
+#include "file.h"
+#include "fileresumablecreatejob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+class FileResumableCreateJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testRecoverInterruptedChunk()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios({
+            scenarioFromFile(QFINDTESTDATA("data/resumable_session_request.txt"), QFINDTESTDATA("data/resumable_session_response.txt")),
+            scenarioFromFile(QFINDTESTDATA("data/resumable_chunk1_request.txt"), QFINDTESTDATA("data/resumable_chunk1_response.txt")),
+            scenarioFromFile(QFINDTESTDATA("data/resumable_status_request.txt"), QFINDTESTDATA("data/resumable_status_response.txt")),
+            scenarioFromFile(QFINDTESTDATA("data/resumable_chunk2_request.txt"), QFINDTESTDATA("data/resumable_chunk2_response.txt")),
+        });
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileResumableCreateJob(account);
+        bool written = false;
+        connect(
+            job,
+            &Drive::FileAbstractResumableJob::readyWrite,
+            this,
+            [&written](Drive::FileAbstractResumableJob *job) {
+                job->write(written ? QByteArray() : QByteArray("Hello, Drive!"));
+                written = true;
+            },
+            Qt::DirectConnection);
+        QUrl sessionUrl;
+        connect(job, &Drive::FileAbstractResumableJob::uploadSessionStarted, this, [&sessionUrl](Drive::FileAbstractResumableJob *, const QUrl &url) {
+            sessionUrl = url;
+        });
+
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(sessionUrl, QUrl(QStringLiteral("https://www.googleapis.com/upload/drive/v2/files?uploadType=resumable&upload_id=session1")));
+        QCOMPARE(job->uploadedSize(), qint64(13));
+        QVERIFY(job->metadata());
+        QCOMPARE(job->metadata()->id(), QStringLiteral("uploaded1"));
+    }
+
+    void testPartiallyPersistedChunk()
+    {
+        // The server only persists the first 7 bytes of the chunk, the rest is sent again
+        FakeNetworkAccessManagerFactory::get()->setScenarios({
+            scenarioFromFile(QFINDTESTDATA("data/resumable_session_request.txt"), QFINDTESTDATA("data/resumable_session_response.txt")),
+            scenarioFromFile(QFINDTESTDATA("data/resumable_chunk1_request.txt"), QFINDTESTDATA("data/resumable_status_response.txt")),
+            scenarioFromFile(QFINDTESTDATA("data/resumable_chunk2_request.txt"), QFINDTESTDATA("data/resumable_chunk2_response.txt")),
+        });
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileResumableCreateJob(account);
+        bool written = false;
+        connect(
+            job,
+            &Drive::FileAbstractResumableJob::readyWrite,
+            this,
+            [&written](Drive::FileAbstractResumableJob *job) {
+                job->write(written ? QByteArray() : QByteArray("Hello, Drive!"));
+                written = true;
+            },
+            Qt::DirectConnection);
+
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QCOMPARE(job->uploadedSize(), qint64(13));
+        QVERIFY(job->metadata());
+        QCOMPARE(job->metadata()->id(), QStringLiteral("uploaded1"));
+    }
+
+    void testResumeSession()
+    {
+        // The server has persisted the first 7 bytes in a previous run, the rest is skipped from written data
+        FakeNetworkAccessManagerFactory::get()->setScenarios({
+            scenarioFromFile(QFINDTESTDATA("data/resumable_status_request.txt"), QFINDTESTDATA("data/resumable_status_response.txt")),
+            scenarioFromFile(QFINDTESTDATA("data/resumable_chunk2_request.txt"), QFINDTESTDATA("data/resumable_chunk2_response.txt")),
+        });
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileResumableCreateJob(account);
+        job->setUploadSession(QUrl(QStringLiteral("https://www.googleapis.com/upload/drive/v2/files?uploadType=resumable&upload_id=session1")));
+        job->setUploadSize(13);
+        bool written = false;
+        connect(
+            job,
+            &Drive::FileAbstractResumableJob::readyWrite,
+            this,
+            [&written](Drive::FileAbstractResumableJob *job) {
+                job->write(written ? QByteArray() : QByteArray("Hello, Drive!"));
+                written = true;
+            },
+            Qt::DirectConnection);
+
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QCOMPARE(job->uploadedSize(), qint64(13));
+        QVERIFY(job->metadata());
+        QCOMPARE(job->metadata()->id(), QStringLiteral("uploaded1"));
+    }
+
+    void testResumeSessionFromDevice()
+    {
+        // The server has persisted the first 7 bytes in a previous run, the device is seeked past them
+        FakeNetworkAccessManagerFactory::get()->setScenarios({
+            scenarioFromFile(QFINDTESTDATA("data/resumable_status_request.txt"), QFINDTESTDATA("data/resumable_status_response.txt")),
+            scenarioFromFile(QFINDTESTDATA("data/resumable_chunk2_request.txt"), QFINDTESTDATA("data/resumable_chunk2_response.txt")),
+        });
+
+        QByteArray data("Hello, Drive!");
+        QBuffer device(&data);
+        QVERIFY(device.open(QIODevice::ReadOnly));
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileResumableCreateJob(&device, account);
+        job->setUploadSession(QUrl(QStringLiteral("https://www.googleapis.com/upload/drive/v2/files?uploadType=resumable&upload_id=session1")));
+        job->setUploadSize(data.size());
+
+        QVERIFY(execJob(job));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QCOMPARE(job->uploadedSize(), qint64(13));
+        QCOMPARE(device.pos(), qint64(13));
+        QVERIFY(job->metadata());
+        QCOMPARE(job->metadata()->id(), QStringLiteral("uploaded1"));
+    }
+
+    void testThrottledUpload()
+    {
+        constexpr qint64 Rate = 128 * 1024;
+        const QByteArray data(3 * Rate / 2, 'a');
+
+        FakeNetworkAccessManagerFactory::get()->setScenarios({
+            scenarioFromFile(QFINDTESTDATA("data/resumable_session_request.txt"), QFINDTESTDATA("data/resumable_session_response.txt")),
+            FakeNetworkAccessManager::Scenario(
+                QUrl(QStringLiteral("https://www.googleapis.com/upload/drive/v2/files?uploadType=resumable&upload_id=session1&prettyPrint=false")),
+                QNetworkAccessManager::PutOperation,
+                data,
+                KGAPI2::OK,
+                R"({"kind": "drive#file", "id": "uploaded1", "title": "hello.txt", "mimeType": "text/plain"})"),
+        });
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto limiter = Drive::BandwidthLimiter::instance();
+        limiter->setAccountRate(account->accountName(), Drive::BandwidthLimiter::Upload, Rate);
+
+        auto job = new Drive::FileResumableCreateJob(account);
+        bool written = false;
+        connect(
+            job,
+            &Drive::FileAbstractResumableJob::readyWrite,
+            this,
+            [&](Drive::FileAbstractResumableJob *job) {
+                job->write(written ? QByteArray() : data);
+                written = true;
+            },
+            Qt::DirectConnection);
+
+        QElapsedTimer timer;
+        timer.start();
+        QVERIFY(execJob(job));
+        const qint64 elapsed = timer.elapsed();
+        limiter->setAccountRate(account->accountName(), Drive::BandwidthLimiter::Upload, 0);
+
+        // One second worth of data is sent at once, the rest has to wait for the limit
+        QVERIFY2(elapsed >= 450, qPrintable(QStringLiteral("Upload took only %1 ms").arg(elapsed)));
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QCOMPARE(job->uploadedSize(), qint64(data.size()));
+        QVERIFY(job->metadata());
+        QCOMPARE(job->metadata()->id(), QStringLiteral("uploaded1"));
+    }
+
+    void testChunkSize()
+    {
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        Drive::FileResumableCreateJob job(account);
+        QCOMPARE(job.chunkSize(), qint64(256 * 1024));
+
+        job.setChunkSize(300 * 1024);
+        QCOMPARE(job.chunkSize(), qint64(512 * 1024));
+        job.setChunkSize(0);
+        QCOMPARE(job.chunkSize(), qint64(256 * 1024));
+
+        job.setMaximumChunkSize(8 * 1024 * 1024);
+        QCOMPARE(job.maximumChunkSize(), qint64(8 * 1024 * 1024));
+
+        // Chunks are buffered in memory, so their size is limited
+        job.setChunkSize(Q_INT64_C(5) * 1024 * 1024 * 1024);
+        QCOMPARE(job.chunkSize(), qint64(64 * 1024 * 1024));
+        job.setMaximumChunkSize(Q_INT64_C(5) * 1024 * 1024 * 1024);
+        QCOMPARE(job.maximumChunkSize(), qint64(64 * 1024 * 1024));
+
+        job.setUploadSize(Q_INT64_C(10) * 1024 * 1024 * 1024);
+        QCOMPARE(job.uploadSize(), Q_INT64_C(10) * 1024 * 1024 * 1024);
+    }
+
+    void testAdaptiveChunkSize_data()
+    {
+        QTest::addColumn<qint64>("chunkSize");
+        QTest::addColumn<qint64>("maximumChunkSize");
+        QTest::addColumn<qint64>("bytes");
+        QTest::addColumn<qint64>("elapsed");
+        QTest::addColumn<qint64>("roundTripTime");
+        QTest::addColumn<qint64>("expected");
+
+        constexpr qint64 KiB = 1024;
+        constexpr qint64 MiB = 1024 * KiB;
+
+        // 256 KiB in 10 ms would allow 25 MiB chunks, but growth is limited per chunk
+        QTest::newRow("growth limited") << 256 * KiB << 64 * MiB << 256 * KiB << qint64(10) << qint64(0) << 1 * MiB;
+        QTest::newRow("maximum") << 1 * MiB << 2 * MiB << 1 * MiB << qint64(10) << qint64(0) << 2 * MiB;
+        // 256 KiB/s fills a chunk of 256 KiB in the minimum duration of 1 s
+        QTest::newRow("shrink") << 1 * MiB << 64 * MiB << 1 * MiB << qint64(4000) << qint64(0) << 256 * KiB;
+        QTest::newRow("minimum") << 1 * MiB << 64 * MiB << 1 * MiB << qint64(60000) << qint64(0) << 256 * KiB;
+        // 256 KiB/s for 10 round-trips of 500 ms
+        QTest::newRow("round-trip") << 512 * KiB << 64 * MiB << 512 * KiB << qint64(2000) << qint64(500) << 1280 * KiB;
+        QTest::newRow("partial chunk") << 1 * MiB << 64 * MiB << 512 * KiB << qint64(10) << qint64(0) << 1 * MiB;
+        QTest::newRow("no time elapsed") << 256 * KiB << 64 * MiB << 256 * KiB << qint64(0) << qint64(0) << 256 * KiB;
+    }
+
+    void testAdaptiveChunkSize()
+    {
+        QFETCH(qint64, chunkSize);
+        QFETCH(qint64, maximumChunkSize);
+        QFETCH(qint64, bytes);
+        QFETCH(qint64, elapsed);
+        QFETCH(qint64, roundTripTime);
+        QFETCH(qint64, expected);
+
+        QCOMPARE(Drive::ChunkSizing::adapt(chunkSize, maximumChunkSize, bytes, elapsed, roundTripTime), expected);
+    }
+};
+
+QTEST_GUILESS_MAIN(FileResumableCreateJobTest)
+
+#include "fileresumablecreatejobtest.moc"
@@ -71,6 +71,30 @@ private Q_SLOTS:
         const QString serialized = query.serialize();
         QCOMPARE(serialized, expected);
     }
+
+    void testSplit()
+    {
+        FileSearchQuery parents(FileSearchQuery::Or);
+        parents.addQuery(FileSearchQuery::Parents, FileSearchQuery::In, QLatin1StringView("a"));
+        parents.addQuery(FileSearchQuery::Parents, FileSearchQuery::In, QLatin1StringView("b"));
+        parents.addQuery(FileSearchQuery::Parents, FileSearchQuery::In, QLatin1StringView("c"));
+        FileSearchQuery query;
+        query.addQuery(FileSearchQuery::Trashed, FileSearchQuery::Equals, false);
+        query.addQuery(parents);
+
+        // Short enough, nothing to split
+        QCOMPARE(query.split(100).size(), 1);
+
+        // The disjunction is split, the rest of the conjunction is repeated
+        const auto queries = query.split(70);
+        QCOMPARE(queries.size(), 2);
+        QCOMPARE(queries.at(0).serialize(), QStringLiteral("((trashed = false) and (('a' in parents) or ('b' in parents)))"));
+        QCOMPARE(queries.at(1).serialize(), QStringLiteral("((trashed = false) and (('c' in parents)))"));
+
+        const auto parentQueries = parents.split(20);
+        QCOMPARE(parentQueries.size(), 3);
+        QCOMPARE(parentQueries.at(2).serialize(), QStringLiteral("(('c' in parents))"));
+    }
 };
 
 QTEST_GUILESS_MAIN(FileSearchQueryTest)
@@ -0,0 +1,75 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "drivetestutils.h"
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "file.h"
+#include "filetrashjob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+class FileTrashJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testTrashMultiple()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/file_missing_trash_request.txt"), QFINDTESTDATA("data/file_missing_fetch_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/file1_trash_request.txt"), QFINDTESTDATA("data/file1_create_response.txt"))});
+        const auto file1 = fileFromFile(QFINDTESTDATA("data/file1.json"));
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileTrashJob(QStringList{QStringLiteral("nonexistentfileid"), file1->id()}, account);
+        QSignalSpy processedSpy(job, &Drive::FileTrashJob::fileProcessed);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        // A missing file does not fail the whole job
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(processedSpy.count(), 2);
+        QCOMPARE(processedSpy.at(0).at(1).toString(), QStringLiteral("nonexistentfileid"));
+        QCOMPARE(processedSpy.at(1).at(1).toString(), file1->id());
+
+        QCOMPARE(job->failedFilesIds(), QStringList{QStringLiteral("nonexistentfileid")});
+        QCOMPARE(job->fileError(QStringLiteral("nonexistentfileid")), KGAPI2::NotFound);
+        QCOMPARE(job->fileErrorString(QStringLiteral("nonexistentfileid")), QStringLiteral("File not found: nonexistentfileid"));
+        QCOMPARE(job->fileError(file1->id()), KGAPI2::NoError);
+
+        const auto items = job->items();
+        QCOMPARE(items.count(), 1);
+        QCOMPARE(*items.at(0).dynamicCast<Drive::File>(), *file1);
+    }
+
+    void testTrashSingleFails()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/file_missing_trash_request.txt"), QFINDTESTDATA("data/file_missing_fetch_response.txt"))});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FileTrashJob(QStringLiteral("nonexistentfileid"), account);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QCOMPARE(job->error(), KGAPI2::NotFound);
+    }
+};
+
+QTEST_GUILESS_MAIN(FileTrashJobTest)
+
+#include "filetrashjobtest.moc"
@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QFile>
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "foldercopyjob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+class FolderCopyJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testCopy()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/foldercopy_root_request.txt"), QFINDTESTDATA("data/foldertree_root_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldercopy_subfolder_request.txt"), QFINDTESTDATA("data/foldertree_subfolder_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldercopy_folder_request.txt"), QFINDTESTDATA("data/foldercopy_folder_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldercopy_notes_request.txt"), QFINDTESTDATA("data/foldercopy_notes_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldercopy_photo_request.txt"), QFINDTESTDATA("data/foldercopy_photo_response.txt"))});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FolderCopyJob(QStringLiteral("treeroot"), QStringLiteral("copydest"), account);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        QCOMPARE(job->items().count(), 3);
+        QCOMPARE(job->copiedFileId(QStringLiteral("treesubfolder")), QStringLiteral("copyphotos"));
+        QCOMPARE(job->copiedFileId(QStringLiteral("treenotes")), QStringLiteral("copynotes"));
+        QCOMPARE(job->copiedFileId(QStringLiteral("treephoto")), QStringLiteral("copyphoto"));
+        QVERIFY(job->copiedFileId(QStringLiteral("treetrashed")).isEmpty());
+    }
+
+    void testCopyRootAlias()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/foldercopy_rootalias_request.txt"), QFINDTESTDATA("data/foldertree_rootalias_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldercopy_subfolder_request.txt"), QFINDTESTDATA("data/foldertree_subfolder_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldercopy_folder_request.txt"), QFINDTESTDATA("data/foldercopy_folder_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldercopy_notes_request.txt"), QFINDTESTDATA("data/foldercopy_notes_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldercopy_photo_request.txt"), QFINDTESTDATA("data/foldercopy_photo_response.txt"))});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FolderCopyJob(QStringLiteral("root"), QStringLiteral("copydest"), account);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        QCOMPARE(job->items().count(), 3);
+        QCOMPARE(job->copiedFileId(QStringLiteral("treenotes")), QStringLiteral("copynotes"));
+        QCOMPARE(job->copiedFileId(QStringLiteral("treephoto")), QStringLiteral("copyphoto"));
+    }
+
+    void testResume()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString journalPath = dir.filePath(QStringLiteral("journal.jsonl"));
+        {
+            QFile journal(journalPath);
+            QVERIFY(journal.open(QIODevice::WriteOnly));
+            // The last entry was cut short and is ignored
+            journal.write(R"({"sourceFolderId": "treeroot", "destinationFolderId": "copydest"}
+{"source": "treesubfolder", "copy": "copyphotos"}
+{"source": "treenotes", "copy": "copynotes"}
+{"source": "treephoto", "co)");
+        }
+
+        // Only the file that was not copied yet is copied
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/foldercopy_root_request.txt"), QFINDTESTDATA("data/foldertree_root_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldercopy_subfolder_request.txt"), QFINDTESTDATA("data/foldertree_subfolder_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldercopy_photo_request.txt"), QFINDTESTDATA("data/foldercopy_photo_response.txt"))});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FolderCopyJob(QStringLiteral("treeroot"), QStringLiteral("copydest"), account);
+        job->setJournalPath(journalPath);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        QCOMPARE(job->items().count(), 1);
+        QCOMPARE(job->copiedFileId(QStringLiteral("treenotes")), QStringLiteral("copynotes"));
+        QCOMPARE(job->copiedFileId(QStringLiteral("treephoto")), QStringLiteral("copyphoto"));
+        // The journal is removed once the copy is complete
+        QVERIFY(!QFile::exists(journalPath));
+    }
+};
+
+QTEST_GUILESS_MAIN(FolderCopyJobTest)
+
+#include "foldercopyjobtest.moc"
@@ -0,0 +1,410 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "foldersync.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+namespace
+{
+void writeFile(const QString &filePath, const QByteArray &data)
+{
+    QVERIFY(QDir().mkpath(QFileInfo(filePath).path()));
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write(data), data.size());
+}
+
+void setModificationTime(const QString &filePath, const QDateTime &time)
+{
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.setFileTime(time, QFileDevice::FileModificationTime));
+}
+
+// Synchronizes the tree of foldersync_tree_response.txt into @p localPath,
+// where hello.txt already exists, so that nothing is transferred
+void synchronizeTree(const AccountPtr &account, const QString &localPath, const QString &statePath)
+{
+    writeFile(QDir(localPath).filePath(QStringLiteral("hello.txt")), "Hello, Drive!");
+    FakeNetworkAccessManagerFactory::get()->setScenarios(
+        {scenarioFromFile(QFINDTESTDATA("data/about_fetch_request.txt"), QFINDTESTDATA("data/about_fetch_response.txt")),
+         scenarioFromFile(QFINDTESTDATA("data/foldertree_root_request.txt"), QFINDTESTDATA("data/foldersync_tree_response.txt")),
+         scenarioFromFile(QFINDTESTDATA("data/foldertree_subfolder_request.txt"), QFINDTESTDATA("data/foldersync_subfolder_response.txt"))});
+
+    Drive::FolderSync sync(account, localPath, QStringLiteral("treeroot"), statePath);
+    QSignalSpy syncSpy(&sync, &Drive::FolderSync::synchronized);
+    QSignalSpy fileSpy(&sync, &Drive::FolderSync::fileSynchronized);
+    sync.synchronize();
+    QVERIFY(syncSpy.wait());
+    QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+    QCOMPARE(fileSpy.count(), 0);
+    QVERIFY(sync.failedPaths().isEmpty());
+}
+}
+
+class FolderSyncTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testSynchronize()
+    {
+        QTemporaryDir stateDir;
+        QTemporaryDir localDir;
+        QVERIFY(stateDir.isValid());
+        QVERIFY(localDir.isValid());
+        const QString statePath = stateDir.filePath(QStringLiteral("sync.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+
+        {
+            FakeNetworkAccessManagerFactory::get()->setScenarios(
+                {scenarioFromFile(QFINDTESTDATA("data/about_fetch_request.txt"), QFINDTESTDATA("data/about_fetch_response.txt")),
+                 scenarioFromFile(QFINDTESTDATA("data/foldertree_root_request.txt"), QFINDTESTDATA("data/foldersync_tree_response.txt")),
+                 scenarioFromFile(QFINDTESTDATA("data/foldertree_subfolder_request.txt"), QFINDTESTDATA("data/foldersync_subfolder_response.txt")),
+                 scenarioFromFile(QFINDTESTDATA("data/content1_fetch_request.txt"), QFINDTESTDATA("data/content1_fetch_response.txt"))});
+
+            Drive::FolderSync sync(account, localDir.path(), QStringLiteral("treeroot"), statePath);
+            QSignalSpy syncSpy(&sync, &Drive::FolderSync::synchronized);
+            QSignalSpy fileSpy(&sync, &Drive::FolderSync::fileSynchronized);
+            sync.synchronize();
+            QVERIFY(sync.isSynchronizing());
+            QVERIFY(syncSpy.wait());
+            QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+            QVERIFY(sync.failedPaths().isEmpty());
+
+            // The Google Doc has no content and is skipped
+            QCOMPARE(fileSpy.count(), 1);
+            QCOMPARE(fileSpy.at(0).at(1).toString(), QStringLiteral("hello.txt"));
+            QCOMPARE(fileSpy.at(0).at(2).value<Drive::FolderSync::Action>(), Drive::FolderSync::Downloaded);
+            QVERIFY(QDir(localDir.filePath(QStringLiteral("Photos"))).exists());
+
+            QFile downloaded(localDir.filePath(QStringLiteral("hello.txt")));
+            QVERIFY(downloaded.open(QIODevice::ReadOnly));
+            QCOMPARE(downloaded.readAll(), QByteArrayLiteral("Hello, Drive!"));
+        }
+
+        // The state is persisted, so only the changes are fetched and the
+        // unmodified local file is neither hashed nor transferred again. Content
+        // changed behind the back of the synchronization with the size and the
+        // modification time kept is therefore not noticed.
+        const QString filePath = localDir.filePath(QStringLiteral("hello.txt"));
+        const QDateTime modified = QFileInfo(filePath).lastModified();
+        writeFile(filePath, "Jello, Drive!");
+        setModificationTime(filePath, modified);
+
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/mirror_changes_request.txt"), QFINDTESTDATA("data/foldersync_changes_response.txt"))});
+
+        Drive::FolderSync sync(account, localDir.path(), QStringLiteral("treeroot"), statePath);
+        QSignalSpy syncSpy(&sync, &Drive::FolderSync::synchronized);
+        QSignalSpy fileSpy(&sync, &Drive::FolderSync::fileSynchronized);
+        sync.synchronize();
+        QVERIFY(syncSpy.wait());
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QCOMPARE(fileSpy.count(), 0);
+        QVERIFY(sync.failedPaths().isEmpty());
+        QFile unchanged(filePath);
+        QVERIFY(unchanged.open(QIODevice::ReadOnly));
+        QCOMPARE(unchanged.readAll(), QByteArrayLiteral("Jello, Drive!"));
+    }
+
+    void testLocalModification()
+    {
+        QTemporaryDir stateDir;
+        QTemporaryDir localDir;
+        QVERIFY(stateDir.isValid());
+        QVERIFY(localDir.isValid());
+        const QString statePath = stateDir.filePath(QStringLiteral("sync.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        synchronizeTree(account, localDir.path(), statePath);
+
+        // The modified file replaces the content of the remote one
+        const QString filePath = localDir.filePath(QStringLiteral("hello.txt"));
+        const QDateTime modified = QFileInfo(filePath).lastModified().addSecs(60);
+        writeFile(filePath, "Hello, World!");
+        setModificationTime(filePath, modified);
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/mirror_changes_request.txt"), QFINDTESTDATA("data/foldersync_changes_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldersync_modify_session_request.txt"), QFINDTESTDATA("data/foldersync_session_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldersync_modify_chunk_request.txt"), QFINDTESTDATA("data/foldersync_modify_chunk_response.txt"))});
+
+        Drive::FolderSync sync(account, localDir.path(), QStringLiteral("treeroot"), statePath);
+        QSignalSpy syncSpy(&sync, &Drive::FolderSync::synchronized);
+        QSignalSpy fileSpy(&sync, &Drive::FolderSync::fileSynchronized);
+        sync.synchronize();
+        QVERIFY(syncSpy.wait());
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QVERIFY(sync.failedPaths().isEmpty());
+        QCOMPARE(fileSpy.count(), 1);
+        QCOMPARE(fileSpy.at(0).at(1).toString(), QStringLiteral("hello.txt"));
+        QCOMPARE(fileSpy.at(0).at(2).value<Drive::FolderSync::Action>(), Drive::FolderSync::Uploaded);
+    }
+
+    void testRemoteRemoval()
+    {
+        QTemporaryDir stateDir;
+        QTemporaryDir localDir;
+        QVERIFY(stateDir.isValid());
+        QVERIFY(localDir.isValid());
+        const QString statePath = stateDir.filePath(QStringLiteral("sync.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        synchronizeTree(account, localDir.path(), statePath);
+
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/mirror_changes_request.txt"), QFINDTESTDATA("data/foldersync_deleted_response.txt"))});
+
+        Drive::FolderSync sync(account, localDir.path(), QStringLiteral("treeroot"), statePath);
+        QSignalSpy syncSpy(&sync, &Drive::FolderSync::synchronized);
+        QSignalSpy fileSpy(&sync, &Drive::FolderSync::fileSynchronized);
+        sync.synchronize();
+        QVERIFY(syncSpy.wait());
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QVERIFY(sync.failedPaths().isEmpty());
+        QCOMPARE(fileSpy.count(), 1);
+        QCOMPARE(fileSpy.at(0).at(1).toString(), QStringLiteral("hello.txt"));
+        QCOMPARE(fileSpy.at(0).at(2).value<Drive::FolderSync::Action>(), Drive::FolderSync::RemovedLocally);
+        QVERIFY(!QFile::exists(localDir.filePath(QStringLiteral("hello.txt"))));
+    }
+
+    void testLocalRemoval()
+    {
+        QTemporaryDir stateDir;
+        QTemporaryDir localDir;
+        QVERIFY(stateDir.isValid());
+        QVERIFY(localDir.isValid());
+        const QString statePath = stateDir.filePath(QStringLiteral("sync.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        synchronizeTree(account, localDir.path(), statePath);
+
+        // The remote file is moved to the trash rather than deleted
+        QVERIFY(QFile::remove(localDir.filePath(QStringLiteral("hello.txt"))));
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/mirror_changes_request.txt"), QFINDTESTDATA("data/foldersync_changes_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldersync_trash_request.txt"), QFINDTESTDATA("data/foldersync_trash_response.txt"))});
+
+        Drive::FolderSync sync(account, localDir.path(), QStringLiteral("treeroot"), statePath);
+        QSignalSpy syncSpy(&sync, &Drive::FolderSync::synchronized);
+        QSignalSpy fileSpy(&sync, &Drive::FolderSync::fileSynchronized);
+        sync.synchronize();
+        QVERIFY(syncSpy.wait());
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QVERIFY(sync.failedPaths().isEmpty());
+        QCOMPARE(fileSpy.count(), 1);
+        QCOMPARE(fileSpy.at(0).at(1).toString(), QStringLiteral("hello.txt"));
+        QCOMPARE(fileSpy.at(0).at(2).value<Drive::FolderSync::Action>(), Drive::FolderSync::RemovedRemotely);
+    }
+
+    void testModificationWinsOverRemoteRemoval()
+    {
+        QTemporaryDir stateDir;
+        QTemporaryDir localDir;
+        QVERIFY(stateDir.isValid());
+        QVERIFY(localDir.isValid());
+        const QString statePath = stateDir.filePath(QStringLiteral("sync.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        synchronizeTree(account, localDir.path(), statePath);
+
+        // The file removed from Drive but modified locally is uploaded anew
+        writeFile(localDir.filePath(QStringLiteral("hello.txt")), "Local edit!");
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/mirror_changes_request.txt"), QFINDTESTDATA("data/foldersync_deleted_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldersync_create_session_request.txt"), QFINDTESTDATA("data/foldersync_session_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldersync_create_chunk_request.txt"), QFINDTESTDATA("data/foldersync_create_chunk_response.txt"))});
+
+        Drive::FolderSync sync(account, localDir.path(), QStringLiteral("treeroot"), statePath);
+        QSignalSpy syncSpy(&sync, &Drive::FolderSync::synchronized);
+        QSignalSpy fileSpy(&sync, &Drive::FolderSync::fileSynchronized);
+        sync.synchronize();
+        QVERIFY(syncSpy.wait());
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QVERIFY(sync.failedPaths().isEmpty());
+        QCOMPARE(fileSpy.count(), 1);
+        QCOMPARE(fileSpy.at(0).at(1).toString(), QStringLiteral("hello.txt"));
+        QCOMPARE(fileSpy.at(0).at(2).value<Drive::FolderSync::Action>(), Drive::FolderSync::Uploaded);
+        QVERIFY(QFile::exists(localDir.filePath(QStringLiteral("hello.txt"))));
+    }
+
+    void testModificationWinsOverLocalRemoval()
+    {
+        QTemporaryDir stateDir;
+        QTemporaryDir localDir;
+        QVERIFY(stateDir.isValid());
+        QVERIFY(localDir.isValid());
+        const QString statePath = stateDir.filePath(QStringLiteral("sync.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        synchronizeTree(account, localDir.path(), statePath);
+
+        // The file removed locally but modified in Drive is downloaded again
+        QVERIFY(QFile::remove(localDir.filePath(QStringLiteral("hello.txt"))));
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/mirror_changes_request.txt"), QFINDTESTDATA("data/foldersync_modified_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/content1_fetch_request.txt"), QFINDTESTDATA("data/foldersync_modified_content_response.txt"))});
+
+        Drive::FolderSync sync(account, localDir.path(), QStringLiteral("treeroot"), statePath);
+        QSignalSpy syncSpy(&sync, &Drive::FolderSync::synchronized);
+        QSignalSpy fileSpy(&sync, &Drive::FolderSync::fileSynchronized);
+        sync.synchronize();
+        QVERIFY(syncSpy.wait());
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QVERIFY(sync.failedPaths().isEmpty());
+        QCOMPARE(fileSpy.count(), 1);
+        QCOMPARE(fileSpy.at(0).at(1).toString(), QStringLiteral("hello.txt"));
+        QCOMPARE(fileSpy.at(0).at(2).value<Drive::FolderSync::Action>(), Drive::FolderSync::Downloaded);
+
+        QFile downloaded(localDir.filePath(QStringLiteral("hello.txt")));
+        QVERIFY(downloaded.open(QIODevice::ReadOnly));
+        QCOMPARE(downloaded.readAll(), QByteArrayLiteral("Hello again!"));
+    }
+
+    void testConflict()
+    {
+        QTemporaryDir stateDir;
+        QTemporaryDir localDir;
+        QVERIFY(stateDir.isValid());
+        QVERIFY(localDir.isValid());
+        const QString statePath = stateDir.filePath(QStringLiteral("sync.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        synchronizeTree(account, localDir.path(), statePath);
+
+        // Modified on both sides, the local version is kept as a conflicted
+        // copy next to the remote one
+        writeFile(localDir.filePath(QStringLiteral("hello.txt")), "Local edit!");
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/mirror_changes_request.txt"), QFINDTESTDATA("data/foldersync_modified_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/content1_fetch_request.txt"), QFINDTESTDATA("data/foldersync_modified_content_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldersync_conflict_session_request.txt"), QFINDTESTDATA("data/foldersync_session_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldersync_create_chunk_request.txt"), QFINDTESTDATA("data/foldersync_conflict_chunk_response.txt"))});
+
+        Drive::FolderSync sync(account, localDir.path(), QStringLiteral("treeroot"), statePath);
+        QSignalSpy syncSpy(&sync, &Drive::FolderSync::synchronized);
+        QSignalSpy fileSpy(&sync, &Drive::FolderSync::fileSynchronized);
+        QSignalSpy conflictSpy(&sync, &Drive::FolderSync::conflictDetected);
+        sync.synchronize();
+        QVERIFY(syncSpy.wait());
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QVERIFY(sync.failedPaths().isEmpty());
+
+        const QString conflictPath = QStringLiteral("hello (conflicted copy).txt");
+        QCOMPARE(conflictSpy.count(), 1);
+        QCOMPARE(conflictSpy.at(0).at(1).toString(), QStringLiteral("hello.txt"));
+        QCOMPARE(conflictSpy.at(0).at(2).toString(), conflictPath);
+
+        QHash<QString, Drive::FolderSync::Action> actions;
+        for (const auto &arguments : std::as_const(fileSpy)) {
+            actions.insert(arguments.at(1).toString(), arguments.at(2).value<Drive::FolderSync::Action>());
+        }
+        QCOMPARE(actions.size(), 2);
+        QCOMPARE(actions.value(QStringLiteral("hello.txt")), Drive::FolderSync::Downloaded);
+        QCOMPARE(actions.value(conflictPath), Drive::FolderSync::Uploaded);
+
+        QFile downloaded(localDir.filePath(QStringLiteral("hello.txt")));
+        QVERIFY(downloaded.open(QIODevice::ReadOnly));
+        QCOMPARE(downloaded.readAll(), QByteArrayLiteral("Hello again!"));
+        QFile conflicted(localDir.filePath(conflictPath));
+        QVERIFY(conflicted.open(QIODevice::ReadOnly));
+        QCOMPARE(conflicted.readAll(), QByteArrayLiteral("Local edit!"));
+    }
+
+    void testFolderMovedOut()
+    {
+        QTemporaryDir stateDir;
+        QTemporaryDir localDir;
+        QVERIFY(stateDir.isValid());
+        QVERIFY(localDir.isValid());
+        const QString statePath = stateDir.filePath(QStringLiteral("sync.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+
+        // Both sides are already the same, nothing is transferred
+        writeFile(localDir.filePath(QStringLiteral("hello.txt")), "Hello, Drive!");
+        writeFile(localDir.filePath(QStringLiteral("Photos/beach.jpg")), "Sand and sea");
+        {
+            FakeNetworkAccessManagerFactory::get()->setScenarios(
+                {scenarioFromFile(QFINDTESTDATA("data/about_fetch_request.txt"), QFINDTESTDATA("data/about_fetch_response.txt")),
+                 scenarioFromFile(QFINDTESTDATA("data/foldertree_root_request.txt"), QFINDTESTDATA("data/foldersync_tree_response.txt")),
+                 scenarioFromFile(QFINDTESTDATA("data/foldertree_subfolder_request.txt"), QFINDTESTDATA("data/foldersync_photos_response.txt"))});
+
+            Drive::FolderSync sync(account, localDir.path(), QStringLiteral("treeroot"), statePath);
+            QSignalSpy syncSpy(&sync, &Drive::FolderSync::synchronized);
+            QSignalSpy fileSpy(&sync, &Drive::FolderSync::fileSynchronized);
+            sync.synchronize();
+            QVERIFY(syncSpy.wait());
+            QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+            QCOMPARE(fileSpy.count(), 0);
+            QVERIFY(sync.failedPaths().isEmpty());
+        }
+
+        // The changes only list the folder that was moved out of the tree,
+        // its content is gone from the tree as well. The local folder itself
+        // is kept and therefore created anew.
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/mirror_changes_request.txt"), QFINDTESTDATA("data/foldersync_movedout_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldersync_folder_create_request.txt"), QFINDTESTDATA("data/foldersync_folder_create_response.txt"))});
+
+        Drive::FolderSync sync(account, localDir.path(), QStringLiteral("treeroot"), statePath);
+        QSignalSpy syncSpy(&sync, &Drive::FolderSync::synchronized);
+        QSignalSpy fileSpy(&sync, &Drive::FolderSync::fileSynchronized);
+        sync.synchronize();
+        QVERIFY(syncSpy.wait());
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QVERIFY(sync.failedPaths().isEmpty());
+        QCOMPARE(fileSpy.count(), 1);
+        QCOMPARE(fileSpy.at(0).at(1).toString(), QStringLiteral("Photos/beach.jpg"));
+        QCOMPARE(fileSpy.at(0).at(2).value<Drive::FolderSync::Action>(), Drive::FolderSync::RemovedLocally);
+        QVERIFY(!QFile::exists(localDir.filePath(QStringLiteral("Photos/beach.jpg"))));
+        QVERIFY(QFile::exists(localDir.filePath(QStringLiteral("hello.txt"))));
+    }
+
+    void testCreateFolders()
+    {
+        QTemporaryDir stateDir;
+        QTemporaryDir localDir;
+        QVERIFY(stateDir.isValid());
+        QVERIFY(localDir.isValid());
+        QVERIFY(QDir(localDir.path()).mkpath(QStringLiteral("Docs/Archive")));
+        QVERIFY(QDir(localDir.path()).mkpath(QStringLiteral("Music")));
+
+        // Folders are created as soon as their parent exists, Music does not
+        // wait for the subfolder of Docs
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/about_fetch_request.txt"), QFINDTESTDATA("data/about_fetch_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldertree_root_request.txt"), QFINDTESTDATA("data/foldersync_subfolder_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldersync_docs_create_request.txt"), QFINDTESTDATA("data/foldersync_docs_create_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldersync_music_create_request.txt"), QFINDTESTDATA("data/foldersync_music_create_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldersync_archive_create_request.txt"), QFINDTESTDATA("data/foldersync_archive_create_response.txt"))});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        Drive::FolderSync sync(account, localDir.path(), QStringLiteral("treeroot"), stateDir.filePath(QStringLiteral("sync.json")));
+        QSignalSpy syncSpy(&sync, &Drive::FolderSync::synchronized);
+        sync.synchronize();
+        QVERIFY(syncSpy.wait());
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QVERIFY(sync.failedPaths().isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(FolderSyncTest)
+
+#include "foldersynctest.moc"
@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "file.h"
+#include "foldertreefetchjob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+class FolderTreeFetchJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testFetchTree()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/foldertree_root_request.txt"), QFINDTESTDATA("data/foldertree_root_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldertree_subfolder_request.txt"), QFINDTESTDATA("data/foldertree_subfolder_response.txt"))});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FolderTreeFetchJob(QStringLiteral("treeroot"), account);
+        QSignalSpy fetchedSpy(job, &Drive::FolderTreeFetchJob::filesFetched);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        // The trashed file is skipped
+        QCOMPARE(job->items().count(), 3);
+        QCOMPARE(fetchedSpy.count(), 2);
+        QCOMPARE(job->relativePath(QStringLiteral("treesubfolder")), QStringLiteral("Photos"));
+        QCOMPARE(job->relativePath(QStringLiteral("treenotes")), QStringLiteral("notes.txt"));
+        QCOMPARE(job->relativePath(QStringLiteral("treephoto")), QStringLiteral("Photos/beach.jpg"));
+        QVERIFY(job->relativePath(QStringLiteral("treetrashed")).isEmpty());
+    }
+
+    void testFetchRootAlias()
+    {
+        // Files in the root folder refer to it by its real ID
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/foldertree_rootalias_request.txt"), QFINDTESTDATA("data/foldertree_rootalias_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/foldertree_subfolder_request.txt"), QFINDTESTDATA("data/foldertree_subfolder_response.txt"))});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FolderTreeFetchJob(QStringLiteral("root"), account);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        QCOMPARE(job->items().count(), 3);
+        QCOMPARE(job->relativePath(QStringLiteral("treenotes")), QStringLiteral("notes.txt"));
+        QCOMPARE(job->relativePath(QStringLiteral("treephoto")), QStringLiteral("Photos/beach.jpg"));
+    }
+
+    void testMaxDepth()
+    {
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/foldertree_root_request.txt"), QFINDTESTDATA("data/foldertree_root_response.txt"))});
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::FolderTreeFetchJob(QStringLiteral("treeroot"), account);
+        job->setMaxDepth(1);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        // Subfolders are reported, but not listed
+        QCOMPARE(job->items().count(), 2);
+        QVERIFY(job->relativePath(QStringLiteral("treephoto")).isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(FolderTreeFetchJobTest)
+
+#include "foldertreefetchjobtest.moc"
@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "permission.h"
+#include "permissionbulkjob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+class PermissionBulkJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testBulkChange()
+    {
+        // Permissions are only added once the removals are done
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/permission_bulk_remove1_request.txt"), QFINDTESTDATA("data/generic_no_content_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/permission_bulk_remove2_request.txt"), QFINDTESTDATA("data/permission_bulk_remove2_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/permission_bulk_create1_request.txt"), QFINDTESTDATA("data/permission_bulk_create1_response.txt")),
+             scenarioFromFile(QFINDTESTDATA("data/permission_bulk_create2_request.txt"), QFINDTESTDATA("data/permission_bulk_create2_response.txt"))});
+
+        auto permission = Drive::PermissionPtr::create();
+        permission->setRole(Drive::Permission::WriterRole);
+        permission->setType(Drive::Permission::TypeUser);
+        permission->setValue(QStringLiteral("newmember@kde.test"));
+
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+        auto job = new Drive::PermissionBulkJob({QStringLiteral("bulkfile1"), QStringLiteral("bulkfile2")}, account);
+        job->setPermissions({permission});
+        job->setRemovedPermissionsIds({QStringLiteral("oldmemberid")});
+        job->setSendNotificationEmails(false);
+        QSignalSpy processedSpy(job, &Drive::PermissionBulkJob::fileProcessed);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        // Failure on one file does not fail the whole job
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(processedSpy.count(), 2);
+
+        QCOMPARE(job->fileError(QStringLiteral("bulkfile1")), KGAPI2::NoError);
+        const auto created = job->createdPermissions(QStringLiteral("bulkfile1"));
+        QCOMPARE(created.count(), 1);
+        QCOMPARE(created.at(0)->id(), QStringLiteral("newmemberid"));
+
+        // Missing permission is not an error, but the forbidden insert is
+        QCOMPARE(job->failedFilesIds(), QStringList{QStringLiteral("bulkfile2")});
+        QCOMPARE(job->fileError(QStringLiteral("bulkfile2")), KGAPI2::Forbidden);
+        QVERIFY(job->createdPermissions(QStringLiteral("bulkfile2")).isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(PermissionBulkJobTest)
+
+#include "permissionbulkjobtest.moc"
@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include <QBuffer>
+#include <QDir>
+#include <QImage>
+#include <QObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "drivetestutils.h"
+#include "fakenetworkaccessmanagerfactory.h"
+#include "testutils.h"
+
+#include "account.h"
+#include "file.h"
+#include "thumbnailcache.h"
+#include "thumbnailfetchjob.h"
+#include "types.h"
+
+using namespace KGAPI2;
+
+class ThumbnailFetchJobTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase()
+    {
+        NetworkAccessManagerFactory::setFactory(new FakeNetworkAccessManagerFactory);
+    }
+
+    void testFetchAndCache()
+    {
+        QTemporaryDir cacheDir;
+        QVERIFY(cacheDir.isValid());
+        const auto file = fileFromFile(QFINDTESTDATA("data/file2.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/file2_thumbnail_request.txt"), QFINDTESTDATA("data/file2_thumbnail_response.txt"))});
+
+        Drive::ThumbnailCache cache;
+        cache.setDiskCacheDirectory(cacheDir.path());
+        auto job = new Drive::ThumbnailFetchJob(file, account);
+        job->setCache(&cache);
+        QSignalSpy fetchedSpy(job, &Drive::ThumbnailFetchJob::thumbnailFetched);
+        QVERIFY(execJob(job));
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+        QCOMPARE(job->error(), KGAPI2::NoError);
+        QCOMPARE(fetchedSpy.count(), 1);
+        QCOMPARE(job->thumbnail(file->id()).size(), QSize(4, 3));
+        QCOMPARE(cache.image(file->id(), file->etag()).size(), QSize(4, 3));
+        QCOMPARE(QDir(cacheDir.path()).entryList(QDir::Files).count(), 1);
+
+        // Served from memory without any request
+        job = new Drive::ThumbnailFetchJob(file, account);
+        job->setCache(&cache);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->thumbnail(file->id()).size(), QSize(4, 3));
+
+        // Served from disk by a new cache
+        Drive::ThumbnailCache diskCache;
+        diskCache.setDiskCacheDirectory(cacheDir.path());
+        QVERIFY(diskCache.image(file->id(), file->etag()).isNull());
+        job = new Drive::ThumbnailFetchJob(file, account);
+        job->setCache(&diskCache);
+        QVERIFY(execJob(job));
+        QCOMPARE(job->thumbnail(file->id()).size(), QSize(4, 3));
+        QCOMPARE(diskCache.image(file->id(), file->etag()).size(), QSize(4, 3));
+
+        // A new version of the file needs a new thumbnail
+        QVERIFY(cache.image(file->id(), QStringLiteral("\"newetag\"")).isNull());
+
+        cache.remove(file->id());
+        QVERIFY(cache.image(file->id(), file->etag()).isNull());
+        QCOMPARE(QDir(cacheDir.path()).entryList(QDir::Files).count(), 0);
+    }
+
+    void testFileIdPrefix()
+    {
+        QTemporaryDir cacheDir;
+        QVERIFY(cacheDir.isValid());
+        QImage image(4, 3, QImage::Format_RGB32);
+        image.fill(Qt::white);
+        QByteArray data;
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::WriteOnly));
+        QVERIFY(image.save(&buffer, "PNG"));
+
+        Drive::ThumbnailCache cache;
+        cache.setDiskCacheDirectory(cacheDir.path());
+        QSignalSpy loadedSpy(&cache, &Drive::ThumbnailCache::imageLoaded);
+        const QString fileId = QStringLiteral("abc");
+        const QString otherFileId = QStringLiteral("abc-def");
+        cache.store(otherFileId, QStringLiteral("\"etag1\""), data);
+        QVERIFY(loadedSpy.wait());
+        cache.store(fileId, QStringLiteral("\"etag1\""), data);
+        QVERIFY(loadedSpy.wait());
+        QCOMPARE(QDir(cacheDir.path()).entryList(QDir::Files).count(), 2);
+
+        // Neither a new version nor the removal of a file touches the
+        // thumbnails of files whose ID starts with its ID
+        cache.store(fileId, QStringLiteral("\"etag2\""), data);
+        QVERIFY(loadedSpy.wait());
+        QCOMPARE(QDir(cacheDir.path()).entryList(QDir::Files).count(), 2);
+        cache.remove(fileId);
+        QCOMPARE(QDir(cacheDir.path()).entryList(QDir::Files).count(), 1);
+
+        Drive::ThumbnailCache diskCache;
+        diskCache.setDiskCacheDirectory(cacheDir.path());
+        QSignalSpy diskSpy(&diskCache, &Drive::ThumbnailCache::imageLoaded);
+        QVERIFY(diskCache.load(otherFileId, QStringLiteral("\"etag1\"")));
+        QVERIFY(diskSpy.wait());
+        QCOMPARE(diskCache.image(otherFileId, QStringLiteral("\"etag1\"")).size(), QSize(4, 3));
+    }
+
+    void testCoalesceRequests()
+    {
+        const auto file = fileFromFile(QFINDTESTDATA("data/file2.json"));
+        auto account = AccountPtr::create(QStringLiteral("MockAccount"), QStringLiteral("MockToken"));
+
+        // Only one download for both jobs
+        FakeNetworkAccessManagerFactory::get()->setScenarios(
+            {scenarioFromFile(QFINDTESTDATA("data/file2_thumbnail_request.txt"), QFINDTESTDATA("data/file2_thumbnail_response.txt"))});
+
+        Drive::ThumbnailCache cache;
+        auto job1 = new Drive::ThumbnailFetchJob(file, account);
+        job1->setCache(&cache);
+        auto job2 = new Drive::ThumbnailFetchJob(file, account);
+        job2->setCache(&cache);
+        QSignalSpy finishedSpy(job1, &Job::finished);
+        QVERIFY(execJob(job2));
+        QVERIFY(finishedSpy.count() == 1 || finishedSpy.wait());
+        job1->deleteLater();
+        QVERIFY(!FakeNetworkAccessManagerFactory::get()->hasScenario());
+
+        QCOMPARE(job1->thumbnail(file->id()).size(), QSize(4, 3));
+        QCOMPARE(job2->thumbnail(file->id()).size(), QSize(4, 3));
+    }
+};
+
+QTEST_GUILESS_MAIN(ThumbnailFetchJobTest)
+
+#include "thumbnailfetchjobtest.moc"
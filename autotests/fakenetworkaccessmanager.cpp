@@ -9,6 +9,7 @@
 #include "fakenetworkreply.h"
 #include "testutils.h"
 
+#include <QEventLoop>
 #include <QNetworkRequest>
 
 #include <iostream>
@@ -50,7 +51,14 @@ QNetworkReply *FakeNetworkAccessManager::createRequest(Operation op, const QNetw
     }
 
     if (outgoingData) {
-        const auto actualRequest = outgoingData->readAll();
+        auto actualRequest = outgoingData->readAll();
+        // Throttled bodies only provide the rest of the data once the bandwidth limit allows it
+        while (!outgoingData->isSequential() && !outgoingData->atEnd()) {
+            QEventLoop loop;
+            connect(outgoingData, &QIODevice::readyRead, &loop, &QEventLoop::quit);
+            loop.exec();
+            actualRequest += outgoingData->readAll();
+        }
         if (actualRequest.startsWith('<')) {
             const auto formattedInput = reformatXML(actualRequest);
             const auto formattedExpected = reformatXML(scenario.requestData);
@@ -70,7 +78,7 @@ QNetworkReply *FakeNetworkAccessManager::createRequest(Operation op, const QNetw
         }
     }
 
-    return new FakeNetworkReply(scenario);
+    return new FakeNetworkReply(scenario, originalReq);
 }
 
 #include "moc_fakenetworkaccessmanager.cpp"
@@ -7,9 +7,10 @@
 #include "fakenetworkreply.h"
 #include "types.h"
 
-FakeNetworkReply::FakeNetworkReply(const FakeNetworkAccessManager::Scenario &scenario)
+FakeNetworkReply::FakeNetworkReply(const FakeNetworkAccessManager::Scenario &scenario, const QNetworkRequest &originalRequest)
     : QNetworkReply()
 {
+    setRequest(originalRequest);
     setUrl(scenario.requestUrl);
     setOperation(scenario.requestMethod);
     setAttribute(QNetworkRequest::HttpStatusCodeAttribute, scenario.responseCode);
@@ -41,6 +42,7 @@ FakeNetworkReply::FakeNetworkReply(const FakeNetworkAccessManager::Scenario &sce
 FakeNetworkReply::FakeNetworkReply(QNetworkAccessManager::Operation method, const QNetworkRequest &originalRequest)
     : QNetworkReply()
 {
+    setRequest(originalRequest);
     setOperation(method);
     setUrl(originalRequest.url());
 
@@ -124,3 +124,32 @@ void Event::setEventType(EventType type)
 {
     setCustomProperty("LIBKGAPI", EventTypeProperty, CalendarService::eventTypeToString(type));
 }
+
+const QString Event::Fields::Kind = QStringLiteral("kind");
+const QString Event::Fields::Etag = QStringLiteral("etag");
+const QString Event::Fields::Id = QStringLiteral("id");
+const QString Event::Fields::ICalUID = QStringLiteral("iCalUID");
+const QString Event::Fields::Status = QStringLiteral("status");
+const QString Event::Fields::Created = QStringLiteral("created");
+const QString Event::Fields::Updated = QStringLiteral("updated");
+const QString Event::Fields::Summary = QStringLiteral("summary");
+const QString Event::Fields::Description = QStringLiteral("description");
+const QString Event::Fields::Location = QStringLiteral("location");
+const QString Event::Fields::Start = QStringLiteral("start");
+const QString Event::Fields::End = QStringLiteral("end");
+const QString Event::Fields::OriginalStartTime = QStringLiteral("originalStartTime");
+const QString Event::Fields::Transparency = QStringLiteral("transparency");
+const QString Event::Fields::Visibility = QStringLiteral("visibility");
+const QString Event::Fields::Organizer = QStringLiteral("organizer");
+const QString Event::Fields::Attendees = QStringLiteral("attendees");
+const QString Event::Fields::Recurrence = QStringLiteral("recurrence");
+const QString Event::Fields::RecurringEventId = QStringLiteral("recurringEventId");
+const QString Event::Fields::Reminders = QStringLiteral("reminders");
+const QString Event::Fields::ExtendedProperties = QStringLiteral("extendedProperties");
+const QString Event::Fields::HangoutLink = QStringLiteral("hangoutLink");
+const QString Event::Fields::ConferenceData = QStringLiteral("conferenceData");
+const QString Event::Fields::EventType = QStringLiteral("eventType");
+const QString Event::Fields::Items = QStringLiteral("items");
+const QString Event::Fields::TimeZone = QStringLiteral("timeZone");
+const QString Event::Fields::NextPageToken = QStringLiteral("nextPageToken");
+const QString Event::Fields::NextSyncToken = QStringLiteral("nextSyncToken");
@@ -114,6 +114,47 @@ public:
      */
     void setEventType(EventType eventType);
 
+    /**
+     * @brief Names of event resource properties
+     *
+     * Can be used to build a partial response projection, see
+     * EventFetchJob::setFields().
+     *
+     * @since 6.9.0
+     */
+    struct KGAPICALENDAR_EXPORT Fields {
+        static const QString Kind;
+        static const QString Etag;
+        static const QString Id;
+        static const QString ICalUID;
+        static const QString Status;
+        static const QString Created;
+        static const QString Updated;
+        static const QString Summary;
+        static const QString Description;
+        static const QString Location;
+        static const QString Start;
+        static const QString End;
+        static const QString OriginalStartTime;
+        static const QString Transparency;
+        static const QString Visibility;
+        static const QString Organizer;
+        static const QString Attendees;
+        static const QString Recurrence;
+        static const QString RecurringEventId;
+        static const QString Reminders;
+        static const QString ExtendedProperties;
+        static const QString HangoutLink;
+        static const QString ConferenceData;
+        static const QString EventType;
+
+        /* Event list properties */
+        static const QString Items;
+        static const QString TimeZone;
+        static const QString NextPageToken;
+        static const QString NextSyncToken;
+    };
+
 private:
     class Private;
     QScopedPointer<Private> const d;
@@ -19,6 +19,11 @@
 
 using namespace KGAPI2;
 
+namespace
+{
+static constexpr int MaxResultsLimit = 2500;
+}
+
 class Q_DECL_HIDDEN EventFetchJob::Private
 {
 public:
@@ -27,6 +32,8 @@ public:
     QString filter;
     QString syncToken;
     QList<Event::EventType> eventTypes = { Event::EventType::Default, Event::EventType::FocusTime, Event::EventType::OutOfOffice };
+    QStringList fields;
+    int maxResults = 0;
     bool fetchDeleted = true;
     quint64 updatedTimestamp = 0;
     quint64 timeMin = 0;
@@ -135,6 +142,47 @@ QString EventFetchJob::filter() const
     return d->filter;
 }
 
+void EventFetchJob::setMaxResults(int maxResults)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify maxResults property when job is running";
+        return;
+    }
+
+    if (maxResults > MaxResultsLimit) {
+        qCWarning(KGAPIDebug) << "maxResults" << maxResults << "exceeds the limit of" << MaxResultsLimit << "events per page, clamping.";
+        maxResults = MaxResultsLimit;
+    }
+
+    d->maxResults = maxResults;
+}
+
+int EventFetchJob::maxResults() const
+{
+    return d->maxResults;
+}
+
+void EventFetchJob::setFields(const QStringList &fields)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called setFields() on running job. Ignoring.";
+        return;
+    }
+
+    d->fields = fields;
+}
+
+QStringList EventFetchJob::fields() const
+{
+    return d->fields;
+}
+
+const QStringList &EventFetchJob::FieldShorthands::summaryFields()
+{
+    static const QStringList summaryFields = {Event::Fields::Id, Event::Fields::Summary, Event::Fields::Start, Event::Fields::End, Event::Fields::Status};
+    return summaryFields;
+}
+
 void EventFetchJob::start()
 {
     QUrl url;
@@ -161,9 +209,31 @@ void EventFetchJob::start()
         for (const auto eventType : std::as_const(d->eventTypes)) {
             query.addQueryItem(QStringLiteral("eventTypes"), CalendarService::eventTypeToString(eventType));
         }
+        if (d->maxResults > 0) {
+            query.addQueryItem(QStringLiteral("maxResults"), QString::number(d->maxResults));
+        }
         url.setQuery(query);
+
+        if (!d->fields.isEmpty()) {
+            // The feed parser requires kind and timeZone of the feed, and the
+            // page and sync tokens are needed to continue and to sync incrementally
+            Job::setFields({Event::Fields::Kind,
+                            Event::Fields::TimeZone,
+                            Event::Fields::NextPageToken,
+                            Event::Fields::NextSyncToken,
+                            Job::buildSubfields(Event::Fields::Items, d->fields)});
+        }
     } else {
         url = CalendarService::fetchEventUrl(d->calendarId, d->eventId);
+
+        if (!d->fields.isEmpty()) {
+            // Deserializing requires kind attribute, always force add it
+            QStringList fields = d->fields;
+            if (!fields.contains(Event::Fields::Kind)) {
+                fields << Event::Fields::Kind;
+            }
+            Job::setFields(fields);
+        }
     }
     const QNetworkRequest request = CalendarService::prepareRequest(url);
     enqueueRequest(request);
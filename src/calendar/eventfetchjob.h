@@ -13,6 +13,7 @@
 #include "kgapicalendar_export.h"
 
 #include <QScopedPointer>
+#include <QStringList>
 
 namespace KGAPI2
 {
@@ -111,7 +112,32 @@ class KGAPICALENDAR_EXPORT EventFetchJob : public KGAPI2::FetchJob
      */
     Q_PROPERTY(QString syncToken READ syncToken WRITE setSyncToken)
 
+    /**
+     * @brief Maximum number of events returned on one result page
+     *
+     * By default the property is 0 and the server default (250 events) is
+     * used. The maximum allowed value is 2500.
+     *
+     * This property does not have any effect when fetching a specific event and
+     * can be modified only when the job is not running.
+     *
+     * @see setMaxResults, maxResults
+     * @since 6.9.0
+     */
+    Q_PROPERTY(int maxResults READ maxResults WRITE setMaxResults)
+
 public:
+    struct FieldShorthands {
+        /**
+         * @brief Fields needed to present an event in a list view
+         *
+         * Contains ID, summary, start, end and status of the event.
+         *
+         * @since 6.9.0
+         */
+        static const QStringList &summaryFields();
+    };
+
     /**
      * @brief Constructs a job that will fetch all events from a calendar with
      *        given @p calendarId
@@ -231,6 +257,44 @@ public:
      */
     [[nodiscard]] QString syncToken() const;
 
+    /**
+     * @brief Sets maximum number of events returned on one result page
+     *
+     * Values above 2500 are clamped to 2500.
+     *
+     * @param maxResults
+     * @since 6.9.0
+     */
+    void setMaxResults(int maxResults);
+
+    /**
+     * @brief Returns maximum number of events returned on one result page
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] int maxResults() const;
+
+    /**
+     * @brief Sets subset of event fields to include in the response
+     *
+     * Only the listed event properties (see Event::Fields) will be
+     * requested from the server. Properties of the result page that are
+     * required by the job (page and sync tokens) are always requested.
+     *
+     * By default all fields are fetched.
+     *
+     * @param fields List of event fields
+     * @since 6.9.0
+     */
+    void setFields(const QStringList &fields);
+
+    /**
+     * @brief Returns subset of event fields included in the response
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] QStringList fields() const;
+
 protected:
     /**
      * @brief KGAPI2::Job::start implementation
@@ -0,0 +1,362 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "eventimportjob.h"
+#include "account.h"
+#include "calendarservice.h"
+#include "debug.h"
+#include "event.h"
+#include "utils.h"
+
+#include <QJsonDocument>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QUrlQuery>
+
+#include <algorithm>
+
+using namespace KGAPI2;
+
+namespace
+{
+static constexpr int DefaultMaxConcurrentRequests = 8;
+static const auto UidFetchPageSize = QStringLiteral("2500");
+}
+
+class Q_DECL_HIDDEN EventImportJob::Private
+{
+public:
+    Private(EventImportJob *parent)
+        : q(parent)
+    {
+    }
+
+    void setEvents(const EventsList &list);
+    void fetchUids(const QString &pageToken = QString());
+    void feed();
+    bool shouldSkip(const EventPtr &event);
+    void enqueueEvent(qsizetype idx);
+    void finishEvent(const EventPtr &event, Result result);
+
+    EventsList events;
+    qsizetype firstExceptionIndex = 0;
+    QString calendarId;
+    SendUpdatesPolicy updatesPolicy = SendUpdatesPolicy::All;
+
+    bool skipExisting = true;
+    bool uidsProvided = false;
+    QSet<QString> existingUids;
+    QSet<QString> enqueuedUids;
+    bool fetchingUids = false;
+
+    qsizetype next = 0;
+    int inFlight = 0;
+    int inFlightMasters = 0;
+    qsizetype processed = 0;
+
+    EventsList skipped;
+    EventsList failed;
+
+private:
+    EventImportJob *const q;
+};
+
+void EventImportJob::Private::setEvents(const EventsList &list)
+{
+    // Modified occurrences must be stored only after their recurring event
+    events = list;
+    const auto it = std::stable_partition(events.begin(), events.end(), [](const EventPtr &event) {
+        return !event->hasRecurrenceId();
+    });
+    firstExceptionIndex = std::distance(events.begin(), it);
+}
+
+void EventImportJob::Private::fetchUids(const QString &pageToken)
+{
+    QUrl url = CalendarService::fetchEventsUrl(calendarId);
+    QUrlQuery query(url);
+    query.addQueryItem(QStringLiteral("maxResults"), UidFetchPageSize);
+    query.addQueryItem(Job::StandardParams::Fields, QStringLiteral("nextPageToken,items(iCalUID)"));
+    if (!pageToken.isEmpty()) {
+        query.addQueryItem(QStringLiteral("pageToken"), pageToken);
+    }
+    url.setQuery(query);
+
+    q->enqueueRequest(CalendarService::prepareRequest(url));
+}
+
+bool EventImportJob::Private::shouldSkip(const EventPtr &event)
+{
+    const QString uid = event->uid();
+    if (uid.isEmpty()) {
+        return false;
+    }
+
+    if (skipExisting && existingUids.contains(uid)) {
+        return true;
+    }
+
+    if (!event->hasRecurrenceId()) {
+        // Duplicate event in the imported data
+        if (enqueuedUids.contains(uid)) {
+            return true;
+        }
+        enqueuedUids.insert(uid);
+    }
+
+    return false;
+}
+
+void EventImportJob::Private::enqueueEvent(qsizetype idx)
+{
+    const EventPtr &event = events.at(idx);
+
+    // Same as in EventCreateJob: import a private copy of events organized by someone else
+    QUrl requestUrl;
+    if (!event->attendees().isEmpty() && !event->organizer().isEmpty() && event->organizer().email() != q->account()->accountName()) {
+        requestUrl = CalendarService::importEventUrl(calendarId, updatesPolicy);
+    } else {
+        requestUrl = CalendarService::createEventUrl(calendarId, updatesPolicy);
+    }
+
+    auto request = CalendarService::prepareRequest(requestUrl);
+    request.setAttribute(QNetworkRequest::User, idx);
+    const QByteArray rawData = CalendarService::eventToJSON(event, CalendarService::EventSerializeFlag::NoID);
+
+    ++inFlight;
+    if (idx < firstExceptionIndex) {
+        ++inFlightMasters;
+    }
+    q->enqueueRequest(request, rawData, QStringLiteral("application/json"));
+}
+
+void EventImportJob::Private::feed()
+{
+    const int window = std::max(1, q->maxConcurrentRequests());
+    while (inFlight < window && next < events.size()) {
+        if (next >= firstExceptionIndex && inFlightMasters > 0) {
+            // Wait until all recurring events are stored
+            break;
+        }
+
+        const qsizetype idx = next++;
+        const EventPtr &event = events.at(idx);
+        if (shouldSkip(event)) {
+            finishEvent(event, Result::Skipped);
+            continue;
+        }
+        enqueueEvent(idx);
+    }
+}
+
+void EventImportJob::Private::finishEvent(const EventPtr &event, Result result)
+{
+    if (result == Result::Skipped) {
+        skipped << event;
+    } else if (result == Result::Failed) {
+        failed << event;
+    }
+
+    Q_EMIT q->eventProcessed(q, event, result);
+    q->emitProgress(static_cast<int>(++processed), static_cast<int>(events.size()));
+}
+
+EventImportJob::EventImportJob(const EventsList &events, const QString &calendarId, const AccountPtr &account, QObject *parent)
+    : CreateJob(account, parent)
+    , d(new Private(this))
+{
+    d->setEvents(events);
+    d->calendarId = calendarId;
+    setMaxConcurrentRequests(DefaultMaxConcurrentRequests);
+}
+
+EventImportJob::EventImportJob(const KCalendarCore::Calendar::Ptr &calendar, const QString &calendarId, const AccountPtr &account, QObject *parent)
+    : CreateJob(account, parent)
+    , d(new Private(this))
+{
+    EventsList events;
+    const auto rawEvents = calendar->rawEvents();
+    events.reserve(rawEvents.size());
+    for (const auto &event : rawEvents) {
+        events << EventPtr::create(*event);
+    }
+    d->setEvents(events);
+    d->calendarId = calendarId;
+    setMaxConcurrentRequests(DefaultMaxConcurrentRequests);
+}
+
+EventImportJob::~EventImportJob() = default;
+
+bool EventImportJob::skipExisting() const
+{
+    return d->skipExisting;
+}
+
+void EventImportJob::setSkipExisting(bool skipExisting)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify skipExisting property when job is running";
+        return;
+    }
+
+    d->skipExisting = skipExisting;
+}
+
+void EventImportJob::setExistingUids(const QSet<QString> &uids)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify existing UIDs when job is running";
+        return;
+    }
+
+    d->existingUids = uids;
+    d->uidsProvided = true;
+}
+
+SendUpdatesPolicy EventImportJob::sendUpdates() const
+{
+    return d->updatesPolicy;
+}
+
+void EventImportJob::setSendUpdates(SendUpdatesPolicy updatePolicy)
+{
+    d->updatesPolicy = updatePolicy;
+}
+
+EventsList EventImportJob::skippedEvents() const
+{
+    return d->skipped;
+}
+
+EventsList EventImportJob::failedEvents() const
+{
+    return d->failed;
+}
+
+void EventImportJob::start()
+{
+    d->next = 0;
+    d->inFlight = 0;
+    d->inFlightMasters = 0;
+    d->processed = 0;
+    d->enqueuedUids.clear();
+    d->skipped.clear();
+    d->failed.clear();
+    if (!d->uidsProvided) {
+        d->existingUids.clear();
+    }
+
+    if (d->skipExisting && !d->uidsProvided) {
+        d->fetchingUids = true;
+        d->fetchUids();
+        return;
+    }
+
+    d->feed();
+    if (d->inFlight == 0) {
+        emitFinished();
+    }
+}
+
+void EventImportJob::dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType)
+{
+    if (data.isEmpty()) {
+        // Fetching UIDs of existing events
+        accessManager->get(request);
+    } else {
+        CreateJob::dispatchRequest(accessManager, request, data, contentType);
+    }
+}
+
+void EventImportJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
+{
+    if (!d->fetchingUids) {
+        CreateJob::handleReply(reply, rawData);
+        return;
+    }
+
+    const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+    if (Utils::stringToContentType(contentType) != KGAPI2::JSON) {
+        setError(KGAPI2::InvalidResponse);
+        setErrorString(tr("Invalid response content type"));
+        emitFinished();
+        return;
+    }
+
+    const QVariantMap data = QJsonDocument::fromJson(rawData).toVariant().toMap();
+    const QVariantList items = data.value(QStringLiteral("items")).toList();
+    for (const auto &item : items) {
+        d->existingUids.insert(item.toMap().value(QStringLiteral("iCalUID")).toString());
+    }
+
+    const QString nextPageToken = data.value(QStringLiteral("nextPageToken")).toString();
+    if (!nextPageToken.isEmpty()) {
+        d->fetchUids(nextPageToken);
+        return;
+    }
+
+    d->fetchingUids = false;
+    d->feed();
+}
+
+ObjectsList EventImportJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
+{
+    const qsizetype idx = currentRequest().attribute(QNetworkRequest::User).toLongLong();
+    --d->inFlight;
+    if (idx < d->firstExceptionIndex) {
+        --d->inFlightMasters;
+    }
+
+    ObjectsList items;
+    const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+    if (Utils::stringToContentType(contentType) == KGAPI2::JSON) {
+        const EventPtr event = CalendarService::JSONToEvent(rawData);
+        if (event) {
+            items << event.dynamicCast<Object>();
+            d->finishEvent(event, Result::Created);
+        } else {
+            d->finishEvent(d->events.at(idx), Result::Failed);
+        }
+    } else {
+        d->finishEvent(d->events.at(idx), Result::Failed);
+    }
+
+    d->feed();
+    return items;
+}
+
+bool EventImportJob::handleError(int statusCode, const QByteArray &rawData)
+{
+    if (d->fetchingUids) {
+        return CreateJob::handleError(statusCode, rawData);
+    }
+
+    switch (statusCode) {
+    case KGAPI2::BadRequest:
+    case KGAPI2::Forbidden:
+    case KGAPI2::NotFound:
+    case KGAPI2::Conflict:
+    case KGAPI2::Gone: {
+        const qsizetype idx = currentRequest().attribute(QNetworkRequest::User).toLongLong();
+        --d->inFlight;
+        if (idx < d->firstExceptionIndex) {
+            --d->inFlightMasters;
+        }
+
+        const EventPtr event = d->events.at(idx);
+        qCWarning(KGAPIDebug) << "Failed to import event" << event->uid() << ", Google replied" << rawData;
+        // Conflict means an event with the same identifier already exists
+        d->finishEvent(event, statusCode == KGAPI2::Conflict ? Result::Skipped : Result::Failed);
+        d->feed();
+        return true;
+    }
+    default:
+        return CreateJob::handleError(statusCode, rawData);
+    }
+}
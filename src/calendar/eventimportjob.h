@@ -0,0 +1,124 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "createjob.h"
+#include "enums.h"
+#include "kgapicalendar_export.h"
+
+#include <KCalendarCore/Calendar>
+
+#include <QScopedPointer>
+#include <QSet>
+
+namespace KGAPI2
+{
+
+/**
+ * @brief A job to import a large amount of events into a calendar
+ *
+ * Unlike EventCreateJob, which creates the events one after another, this job
+ * keeps up to Job::maxConcurrentRequests (8 by default) create or import
+ * requests in flight. Modified occurrences of recurring events are sent only
+ * after all other events have been stored, so that their recurring event
+ * already exists.
+ *
+ * Events whose iCalUID already exists in the target calendar are skipped. The
+ * UIDs of existing events can be provided by the caller using setExistingUids(),
+ * otherwise the job fetches them from the calendar before importing.
+ *
+ * Failure to store an event does not abort the job, the result of each event
+ * is reported by the eventProcessed() signal as soon as it is known.
+ *
+ * @since 6.9.0
+ */
+class KGAPICALENDAR_EXPORT EventImportJob : public KGAPI2::CreateJob
+{
+    Q_OBJECT
+
+    /**
+     * @brief Whether to skip events whose iCalUID already exists in the calendar
+     *
+     * By default the property is @p true.
+     *
+     * This property can be modified only when the job is not running.
+     */
+    Q_PROPERTY(bool skipExisting READ skipExisting WRITE setSkipExisting)
+
+    Q_PROPERTY(KGAPI2::SendUpdatesPolicy sendUpdates READ sendUpdates WRITE setSendUpdates)
+public:
+    enum class Result {
+        Created, ///< The event was stored in the calendar
+        Skipped, ///< An event with the same iCalUID already exists in the calendar
+        Failed, ///< The server refused to store the event
+    };
+    Q_ENUM(Result)
+
+    /**
+     * @brief Constructs a job that will import @p events into a calendar
+     *        with given @p calendarId
+     */
+    explicit EventImportJob(const EventsList &events, const QString &calendarId, const AccountPtr &account, QObject *parent = nullptr);
+
+    /**
+     * @brief Constructs a job that will import all events from @p calendar
+     *        into a calendar with given @p calendarId
+     */
+    explicit EventImportJob(const KCalendarCore::Calendar::Ptr &calendar, const QString &calendarId, const AccountPtr &account, QObject *parent = nullptr);
+
+    ~EventImportJob() override;
+
+    [[nodiscard]] bool skipExisting() const;
+    void setSkipExisting(bool skipExisting);
+
+    /**
+     * @brief Sets iCalUIDs of events that already exist in the calendar
+     *
+     * When set, the job does not fetch the UIDs from the calendar.
+     */
+    void setExistingUids(const QSet<QString> &uids);
+
+    [[nodiscard]] KGAPI2::SendUpdatesPolicy sendUpdates() const;
+    void setSendUpdates(KGAPI2::SendUpdatesPolicy updatePolicy);
+
+    /**
+     * @brief Returns events that were skipped because they already exist
+     */
+    [[nodiscard]] EventsList skippedEvents() const;
+
+    /**
+     * @brief Returns events that the server refused to store
+     */
+    [[nodiscard]] EventsList failedEvents() const;
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted when the result of importing an event is known
+     *
+     * @param job The job
+     * @param event The event as stored on the server when @p result is
+     *        Result::Created, the source event otherwise
+     * @param result Result of importing the event
+     */
+    void eventProcessed(KGAPI2::Job *job, const KGAPI2::EventPtr &event, KGAPI2::EventImportJob::Result result);
+
+protected:
+    void start() override;
+    void dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType) override;
+    void handleReply(const QNetworkReply *reply, const QByteArray &rawData) override;
+    ObjectsList handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData) override;
+    bool handleError(int statusCode, const QByteArray &rawData) override;
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace KGAPI2
@@ -10,6 +10,7 @@
 #include "calendarservice.h"
 #include "event.h"
 #include "private/queuehelper_p.h"
+#include "debug.h"
 #include "utils.h"
 
 #include <QNetworkReply>
@@ -23,6 +24,7 @@ public:
     QueueHelper<EventPtr> events;
     QString calendarId;
     SendUpdatesPolicy updatesPolicy = SendUpdatesPolicy::All;
+    QHash<QString, EventPtr> originals;
 };
 
 EventModifyJob::EventModifyJob(const EventPtr &event, const QString &calendarId, const AccountPtr &account, QObject *parent)
@@ -56,6 +58,24 @@ SendUpdatesPolicy EventModifyJob::sendUpdates() const
     return d->updatesPolicy;
 }
 
+void EventModifyJob::setOriginalEvents(const EventsList &originals)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify originalEvents property when job is running";
+        return;
+    }
+
+    d->originals.clear();
+    for (const EventPtr &original : originals) {
+        d->originals.insert(original->id(), original);
+    }
+}
+
+EventsList EventModifyJob::originalEvents() const
+{
+    return d->originals.values();
+}
+
 void EventModifyJob::start()
 {
     if (d->events.atEnd()) {
@@ -67,7 +87,12 @@ void EventModifyJob::start()
     const auto request = CalendarService::prepareRequest(CalendarService::updateEventUrl(d->calendarId, event->id(), d->updatesPolicy));
     const QByteArray rawData = CalendarService::eventToJSON(event);
 
-    enqueueRequest(request, rawData, QStringLiteral("application/json"));
+    const EventPtr original = d->originals.value(event->id());
+    if (original) {
+        enqueuePatchRequest(request, CalendarService::eventToJSON(original), rawData, original->etag());
+    } else {
+        enqueueRequest(request, rawData, QStringLiteral("application/json"));
+    }
 }
 
 ObjectsList EventModifyJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
@@ -64,6 +64,20 @@ class KGAPICALENDAR_EXPORT EventModifyJob : public KGAPI2::ModifyJob
     [[nodiscard]] KGAPI2::SendUpdatesPolicy sendUpdates() const;
     void setSendUpdates(KGAPI2::SendUpdatesPolicy updatesPolicy);
 
+    /**
+     * @brief Sets the last fetched state of the modified events
+     *
+     * Events that have a snapshot with the same ID are updated with a PATCH
+     * request carrying only the changed fields, conditional on the snapshot's
+     * ETag. If the event has been modified remotely in the meantime the job
+     * fails with KGAPI2::PreconditionFailed. Events without a snapshot are
+     * replaced as a whole.
+     *
+     * @since 6.9.0
+     */
+    void setOriginalEvents(const EventsList &originals);
+    [[nodiscard]] EventsList originalEvents() const;
+
   Q_SIGNALS:
     void sendUpdatesChanged(KGAPI2::SendUpdatesPolicy policy);
 
@@ -0,0 +1,263 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "freebusyindex.h"
+#include "debug.h"
+#include "event.h"
+
+#include <KCalendarCore/Recurrence>
+
+#include <QHash>
+#include <QSet>
+#include <QTimeZone>
+
+#include <algorithm>
+
+using namespace KGAPI2;
+
+namespace
+{
+
+struct Interval {
+    qint64 start; // msecs since epoch
+    qint64 end; // msecs since epoch, exclusive
+};
+
+using IntervalList = QList<Interval>;
+
+// Sorts the intervals and merges overlapping and adjacent ones
+void normalize(IntervalList &intervals)
+{
+    if (intervals.isEmpty()) {
+        return;
+    }
+
+    std::sort(intervals.begin(), intervals.end(), [](const Interval &a, const Interval &b) {
+        return a.start < b.start;
+    });
+
+    qsizetype last = 0;
+    for (qsizetype i = 1; i < intervals.size(); ++i) {
+        if (intervals[i].start <= intervals[last].end) {
+            intervals[last].end = std::max(intervals[last].end, intervals[i].end);
+        } else {
+            intervals[++last] = intervals[i];
+        }
+    }
+    intervals.resize(last + 1);
+}
+
+// Appends parts of normalized @p intervals that overlap with <from, to) to @p result
+void lookup(const IntervalList &intervals, qint64 from, qint64 to, IntervalList &result)
+{
+    // First interval that ends after the beginning of the queried range
+    auto it = std::partition_point(intervals.cbegin(), intervals.cend(), [from](const Interval &interval) {
+        return interval.end <= from;
+    });
+    for (; it != intervals.cend() && it->start < to; ++it) {
+        result.push_back({std::max(it->start, from), std::min(it->end, to)});
+    }
+}
+
+FreeBusyQueryJob::BusyRangeList toBusyRanges(const IntervalList &intervals)
+{
+    FreeBusyQueryJob::BusyRangeList ranges;
+    ranges.reserve(intervals.size());
+    for (const auto &interval : intervals) {
+        ranges.push_back({QDateTime::fromMSecsSinceEpoch(interval.start, QTimeZone::UTC), QDateTime::fromMSecsSinceEpoch(interval.end, QTimeZone::UTC)});
+    }
+    return ranges;
+}
+
+} // namespace
+
+class Q_DECL_HIDDEN FreeBusyIndex::Private
+{
+public:
+    Private(const QDateTime &windowStart, const QDateTime &windowEnd)
+        : windowStart(windowStart)
+        , windowEnd(windowEnd)
+    {
+    }
+
+    IntervalList buildIndex(const EventsList &events) const;
+    void addOccurrence(IntervalList &intervals, const QDateTime &start, const QDateTime &end) const;
+
+    const QDateTime windowStart;
+    const QDateTime windowEnd;
+    QHash<QString, IntervalList> calendars;
+};
+
+void FreeBusyIndex::Private::addOccurrence(IntervalList &intervals, const QDateTime &start, const QDateTime &end) const
+{
+    const qint64 from = std::max(start.toMSecsSinceEpoch(), windowStart.toMSecsSinceEpoch());
+    const qint64 to = std::min(end.toMSecsSinceEpoch(), windowEnd.toMSecsSinceEpoch());
+    if (from < to) {
+        intervals.push_back({from, to});
+    }
+}
+
+IntervalList FreeBusyIndex::Private::buildIndex(const EventsList &events) const
+{
+    // Occurrences of recurring events that have been modified or cancelled are
+    // stored as separate events, identified by the UID of the recurring event
+    // and the original start of the occurrence.
+    QHash<QString, QSet<qint64>> exceptions;
+    for (const auto &event : events) {
+        if (event->hasRecurrenceId()) {
+            exceptions[event->uid()].insert(event->recurrenceId().toMSecsSinceEpoch());
+        }
+    }
+
+    IntervalList intervals;
+    for (const auto &event : events) {
+        if (event->deleted() || event->status() == KCalendarCore::Incidence::StatusCanceled) {
+            continue;
+        }
+        if (event->transparency() == KCalendarCore::Event::Transparent) {
+            continue;
+        }
+
+        const QDateTime dtStart = event->dtStart();
+        if (!dtStart.isValid()) {
+            continue;
+        }
+
+        // All-day events block whole days, dtEnd of all-day events is inclusive
+        const bool allDay = event->allDay();
+        const qint64 days = allDay ? dtStart.date().daysTo(event->dtEnd().date()) + 1 : 0;
+        const qint64 duration = allDay ? 0 : dtStart.msecsTo(event->dtEnd());
+        const auto occurrenceEnd = [allDay, days, duration](const QDateTime &start) {
+            return allDay ? start.addDays(days) : start.addMSecs(duration);
+        };
+        const auto occurrenceStart = [allDay](const QDateTime &start) {
+            return allDay ? QDateTime(start.date(), QTime(0, 0), start.timeZone()) : start;
+        };
+
+        if (event->recurs() && !event->hasRecurrenceId()) {
+            const auto &eventExceptions = exceptions.value(event->uid());
+            // Include occurrences that started before the window but still last into it
+            const QDateTime from = allDay ? windowStart.addDays(-days) : windowStart.addMSecs(-duration);
+            const auto times = event->recurrence()->timesInInterval(from, windowEnd);
+            for (const auto &time : times) {
+                if (eventExceptions.contains(time.toMSecsSinceEpoch())) {
+                    continue;
+                }
+                const QDateTime start = occurrenceStart(time);
+                addOccurrence(intervals, start, occurrenceEnd(start));
+            }
+        } else {
+            const QDateTime start = occurrenceStart(dtStart);
+            addOccurrence(intervals, start, occurrenceEnd(start));
+        }
+    }
+
+    normalize(intervals);
+    return intervals;
+}
+
+FreeBusyIndex::FreeBusyIndex(const QDateTime &windowStart, const QDateTime &windowEnd)
+    : d(new Private(windowStart, windowEnd))
+{
+}
+
+FreeBusyIndex::~FreeBusyIndex() = default;
+
+QDateTime FreeBusyIndex::windowStart() const
+{
+    return d->windowStart;
+}
+
+QDateTime FreeBusyIndex::windowEnd() const
+{
+    return d->windowEnd;
+}
+
+void FreeBusyIndex::setEvents(const QString &calendarId, const EventsList &events)
+{
+    d->calendars.insert(calendarId, d->buildIndex(events));
+}
+
+void FreeBusyIndex::removeCalendar(const QString &calendarId)
+{
+    d->calendars.remove(calendarId);
+}
+
+QStringList FreeBusyIndex::calendars() const
+{
+    return d->calendars.keys();
+}
+
+FreeBusyQueryJob::BusyRangeList FreeBusyIndex::busy(const QString &calendarId, const QDateTime &timeMin, const QDateTime &timeMax) const
+{
+    const auto it = d->calendars.constFind(calendarId);
+    if (it == d->calendars.cend()) {
+        return {};
+    }
+
+    if (timeMin < d->windowStart || timeMax > d->windowEnd) {
+        qCWarning(KGAPIDebug) << "Free/busy query exceeds the indexed window, results will be incomplete";
+    }
+
+    IntervalList result;
+    lookup(*it, timeMin.toMSecsSinceEpoch(), timeMax.toMSecsSinceEpoch(), result);
+    return toBusyRanges(result);
+}
+
+FreeBusyQueryJob::BusyRangeMap FreeBusyIndex::busy(const QStringList &calendarIds, const QDateTime &timeMin, const QDateTime &timeMax) const
+{
+    FreeBusyQueryJob::BusyRangeMap result;
+    for (const auto &calendarId : calendarIds) {
+        if (d->calendars.contains(calendarId)) {
+            result.insert(calendarId, busy(calendarId, timeMin, timeMax));
+        }
+    }
+    return result;
+}
+
+FreeBusyQueryJob::BusyRangeList FreeBusyIndex::mergedBusy(const QStringList &calendarIds, const QDateTime &timeMin, const QDateTime &timeMax) const
+{
+    const qint64 from = timeMin.toMSecsSinceEpoch();
+    const qint64 to = timeMax.toMSecsSinceEpoch();
+
+    IntervalList result;
+    for (const auto &calendarId : calendarIds) {
+        const auto it = d->calendars.constFind(calendarId);
+        if (it != d->calendars.cend()) {
+            lookup(*it, from, to, result);
+        }
+    }
+    normalize(result);
+    return toBusyRanges(result);
+}
+
+bool FreeBusyIndex::isFree(const QString &calendarId, const QDateTime &timeMin, const QDateTime &timeMax) const
+{
+    const auto it = d->calendars.constFind(calendarId);
+    if (it == d->calendars.cend()) {
+        return false;
+    }
+
+    const qint64 from = timeMin.toMSecsSinceEpoch();
+    const qint64 to = timeMax.toMSecsSinceEpoch();
+    const auto interval = std::partition_point(it->cbegin(), it->cend(), [from](const Interval &i) {
+        return i.end <= from;
+    });
+    return interval == it->cend() || interval->start >= to;
+}
+
+QStringList FreeBusyIndex::freeCalendars(const QStringList &calendarIds, const QDateTime &timeMin, const QDateTime &timeMax) const
+{
+    QStringList result;
+    for (const auto &calendarId : calendarIds) {
+        if (isFree(calendarId, timeMin, timeMax)) {
+            result.push_back(calendarId);
+        }
+    }
+    return result;
+}
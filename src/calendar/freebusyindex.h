@@ -0,0 +1,114 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "freebusyqueryjob.h"
+#include "kgapicalendar_export.h"
+#include "types.h"
+
+#include <QDateTime>
+#include <QScopedPointer>
+#include <QStringList>
+
+namespace KGAPI2
+{
+
+/**
+ * @brief Computes free/busy information from locally available events
+ *
+ * For calendars whose events are already mirrored locally (for example
+ * using EventFetchJob with a sync token), the index can answer free/busy
+ * queries without a round-trip to the freeBusy endpoint.
+ *
+ * Events are expanded into busy intervals within a fixed window when they
+ * are added to the index. Recurring events are expanded using their
+ * KCalendarCore::Recurrence, modified and cancelled occurrences are taken
+ * into account and transparent events do not block time. The intervals of
+ * each calendar are kept sorted and merged, so a query only costs a binary
+ * search.
+ *
+ * The results use the same types as FreeBusyQueryJob, so callers can easily
+ * switch between local and remote queries.
+ *
+ * @since 6.9.0
+ */
+class KGAPICALENDAR_EXPORT FreeBusyIndex
+{
+public:
+    /**
+     * @brief Constructs an index for events occurring between
+     *        @p windowStart and @p windowEnd
+     */
+    explicit FreeBusyIndex(const QDateTime &windowStart, const QDateTime &windowEnd);
+    ~FreeBusyIndex();
+
+    [[nodiscard]] QDateTime windowStart() const;
+    [[nodiscard]] QDateTime windowEnd() const;
+
+    /**
+     * @brief Replaces events of calendar @p calendarId in the index
+     *
+     * @p events should contain all events of the calendar, including
+     * modified occurrences of recurring events.
+     */
+    void setEvents(const QString &calendarId, const EventsList &events);
+
+    /**
+     * @brief Removes calendar @p calendarId from the index
+     */
+    void removeCalendar(const QString &calendarId);
+
+    /**
+     * @brief Returns IDs of all calendars in the index
+     */
+    [[nodiscard]] QStringList calendars() const;
+
+    /**
+     * @brief Returns busy ranges of calendar @p calendarId between
+     *        @p timeMin and @p timeMax
+     *
+     * Ranges are clipped to the queried interval.
+     */
+    [[nodiscard]] FreeBusyQueryJob::BusyRangeList busy(const QString &calendarId, const QDateTime &timeMin, const QDateTime &timeMax) const;
+
+    /**
+     * @brief Returns busy ranges of each of the @p calendarIds between
+     *        @p timeMin and @p timeMax
+     *
+     * Calendars that are not in the index are not present in the result.
+     */
+    [[nodiscard]] FreeBusyQueryJob::BusyRangeMap busy(const QStringList &calendarIds, const QDateTime &timeMin, const QDateTime &timeMax) const;
+
+    /**
+     * @brief Returns ranges when at least one of the @p calendarIds is busy
+     */
+    [[nodiscard]] FreeBusyQueryJob::BusyRangeList mergedBusy(const QStringList &calendarIds, const QDateTime &timeMin, const QDateTime &timeMax) const;
+
+    /**
+     * @brief Returns whether calendar @p calendarId has no busy time between
+     *        @p timeMin and @p timeMax
+     */
+    [[nodiscard]] bool isFree(const QString &calendarId, const QDateTime &timeMin, const QDateTime &timeMax) const;
+
+    /**
+     * @brief Returns those of the @p calendarIds that have no busy time
+     *        between @p timeMin and @p timeMax
+     *
+     * Calendars that are not in the index are never considered free.
+     */
+    [[nodiscard]] QStringList freeCalendars(const QStringList &calendarIds, const QDateTime &timeMin, const QDateTime &timeMax) const;
+
+private:
+    Q_DISABLE_COPY(FreeBusyIndex)
+
+    class Private;
+    QScopedPointer<Private> const d;
+};
+
+} // namespace KGAPI2
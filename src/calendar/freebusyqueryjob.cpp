@@ -16,38 +16,109 @@
 
 using namespace KGAPI2;
 
+namespace
+{
+// Maximum number of calendars allowed in a single freeBusy query
+static constexpr int MaxCalendarsPerQuery = 50;
+}
+
 class Q_DECL_HIDDEN FreeBusyQueryJob::Private
 {
 public:
-    Private(const QString &id, const QDateTime &timeMin, const QDateTime &timeMax)
-        : id(id)
+    Private(const QStringList &ids, const QDateTime &timeMin, const QDateTime &timeMax, bool singleCalendar)
+        : ids(ids)
         , timeMin(timeMin)
         , timeMax(timeMax)
+        , singleCalendar(singleCalendar)
     {
     }
 
-    const QString id;
+    QByteArray buildQuery(const QStringList &calendarIds) const;
+    void parseCalendar(const QString &id, const QVariantMap &cal);
+
+    const QStringList ids;
     const QDateTime timeMin;
     const QDateTime timeMax;
-    FreeBusyQueryJob::BusyRangeList busy;
+    const bool singleCalendar;
+    FreeBusyQueryJob::BusyRangeMap busy;
+    QMap<QString, QString> errors;
 };
 
+QByteArray FreeBusyQueryJob::Private::buildQuery(const QStringList &calendarIds) const
+{
+    QVariantList items;
+    items.reserve(calendarIds.size());
+    for (const auto &id : calendarIds) {
+        items.push_back(QVariantMap({{QStringLiteral("id"), id}}));
+    }
+
+    QVariantMap requestData({{QStringLiteral("timeMin"), Utils::rfc3339DateToString(timeMin)},
+                             {QStringLiteral("timeMax"), Utils::rfc3339DateToString(timeMax)},
+                             {QStringLiteral("items"), items}});
+    QJsonDocument document = QJsonDocument::fromVariant(requestData);
+    return document.toJson(QJsonDocument::Compact);
+}
+
+void FreeBusyQueryJob::Private::parseCalendar(const QString &id, const QVariantMap &cal)
+{
+    if (cal.contains(QStringLiteral("errors"))) {
+        const QVariantList errorsList = cal[QStringLiteral("errors")].toList();
+        errors.insert(id, errorsList.isEmpty() ? QString() : errorsList.first().toMap().value(QStringLiteral("reason")).toString());
+        return;
+    }
+
+    BusyRangeList &ranges = busy[id];
+    const QVariantList busyList = cal[QStringLiteral("busy")].toList();
+    ranges.reserve(busyList.size());
+    for (const QVariant &busyV : busyList) {
+        const QVariantMap busyRange = busyV.toMap();
+        ranges << BusyRange{Utils::rfc3339DateFromString(busyRange[QStringLiteral("start")].toString()),
+                            Utils::rfc3339DateFromString(busyRange[QStringLiteral("end")].toString())};
+    }
+}
+
 FreeBusyQueryJob::FreeBusyQueryJob(const QString &id, const QDateTime &timeMin, const QDateTime &timeMax, const AccountPtr &account, QObject *parent)
     : FetchJob(account, parent)
-    , d(new FreeBusyQueryJob::Private(id, timeMin, timeMax))
+    , d(new FreeBusyQueryJob::Private({id}, timeMin, timeMax, true))
+{
+}
+
+FreeBusyQueryJob::FreeBusyQueryJob(const QStringList &ids, const QDateTime &timeMin, const QDateTime &timeMax, const AccountPtr &account, QObject *parent)
+    : FetchJob(account, parent)
+    , d(new FreeBusyQueryJob::Private(ids, timeMin, timeMax, false))
 {
 }
 
 FreeBusyQueryJob::~FreeBusyQueryJob() = default;
 
 FreeBusyQueryJob::BusyRangeList FreeBusyQueryJob::busy() const
+{
+    return d->busy.value(id());
+}
+
+FreeBusyQueryJob::BusyRangeList FreeBusyQueryJob::busy(const QString &id) const
+{
+    return d->busy.value(id);
+}
+
+FreeBusyQueryJob::BusyRangeMap FreeBusyQueryJob::busyMap() const
 {
     return d->busy;
 }
 
+QMap<QString, QString> FreeBusyQueryJob::calendarErrors() const
+{
+    return d->errors;
+}
+
 QString FreeBusyQueryJob::id() const
 {
-    return d->id;
+    return d->ids.value(0);
+}
+
+QStringList FreeBusyQueryJob::ids() const
+{
+    return d->ids;
 }
 
 QDateTime FreeBusyQueryJob::timeMin() const
@@ -62,14 +133,20 @@ QDateTime FreeBusyQueryJob::timeMax() const
 
 void FreeBusyQueryJob::start()
 {
-    QVariantMap requestData({{QStringLiteral("timeMin"), Utils::rfc3339DateToString(d->timeMin)},
-                             {QStringLiteral("timeMax"), Utils::rfc3339DateToString(d->timeMax)},
-                             {QStringLiteral("items"), QVariantList({QVariantMap({{QStringLiteral("id"), d->id}})})}});
-    QJsonDocument document = QJsonDocument::fromVariant(requestData);
-    const QByteArray json = document.toJson(QJsonDocument::Compact);
+    d->busy.clear();
+    d->errors.clear();
+
+    if (d->ids.isEmpty()) {
+        emitFinished();
+        return;
+    }
 
-    const auto request = CalendarService::prepareRequest(CalendarService::freeBusyQueryUrl());
-    enqueueRequest(request, json, QStringLiteral("application/json"));
+    // All chunks are enqueued at once and dispatched concurrently
+    for (qsizetype i = 0; i < d->ids.size(); i += MaxCalendarsPerQuery) {
+        const QByteArray json = d->buildQuery(d->ids.mid(i, MaxCalendarsPerQuery));
+        const auto request = CalendarService::prepareRequest(CalendarService::freeBusyQueryUrl());
+        enqueueRequest(request, json, QStringLiteral("application/json"));
+    }
 }
 
 void FreeBusyQueryJob::dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType)
@@ -86,26 +163,23 @@ void FreeBusyQueryJob::handleReply(const QNetworkReply *reply, const QByteArray
 {
     const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
     ContentType ct = Utils::stringToContentType(contentType);
-    if (ct == KGAPI2::JSON) {
-        const QJsonDocument document = QJsonDocument::fromJson(rawData);
-        const QVariantMap data = document.toVariant().toMap();
-        const QVariantMap cals = data[QStringLiteral("calendars")].toMap();
-        const QVariantMap cal = cals[d->id].toMap();
-        if (cal.contains(QStringLiteral("errors"))) {
-            setError(KGAPI2::NotFound);
-            setErrorString(tr("FreeBusy information is not available"));
-        } else {
-            const QVariantList busyList = cal[QStringLiteral("busy")].toList();
-            for (const QVariant &busyV : busyList) {
-                const QVariantMap busy = busyV.toMap();
-                d->busy << BusyRange{Utils::rfc3339DateFromString(busy[QStringLiteral("start")].toString()),
-                                     Utils::rfc3339DateFromString(busy[QStringLiteral("end")].toString())};
-            }
-        }
-    } else {
+    if (ct != KGAPI2::JSON) {
         setError(KGAPI2::InvalidResponse);
         setErrorString(tr("Invalid response content type"));
+        emitFinished();
+        return;
+    }
+
+    const QJsonDocument document = QJsonDocument::fromJson(rawData);
+    const QVariantMap data = document.toVariant().toMap();
+    const QVariantMap cals = data[QStringLiteral("calendars")].toMap();
+    for (auto it = cals.cbegin(), end = cals.cend(); it != end; ++it) {
+        d->parseCalendar(it.key(), it.value().toMap());
     }
 
-    emitFinished();
+    if (d->singleCalendar && d->errors.contains(d->ids.constFirst())) {
+        setError(KGAPI2::NotFound);
+        setErrorString(tr("FreeBusy information is not available"));
+    }
+    // The job finishes once replies for all enqueued queries are handled
 }
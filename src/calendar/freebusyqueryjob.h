@@ -11,11 +11,20 @@
 
 #include <QDateTime>
 #include <QList>
+#include <QMap>
 #include <QScopedPointer>
+#include <QStringList>
 
 namespace KGAPI2
 {
 
+/**
+ * @brief A job to query free/busy information of one or more calendars
+ *
+ * When querying multiple calendars, the calendar IDs are split into groups of
+ * up to 50 calendars (maximum allowed by the API for a single query) and the
+ * groups are queried concurrently.
+ */
 class KGAPICALENDAR_EXPORT FreeBusyQueryJob : public KGAPI2::FetchJob
 {
     Q_OBJECT
@@ -38,15 +47,74 @@ public:
     };
     using BusyRangeList = QList<BusyRange>;
 
+    /**
+     * @brief Busy ranges indexed by calendar ID
+     *
+     * @since 6.9.0
+     */
+    using BusyRangeMap = QMap<QString, BusyRangeList>;
+
     explicit FreeBusyQueryJob(const QString &id, const QDateTime &timeMin, const QDateTime &timeMax, const AccountPtr &account, QObject *parent = nullptr);
+
+    /**
+     * @brief Constructs a job that will query free/busy information of all
+     *        calendars with given @p ids
+     *
+     * Failure to retrieve information about some of the calendars does not
+     * fail the job, see calendarErrors().
+     *
+     * @since 6.9.0
+     */
+    explicit FreeBusyQueryJob(const QStringList &ids,
+                              const QDateTime &timeMin,
+                              const QDateTime &timeMax,
+                              const AccountPtr &account,
+                              QObject *parent = nullptr);
     ~FreeBusyQueryJob() override;
 
+    /**
+     * @brief Returns ID of the queried calendar, or of the first calendar when
+     *        querying multiple calendars.
+     */
     [[nodiscard]] QString id() const;
+
+    /**
+     * @brief Returns IDs of all queried calendars
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] QStringList ids() const;
     [[nodiscard]] QDateTime timeMin() const;
     [[nodiscard]] QDateTime timeMax() const;
 
+    /**
+     * @brief Returns busy ranges of the calendar returned by id()
+     */
     [[nodiscard]] BusyRangeList busy() const;
 
+    /**
+     * @brief Returns busy ranges of calendar with given @p id
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] BusyRangeList busy(const QString &id) const;
+
+    /**
+     * @brief Returns busy ranges of all calendars whose free/busy information
+     *        was retrieved successfully
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] BusyRangeMap busyMap() const;
+
+    /**
+     * @brief Returns reasons (as reported by Google, e.g. "notFound") for
+     *        calendars whose free/busy information could not be retrieved
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] QMap<QString, QString> calendarErrors() const;
+
 protected:
     void start() override;
     void dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType) override;
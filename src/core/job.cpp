@@ -88,6 +88,8 @@ Job::Private::Private(Job *parent)
     , accessManager(nullptr)
     , maxTimeout(0)
     , prettyPrint(false)
+    , maxConcurrentRequests(0)
+    , requestSerial(0)
     , q(parent)
 {
 }
@@ -111,26 +113,18 @@ void Job::Private::init()
 
 QString Job::Private::parseErrorMessage(const QByteArray &json)
 {
-    QJsonDocument document = QJsonDocument::fromJson(json);
-    if (!document.isNull()) {
-        QVariantMap map = document.toVariant().toMap();
-        QString message;
-
-        if (map.contains(QStringLiteral("error"))) {
-            map = map.value(QStringLiteral("error")).toMap();
-        }
-
-        if (map.contains(QStringLiteral("message"))) {
-            message.append(map.value(QStringLiteral("message")).toString());
-        } else {
-            message = QLatin1StringView(json);
-        }
-
-        return message;
+    return Utils::parseErrorMessage(json);
+}
 
-    } else {
-        return QLatin1StringView(json);
+Request Job::Private::takePendingRequest(const QNetworkReply *reply)
+{
+    const QVariant serial = reply->request().attribute(RequestSerialAttribute);
+    if (!serial.isValid()) {
+        // Reply to a request that did not carry the serial, assume replies arrive in order
+        return pendingRequests.isEmpty() ? Request() : pendingRequests.take(pendingRequests.firstKey());
     }
+
+    return pendingRequests.take(serial.toULongLong());
 }
 
 void Job::Private::_k_doStart()
@@ -148,6 +142,15 @@ void Job::Private::_k_doEmitFinished()
 void Job::Private::_k_replyReceived(QNetworkReply *reply)
 {
     reply->deleteLater();
+
+    const QVariant serial = reply->request().attribute(RequestSerialAttribute);
+    if (!q->isRunning() || (serial.isValid() && !pendingRequests.contains(serial.toULongLong()))) {
+        // Reply to a request of a job that has already finished (or was restarted)
+        qCDebug(KGAPIDebug) << "Ignoring stale reply from" << reply->url();
+        return;
+    }
+    currentRequest = takePendingRequest(reply);
+
     int replyCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
     if (replyCode == 0) {
         /* Workaround for a bug (??), when QNetworkReply does not report HTTP/1.1 401 Unauthorized
@@ -171,6 +174,7 @@ void Job::Private::_k_replyReceived(QNetworkReply *reply)
     case KGAPI2::OK: /** << OK status (fetched, updated, removed) */
     case KGAPI2::Created: /** << OK status (created) */
     case KGAPI2::NoContent: /** << OK status (removed task using Tasks API) */
+    case KGAPI2::PartialContent: /** << OK status (fetched a byte range of a file) */
     case KGAPI2::ResumeIncomplete: /** << OK status (partially uploaded a file via resumable upload) */
         q->handleReply(reply, rawData);
         break;
@@ -206,6 +210,12 @@ void Job::Private::_k_replyReceived(QNetworkReply *reply)
         break;
 
     case KGAPI2::Forbidden:
+        // Rate limits are reported as 403, unlike other errors they are only temporary
+        if (Utils::isRateLimitError(rawData)) {
+            qCWarning(KGAPIDebug) << "Rate limit exceeded.";
+            retryLater(rawData);
+            return;
+        }
         if (!q->handleError(replyCode, rawData)) {
             qCWarning(KGAPIDebug) << "Requested resource is forbidden.";
             const QString msg = parseErrorMessage(rawData);
@@ -249,6 +259,17 @@ void Job::Private::_k_replyReceived(QNetworkReply *reply)
         }
         break;
 
+    case KGAPI2::PreconditionFailed:
+        if (!q->handleError(replyCode, rawData)) {
+            qCWarning(KGAPIDebug) << "Precondition failed. Remote resource has been modified.";
+            const QString msg = parseErrorMessage(rawData);
+            q->setError(KGAPI2::PreconditionFailed);
+            q->setErrorString(tr("Remote resource has been modified since it was fetched.\n\nGoogle replied '%1'").arg(msg));
+            q->emitFinished();
+            return;
+        }
+        break;
+
     case KGAPI2::InternalError:
         if (!q->handleError(replyCode, rawData)) {
             qCWarning(KGAPIDebug) << "Internal server error.";
@@ -263,30 +284,7 @@ void Job::Private::_k_replyReceived(QNetworkReply *reply)
     case KGAPI2::QuotaExceeded: {
         if (!q->handleError(replyCode, rawData)) {
             qCWarning(KGAPIDebug) << "User quota exceeded.";
-
-            // Extend the interval (if possible) and enqueue the request again
-            int interval = dispatchTimer->interval() / 1000;
-            if (interval == 0) {
-                interval = 1;
-            } else if (interval == 1) {
-                interval = 2;
-            } else if ((interval > maxTimeout) && (maxTimeout > 0)) {
-                const QString msg = parseErrorMessage(rawData);
-                q->setError(KGAPI2::QuotaExceeded);
-                q->setErrorString(tr("Maximum quota exceeded. Try again later.\n\nGoogle replied '%1'").arg(msg));
-                q->emitFinished();
-                return;
-            } else {
-                interval = interval ^ 2;
-            }
-            qCDebug(KGAPIDebug) << "Increasing dispatch interval to" << interval * 1000 << "msecs";
-            dispatchTimer->setInterval(interval * 1000);
-
-            const QNetworkRequest request = reply->request();
-            q->enqueueRequest(request);
-            if (!dispatchTimer->isActive()) {
-                dispatchTimer->start();
-            }
+            retryLater(rawData);
             return;
         }
         break;
@@ -309,12 +307,40 @@ void Job::Private::_k_replyReceived(QNetworkReply *reply)
         return;
     }
 
-    qCDebug(KGAPIDebug) << requestQueue.length() << "requests in requestQueue.";
+    qCDebug(KGAPIDebug) << requestQueue.length() << "requests in requestQueue," << pendingRequests.size() << "requests waiting for reply.";
     if (requestQueue.isEmpty()) {
+        if (pendingRequests.isEmpty()) {
+            q->emitFinished();
+        }
+        return;
+    }
+
+    if (!dispatchTimer->isActive()) {
+        dispatchTimer->start();
+    }
+}
+
+void Job::Private::retryLater(const QByteArray &rawData)
+{
+    // Extend the interval (if possible) and enqueue the request again
+    int interval = dispatchTimer->interval() / 1000;
+    if (interval == 0) {
+        interval = 1;
+    } else if (interval == 1) {
+        interval = 2;
+    } else if ((interval > maxTimeout) && (maxTimeout > 0)) {
+        const QString msg = parseErrorMessage(rawData);
+        q->setError(KGAPI2::QuotaExceeded);
+        q->setErrorString(tr("Maximum quota exceeded. Try again later.\n\nGoogle replied '%1'").arg(msg));
         q->emitFinished();
         return;
+    } else {
+        interval = interval ^ 2;
     }
+    qCDebug(KGAPIDebug) << "Increasing dispatch interval to" << interval * 1000 << "msecs";
+    dispatchTimer->setInterval(interval * 1000);
 
+    q->enqueueRequest(currentRequest.request, currentRequest.rawData, currentRequest.contentType);
     if (!dispatchTimer->isActive()) {
         dispatchTimer->start();
     }
@@ -327,10 +353,18 @@ void Job::Private::_k_dispatchTimeout()
         return;
     }
 
+    if (maxConcurrentRequests > 0 && pendingRequests.size() >= maxConcurrentRequests) {
+        // Dispatching resumes when a reply is received
+        dispatchTimer->stop();
+        return;
+    }
+
     const Request r = requestQueue.dequeue();
-    currentRequest = r;
+    const quint64 serial = ++requestSerial;
+    pendingRequests.insert(serial, r);
 
     QNetworkRequest authorizedRequest = r.request;
+    authorizedRequest.setAttribute(RequestSerialAttribute, serial);
     if (account) {
         authorizedRequest.setRawHeader("Authorization", "Bearer " + account->accessToken().toLatin1());
     }
@@ -338,6 +372,8 @@ void Job::Private::_k_dispatchTimeout()
     QUrl url = authorizedRequest.url();
     QUrlQuery standardParamQuery(url);
     if (!fields.isEmpty()) {
+        // URLs of follow-up pages are derived from the previous request and may already carry the selector
+        standardParamQuery.removeAllQueryItems(Job::StandardParams::Fields);
         standardParamQuery.addQueryItem(Job::StandardParams::Fields, fields.join(QLatin1Char(',')));
     }
 
@@ -474,6 +510,21 @@ void Job::setFields(const QStringList &fields)
     d->fields = fields;
 }
 
+int Job::maxConcurrentRequests() const
+{
+    return d->maxConcurrentRequests;
+}
+
+void Job::setMaxConcurrentRequests(int maxConcurrentRequests)
+{
+    if (d->isRunning) {
+        qCWarning(KGAPIDebug) << "Called setMaxConcurrentRequests() on running job. Ignoring.";
+        return;
+    }
+
+    d->maxConcurrentRequests = maxConcurrentRequests;
+}
+
 QString Job::buildSubfields(const QString &field, const QStringList &fields)
 {
     return QStringLiteral("%1(%2)").arg(field, fields.join(QLatin1Char(',')));
@@ -498,6 +549,7 @@ void Job::emitFinished()
     d->isRunning = false;
     d->dispatchTimer->stop();
     d->requestQueue.clear();
+    d->pendingRequests.clear();
 
     // Emit in next event loop iteration so that the method caller can finish
     // before user is notified
@@ -544,9 +596,15 @@ void Job::aboutToStart()
     d->currentRequest.contentType.clear();
     d->currentRequest.rawData.clear();
     d->currentRequest.request = QNetworkRequest();
+    d->pendingRequests.clear();
     d->dispatchTimer->setInterval(0);
 }
 
+QNetworkRequest Job::currentRequest() const
+{
+    return d->currentRequest.request;
+}
+
 bool Job::handleError(int errorCode, const QByteArray &rawData)
 {
     Q_UNUSED(errorCode)
@@ -65,6 +65,22 @@ class KGAPICORE_EXPORT Job : public QObject
      * @see Job::isRunning, Job::finished
      */
     Q_PROPERTY(bool isRunning READ isRunning NOTIFY finished)
+
+    /**
+     * @brief Maximum number of requests waiting for a reply at the same time
+     *
+     * Jobs that enqueue more than one request at a time (for example when
+     * processing many objects at once) dispatch the requests concurrently.
+     * This property limits how many of them can be in flight at the same time,
+     * the remaining requests are dispatched as replies arrive.
+     *
+     * By default the value is @p 0, which means no limit. Jobs that send their
+     * requests one after another are not affected by this property.
+     *
+     * @see Job::maxConcurrentRequests, Job::setMaxConcurrentRequests
+     * @since 6.9.0
+     */
+    Q_PROPERTY(int maxConcurrentRequests READ maxConcurrentRequests WRITE setMaxConcurrentRequests)
 public:
     /**
      * @brief Constructor for jobs that don't require authentication
@@ -205,6 +221,25 @@ public:
      */
     QStringList fields() const;
 
+    /**
+     * @brief Set maximum number of requests waiting for a reply at the same time
+     *
+     * This property can be modified only when the job is not running.
+     *
+     * @param maxConcurrentRequests Maximum number of requests in flight, or @p 0 for no limit
+     * @since 6.9.0
+     */
+    void setMaxConcurrentRequests(int maxConcurrentRequests);
+
+    /**
+     * @brief Returns maximum number of requests waiting for a reply at the same time
+     *
+     * @return Returns maximum number of requests in flight, or @p 0 if there is no limit.
+     * @see Job::setMaxConcurrentRequests
+     * @since 6.9.0
+     */
+    int maxConcurrentRequests() const;
+
     /**
      * @brief Restarts this job
      *
@@ -348,6 +383,18 @@ protected:
      */
     virtual bool handleError(int statusCode, const QByteArray &rawData);
 
+    /**
+     * @brief Returns the request whose reply is being handled
+     *
+     * When a job has multiple requests in flight, this allows Job::handleReply
+     * and Job::handleError implementations to tell which of the enqueued
+     * requests the reply belongs to. The returned request is the one that was
+     * passed to Job::enqueueRequest.
+     *
+     * @since 6.9.0
+     */
+    QNetworkRequest currentRequest() const;
+
     /**
      * @brief Enqueues @p request in dispatcher queue
      *
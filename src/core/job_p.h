@@ -10,6 +10,7 @@
 
 #include "job.h"
 
+#include <QMap>
 #include <QNetworkReply>
 #include <QQueue>
 #include <QScopedPointer>
@@ -50,6 +51,8 @@ public:
     void init();
 
     QString parseErrorMessage(const QByteArray &json);
+    Request takePendingRequest(const QNetworkReply *reply);
+    void retryLater(const QByteArray &rawData);
 
     void _k_doStart();
     void _k_doEmitFinished();
@@ -68,9 +71,16 @@ public:
     int maxTimeout;
     bool prettyPrint;
     QStringList fields;
+    int maxConcurrentRequests;
 
+    // Requests that were dispatched and are waiting for a reply, indexed by
+    // a serial number stored in the RequestSerialAttribute of the request
+    QMap<quint64, Request> pendingRequests;
+    quint64 requestSerial;
     Request currentRequest;
 
+    static constexpr auto RequestSerialAttribute = static_cast<QNetworkRequest::Attribute>(QNetworkRequest::UserMax - 1);
+
 private:
     Job *const q;
 };
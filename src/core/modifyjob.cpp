@@ -9,6 +9,7 @@
 #include "modifyjob.h"
 #include "debug.h"
 #include "object.h"
+#include "utils.h"
 
 #include <QBuffer>
 #include <QNetworkAccessManager>
@@ -16,6 +17,11 @@
 
 using namespace KGAPI2;
 
+namespace
+{
+static constexpr auto PatchRequestAttribute = static_cast<QNetworkRequest::Attribute>(QNetworkRequest::UserMax - 2);
+}
+
 class Q_DECL_HIDDEN ModifyJob::Private
 {
 public:
@@ -45,6 +51,20 @@ ObjectsList ModifyJob::items() const
     return d->items;
 }
 
+void ModifyJob::enqueuePatchRequest(const QNetworkRequest &request, const QByteArray &original, const QByteArray &modified, const QString &etag)
+{
+    QNetworkRequest r = request;
+    r.setAttribute(PatchRequestAttribute, true);
+    if (!etag.isEmpty()) {
+        r.setRawHeader("If-Match", etag.toUtf8());
+    }
+
+    const QByteArray patch = Utils::createMergePatch(original, modified);
+    qCDebug(KGAPIDebug) << "Sending patch of" << patch.size() << "bytes instead of" << modified.size() << "bytes";
+
+    enqueueRequest(r, patch, QStringLiteral("application/json"));
+}
+
 void ModifyJob::dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType)
 {
     QNetworkRequest r = request;
@@ -56,6 +76,8 @@ void ModifyJob::dispatchRequest(QNetworkAccessManager *accessManager, const QNet
         r.setRawHeader("If-Match", "*");
     }
 
+    const QByteArray verb = r.attribute(PatchRequestAttribute).toBool() ? QByteArrayLiteral("PATCH") : QByteArrayLiteral("PUT");
+
     // Note: there is a problem with PUT when using QNAM - it
     // doesn't transfer the body correctly.
     // Using sendCustomRequest() works just fine.
@@ -66,9 +88,9 @@ void ModifyJob::dispatchRequest(QNetworkAccessManager *accessManager, const QNet
         d->buffer.close();
         d->buffer.setData(data);
         d->buffer.open(QIODevice::ReadOnly);
-        accessManager->sendCustomRequest(r, "PUT", &d->buffer);
+        accessManager->sendCustomRequest(r, verb, &d->buffer);
     } else {
-        accessManager->sendCustomRequest(r, "PUT");
+        accessManager->sendCustomRequest(r, verb);
     }
 }
 
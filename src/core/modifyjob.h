@@ -72,6 +72,23 @@ protected:
      */
     virtual ObjectsList handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData);
 
+    /**
+     * @brief Enqueues a partial update of an object
+     *
+     * Instead of the full @p modified representation only an RFC 7396 merge
+     * patch of the fields that differ from @p original is sent as a PATCH
+     * request. When @p etag is not empty it is sent in the If-Match header so
+     * that the update fails with KGAPI2::PreconditionFailed if the object has
+     * been changed remotely since @p original was fetched.
+     *
+     * @param request Request with the URL of the object to update
+     * @param original JSON representation of the last fetched object
+     * @param modified JSON representation of the modified object
+     * @param etag ETag of the last fetched object
+     * @since 6.9.0
+     */
+    void enqueuePatchRequest(const QNetworkRequest &request, const QByteArray &original, const QByteArray &modified, const QString &etag);
+
     /**
      * KGAPI2::Job::dispatchRequest implementation
      *
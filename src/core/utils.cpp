@@ -9,6 +9,37 @@
 #include "utils.h"
 
 #include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace
+{
+QJsonObject mergePatch(const QJsonObject &original, const QJsonObject &modified)
+{
+    QJsonObject patch;
+    for (auto it = original.constBegin(), end = original.constEnd(); it != end; ++it) {
+        if (!modified.contains(it.key())) {
+            patch.insert(it.key(), QJsonValue::Null);
+        }
+    }
+
+    for (auto it = modified.constBegin(), end = modified.constEnd(); it != end; ++it) {
+        const QJsonValue oldValue = original.value(it.key());
+        const QJsonValue newValue = it.value();
+        if (oldValue == newValue) {
+            continue;
+        }
+        if (oldValue.isObject() && newValue.isObject()) {
+            patch.insert(it.key(), mergePatch(oldValue.toObject(), newValue.toObject()));
+        } else {
+            patch.insert(it.key(), newValue);
+        }
+    }
+
+    return patch;
+}
+}
 
 KGAPI2::ContentType Utils::stringToContentType(const QString &contentType)
 {
@@ -41,3 +72,34 @@ QString Utils::rfc3339DateToString(const QDateTime &dt)
 {
     return dt.toUTC().toString(Qt::ISODate);
 }
+
+QByteArray Utils::createMergePatch(const QByteArray &original, const QByteArray &modified)
+{
+    const QJsonObject originalObject = QJsonDocument::fromJson(original).object();
+    const QJsonObject modifiedObject = QJsonDocument::fromJson(modified).object();
+
+    return QJsonDocument(mergePatch(originalObject, modifiedObject)).toJson(QJsonDocument::Compact);
+}
+
+QString Utils::parseErrorMessage(const QByteArray &json)
+{
+    QJsonObject error = QJsonDocument::fromJson(json).object();
+    if (error.value(QStringLiteral("error")).isObject()) {
+        error = error.value(QStringLiteral("error")).toObject();
+    }
+    const QString message = error.value(QStringLiteral("message")).toString();
+    return message.isEmpty() ? QString::fromUtf8(json) : message;
+}
+
+bool Utils::isRateLimitError(const QByteArray &json)
+{
+    const QJsonObject error = QJsonDocument::fromJson(json).object().value(QStringLiteral("error")).toObject();
+    const QJsonArray errors = error.value(QStringLiteral("errors")).toArray();
+    for (const QJsonValue &item : errors) {
+        const QString reason = item.toObject().value(QStringLiteral("reason")).toString();
+        if (reason == QLatin1StringView("rateLimitExceeded") || reason == QLatin1StringView("userRateLimitExceeded")) {
+            return true;
+        }
+    }
+    return false;
+}
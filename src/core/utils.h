@@ -50,6 +50,37 @@ KGAPICORE_EXPORT QDateTime rfc3339DateFromString(const QString &string);
  */
 KGAPICORE_EXPORT QString rfc3339DateToString(const QDateTime &dt);
 
+/**
+ * @brief Creates an RFC 7396 JSON merge patch transforming @p original into @p modified
+ *
+ * Objects are compared recursively, any other changed value (including arrays)
+ * is replaced as a whole and keys missing in @p modified are set to null.
+ *
+ * @return Compact JSON document with only the changed fields, "{}" when
+ *         both documents are equal.
+ * @since 6.9.0
+ */
+KGAPICORE_EXPORT QByteArray createMergePatch(const QByteArray &original, const QByteArray &modified);
+
+/**
+ * @brief Returns the message of Google API error reply @p json
+ *
+ * Falls back to the whole reply when it carries no message.
+ *
+ * @since 6.9.0
+ */
+KGAPICORE_EXPORT QString parseErrorMessage(const QByteArray &json);
+
+/**
+ * @brief Returns whether error reply @p json reports an exceeded rate limit
+ *
+ * Google reports rate limits as 403 Forbidden with reason "rateLimitExceeded"
+ * or "userRateLimitExceeded". Such requests should be sent again later.
+ *
+ * @since 6.9.0
+ */
+KGAPICORE_EXPORT bool isRateLimitError(const QByteArray &json);
+
 template<typename Value, template<typename> class Container>
 bool compareSharedPtrContainers(const Container<QSharedPointer<Value>> &left, const Container<QSharedPointer<Value>> &right)
 {
@@ -0,0 +1,181 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "bandwidthlimiter.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QPointer>
+
+#include <cmath>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+// Waking up for every few bytes would be a waste, wait until at least this much can be sent
+static constexpr qint64 MinimumGrant = 16 * 1024;
+
+class Bucket
+{
+public:
+    [[nodiscard]] bool isLimited() const
+    {
+        return mRate > 0;
+    }
+
+    [[nodiscard]] qint64 rate() const
+    {
+        return mRate;
+    }
+
+    void setRate(qint64 rate)
+    {
+        mRate = qMax<qint64>(0, rate);
+        mTokens = static_cast<double>(mRate);
+        mClock.start();
+    }
+
+    // Can be negative after interactive transfers, down to -rate
+    [[nodiscard]] double tokens() const
+    {
+        const double refilled = mTokens + static_cast<double>(mRate) * static_cast<double>(mClock.elapsed()) / 1000.0;
+        // Up to one second worth of data can be sent at once
+        return qMin(refilled, static_cast<double>(mRate));
+    }
+
+    void consume(qint64 bytes)
+    {
+        // Cap the debt of interactive transfers, background ones would
+        // otherwise starve for as long as the burst exceeded the limit
+        mTokens = qMax(tokens() - static_cast<double>(bytes), -static_cast<double>(mRate));
+        mClock.restart();
+    }
+
+    [[nodiscard]] int msecsUntil(double tokens) const
+    {
+        const double missing = tokens - this->tokens();
+        return missing <= 0 ? 0 : static_cast<int>(std::ceil(missing * 1000.0 / static_cast<double>(mRate)));
+    }
+
+private:
+    qint64 mRate = 0;
+    double mTokens = 0;
+    QElapsedTimer mClock;
+};
+}
+
+class Q_DECL_HIDDEN BandwidthLimiter::Private
+{
+public:
+    Bucket *accountBucket(const QString &accountName, Direction direction);
+    const Bucket *accountBucket(const QString &accountName, Direction direction) const;
+
+    Bucket global[2];
+    QHash<QString /* account name */, Bucket> accounts[2];
+};
+
+Bucket *BandwidthLimiter::Private::accountBucket(const QString &accountName, Direction direction)
+{
+    auto it = accounts[direction].find(accountName);
+    return it != accounts[direction].end() && it->isLimited() ? &(*it) : nullptr;
+}
+
+const Bucket *BandwidthLimiter::Private::accountBucket(const QString &accountName, Direction direction) const
+{
+    auto it = accounts[direction].constFind(accountName);
+    return it != accounts[direction].cend() && it->isLimited() ? &(*it) : nullptr;
+}
+
+BandwidthLimiter::BandwidthLimiter(QObject *parent)
+    : QObject(parent)
+    , d(new Private)
+{
+}
+
+BandwidthLimiter::~BandwidthLimiter() = default;
+
+BandwidthLimiter *BandwidthLimiter::instance()
+{
+    static QPointer<BandwidthLimiter> limiter;
+    if (!limiter) {
+        limiter = new BandwidthLimiter(QCoreApplication::instance());
+    }
+    return limiter;
+}
+
+qint64 BandwidthLimiter::rate(Direction direction) const
+{
+    return d->global[direction].rate();
+}
+
+void BandwidthLimiter::setRate(Direction direction, qint64 bytesPerSecond)
+{
+    d->global[direction].setRate(bytesPerSecond);
+}
+
+qint64 BandwidthLimiter::accountRate(const QString &accountName, Direction direction) const
+{
+    const Bucket *bucket = d->accountBucket(accountName, direction);
+    return bucket ? bucket->rate() : 0;
+}
+
+void BandwidthLimiter::setAccountRate(const QString &accountName, Direction direction, qint64 bytesPerSecond)
+{
+    if (bytesPerSecond <= 0) {
+        d->accounts[direction].remove(accountName);
+        return;
+    }
+
+    d->accounts[direction][accountName].setRate(bytesPerSecond);
+}
+
+bool BandwidthLimiter::isLimited(const QString &accountName, Direction direction) const
+{
+    return d->global[direction].isLimited() || d->accountBucket(accountName, direction);
+}
+
+qint64 BandwidthLimiter::acquire(const QString &accountName, Direction direction, Priority priority, qint64 maxBytes)
+{
+    Bucket *buckets[] = {&d->global[direction], d->accountBucket(accountName, direction)};
+
+    qint64 granted = maxBytes;
+    if (priority == Background) {
+        for (const Bucket *bucket : buckets) {
+            if (bucket && bucket->isLimited()) {
+                granted = qMin(granted, qMax<qint64>(0, static_cast<qint64>(bucket->tokens())));
+            }
+        }
+    }
+
+    if (granted > 0) {
+        for (Bucket *bucket : buckets) {
+            if (bucket && bucket->isLimited()) {
+                bucket->consume(granted);
+            }
+        }
+    }
+    return granted;
+}
+
+int BandwidthLimiter::msecsUntilAvailable(const QString &accountName, Direction direction) const
+{
+    const Bucket *buckets[] = {&d->global[direction], d->accountBucket(accountName, direction)};
+
+    int msecs = 0;
+    for (const Bucket *bucket : buckets) {
+        if (bucket && bucket->isLimited()) {
+            msecs = qMax(msecs, bucket->msecsUntil(static_cast<double>(qMin(MinimumGrant, bucket->rate()))));
+        }
+    }
+    return msecs;
+}
+
+#include "moc_bandwidthlimiter.cpp"
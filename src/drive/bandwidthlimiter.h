@@ -0,0 +1,110 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "kgapidrive_export.h"
+
+#include <QObject>
+#include <QScopedPointer>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @brief Limits the bandwidth used by file uploads and downloads
+ *
+ * Rates can be limited globally and for each account, separately for
+ * uploads and downloads. A transfer has to fit into both the global and its
+ * account's limit. Each limit is a token bucket, so a transfer that was idle
+ * can send up to one second worth of data at once.
+ *
+ * The limits apply to the content streamed by FileFetchContentJob and by the
+ * upload jobs based on FileAbstractUploadJob and FileAbstractResumableJob.
+ * Transfers with Interactive priority are never delayed, but the data they
+ * transfer counts towards the limits, so background transfers give way to
+ * them. Background transfers are paused for at most about two seconds after
+ * an interactive burst, however big it was.
+ *
+ * By default nothing is limited.
+ *
+ * @since 6.9.0
+ */
+class KGAPIDRIVE_EXPORT BandwidthLimiter : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Direction {
+        Upload,
+        Download,
+    };
+    Q_ENUM(Direction)
+
+    enum Priority {
+        Background, ///< Transfer is delayed to stay within the limits
+        Interactive, ///< Transfer is never delayed, for transfers the user waits for
+    };
+    Q_ENUM(Priority)
+
+    explicit BandwidthLimiter(QObject *parent = nullptr);
+    ~BandwidthLimiter() override;
+
+    /**
+     * @brief Returns the limiter used by all transfer jobs
+     */
+    [[nodiscard]] static BandwidthLimiter *instance();
+
+    /**
+     * @brief Maximum rate of all transfers in @p direction, in bytes per second
+     *
+     * 0, the default, means unlimited.
+     */
+    [[nodiscard]] qint64 rate(Direction direction) const;
+    void setRate(Direction direction, qint64 bytesPerSecond);
+
+    /**
+     * @brief Maximum rate of transfers of account @p accountName in @p direction
+     *
+     * 0, the default, means unlimited.
+     */
+    [[nodiscard]] qint64 accountRate(const QString &accountName, Direction direction) const;
+    void setAccountRate(const QString &accountName, Direction direction, qint64 bytesPerSecond);
+
+    /**
+     * @brief Returns whether transfers of @p accountName in @p direction are limited at all
+     */
+    [[nodiscard]] bool isLimited(const QString &accountName, Direction direction) const;
+
+    /**
+     * @brief Asks for permission to transfer up to @p maxBytes
+     *
+     * Returns the number of bytes that may be transferred right now, which
+     * may be 0, and counts them towards the limits. Interactive transfers
+     * always get @p maxBytes.
+     */
+    qint64 acquire(const QString &accountName, Direction direction, Priority priority, qint64 maxBytes);
+
+    /**
+     * @brief Returns how long a background transfer has to wait before acquire()
+     * grants a reasonable amount of data, in milliseconds
+     */
+    [[nodiscard]] int msecsUntilAvailable(const QString &accountName, Direction direction) const;
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
@@ -12,6 +12,8 @@
 #include "driveservice.h"
 #include "utils.h"
 
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QUrlQuery>
@@ -33,6 +35,8 @@ public:
     bool includeItemsFromAllDrives = true;
     bool supportsAllDrives = true;
 
+    qlonglong largestChangeId = 0;
+
 private:
     ChangeFetchJob *const q;
 };
@@ -139,8 +143,15 @@ void ChangeFetchJob::setSupportsAllDrives(bool supportsAllDrives)
     d->supportsAllDrives = supportsAllDrives;
 }
 
+qlonglong ChangeFetchJob::largestChangeId() const
+{
+    return d->largestChangeId;
+}
+
 void ChangeFetchJob::start()
 {
+    d->largestChangeId = 0;
+
     QUrl url;
     if (d->changeId.isEmpty()) {
         url = DriveService::fetchChangesUrl();
@@ -179,6 +190,9 @@ ObjectsList ChangeFetchJob::handleReplyWithItems(const QNetworkReply *reply, con
     if (ct == KGAPI2::JSON) {
         if (d->changeId.isEmpty()) {
             items << Change::fromJSONFeed(rawData, feedData);
+            // int64 values are encoded as strings in the feed
+            const QJsonObject feed = QJsonDocument::fromJson(rawData).object();
+            d->largestChangeId = qMax(d->largestChangeId, feed.value(QLatin1StringView("largestChangeId")).toVariant().toLongLong());
         } else {
             items << Change::fromJSON(rawData);
         }
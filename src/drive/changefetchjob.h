@@ -80,6 +80,16 @@ public:
     [[nodiscard]] qlonglong startChangeId() const;
     void setStartChangeId(qlonglong startChangeId);
 
+    /**
+     * @brief Returns the largest change ID reported by the server
+     *
+     * Available once the job has finished. Listing changes from this ID + 1
+     * in the next run returns only changes that happened in the meantime.
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] qlonglong largestChangeId() const;
+
     /**
      * @brief Whether both My Drive and shared drive items should be included in results.
      *
@@ -0,0 +1,39 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "chunksizing_p.h"
+
+using namespace KGAPI2::Drive;
+
+namespace
+{
+// A chunk should take at least this many round-trips to upload
+static constexpr int ChunkRoundTrips = 10;
+static constexpr qint64 MinimumChunkDuration = 1000; // msecs
+}
+
+qint64 ChunkSizing::roundToGranularity(qint64 size)
+{
+    return qMax(Granularity, (size + Granularity - 1) / Granularity * Granularity);
+}
+
+qint64 ChunkSizing::adapt(qint64 chunkSize, qint64 maximumChunkSize, qint64 bytes, qint64 elapsed, qint64 roundTripTime)
+{
+    if (bytes < chunkSize || elapsed <= 0) {
+        return chunkSize;
+    }
+
+    // Size the next chunk so that the per-request round-trip is only a small
+    // fraction of the time spent transferring data
+    const qint64 targetDuration = qMax(MinimumChunkDuration, roundTripTime * ChunkRoundTrips);
+    const qint64 throughput = bytes * 1000 / elapsed; // bytes per second
+    const qint64 target = throughput * targetDuration / 1000;
+
+    // Grow at most 4 times per chunk so a single fast chunk does not overshoot
+    return qBound(Granularity, qMin(roundToGranularity(target), chunkSize * 4), maximumChunkSize);
+}
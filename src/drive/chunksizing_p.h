@@ -0,0 +1,54 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "kgapidrive_export.h"
+
+#include <QtGlobal>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @internal
+ *
+ * Chunk sizing of resumable uploads, kept apart from the job so that it can
+ * be tested with fixed measurements.
+ */
+// Export for use in unit-tests, header not installed though
+class KGAPIDRIVE_EXPORT ChunkSizing
+{
+public:
+    /// Google requires all but the last chunk to be a multiple of 256 KiB
+    static constexpr qint64 Granularity = 256 * 1024;
+
+    /**
+     * Returns @p size rounded up to a multiple of Granularity, at least Granularity
+     */
+    static qint64 roundToGranularity(qint64 size);
+
+    /**
+     * Returns the size of the chunk following a chunk of @p chunkSize bytes
+     *
+     * @param bytes Bytes of the chunk the server has persisted
+     * @param elapsed Time spent transferring them, without the round-trip, in msecs
+     * @param roundTripTime Measured round-trip time of a request without body, in msecs
+     *
+     * The size only changes when the whole chunk was persisted and @p elapsed
+     * is positive. It is kept between Granularity and @p maximumChunkSize.
+     */
+    static qint64 adapt(qint64 chunkSize, qint64 maximumChunkSize, qint64 bytes, qint64 elapsed, qint64 roundTripTime);
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
@@ -0,0 +1,377 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "drivemirror.h"
+#include "about.h"
+#include "aboutfetchjob.h"
+#include "account.h"
+#include "change.h"
+#include "changefetchjob.h"
+#include "debug.h"
+#include "file.h"
+#include "filefetchjob.h"
+#include "parentreference.h"
+#include "storedfile_p.h"
+
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSet>
+#include <QTimer>
+
+#include <utility>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+class Q_DECL_HIDDEN DriveMirror::Private
+{
+public:
+    Private(DriveMirror *parent);
+
+    void fetchAbout();
+    void fetchFiles(qlonglong changeId, const QString &rootId);
+    void fetchChanges();
+    bool checkJob(Job *job);
+    void finish();
+
+    void insert(const FilePtr &file);
+    bool remove(const QString &fileId);
+
+    void load();
+    bool save();
+
+    AccountPtr account;
+    QString storePath;
+    QTimer pollTimer;
+    bool synchronizing = false;
+
+    qlonglong largestChangeId = 0;
+    QString rootFolderId;
+    QHash<QString /* file ID */, FilePtr> files;
+    QHash<QString /* folder ID */, QSet<QString> /* file IDs */> children;
+
+private:
+    DriveMirror *const q;
+};
+
+DriveMirror::Private::Private(DriveMirror *parent)
+    : q(parent)
+{
+}
+
+void DriveMirror::Private::fetchAbout()
+{
+    // Remember the change ID before listing the files, changes done during the
+    // listing are then applied again by the next synchronization
+    auto job = new AboutFetchJob(account, q);
+    connect(job, &Job::finished, q, [this, job]() {
+        job->deleteLater();
+        if (!checkJob(job)) {
+            return;
+        }
+
+        const AboutPtr about = job->aboutData();
+        fetchFiles(about->largestChangeId(), about->rootFolderId());
+    });
+}
+
+void DriveMirror::Private::fetchFiles(qlonglong changeId, const QString &rootId)
+{
+    qCDebug(KGAPIDebug) << "Listing all files for Drive mirror";
+    auto job = new FileFetchJob(account, q);
+    connect(job, &Job::finished, q, [this, job, changeId, rootId]() {
+        job->deleteLater();
+        if (!checkJob(job)) {
+            return;
+        }
+
+        files.clear();
+        children.clear();
+        rootFolderId = rootId;
+        largestChangeId = changeId;
+
+        const auto items = job->items();
+        for (const ObjectPtr &item : items) {
+            const FilePtr file = item.dynamicCast<File>();
+            if (file && !(file->labels() && file->labels()->trashed())) {
+                insert(file);
+            }
+        }
+
+        finish();
+    });
+}
+
+void DriveMirror::Private::fetchChanges()
+{
+    auto job = new ChangeFetchJob(account, q);
+    job->setStartChangeId(largestChangeId + 1);
+    connect(job, &Job::finished, q, [this, job]() {
+        job->deleteLater();
+        if (!checkJob(job)) {
+            return;
+        }
+
+        const auto items = job->items();
+        qCDebug(KGAPIDebug) << "Applying" << items.count() << "changes to Drive mirror";
+        qlonglong changeId = qMax(largestChangeId, job->largestChangeId());
+        for (const ObjectPtr &item : items) {
+            const ChangePtr change = item.dynamicCast<Change>();
+            if (!change) {
+                continue;
+            }
+            changeId = qMax(changeId, change->id());
+
+            const FilePtr file = change->file();
+            if (change->deleted() || !file || (file->labels() && file->labels()->trashed())) {
+                if (remove(change->fileId())) {
+                    Q_EMIT q->fileRemoved(q, change->fileId());
+                }
+            } else {
+                insert(file);
+                Q_EMIT q->fileChanged(q, file->id());
+            }
+        }
+        largestChangeId = changeId;
+
+        finish();
+    });
+}
+
+bool DriveMirror::Private::checkJob(Job *job)
+{
+    if (job->error() == KGAPI2::NoError) {
+        return true;
+    }
+
+    qCWarning(KGAPIDebug) << "Drive mirror synchronization failed:" << job->errorString();
+    synchronizing = false;
+    Q_EMIT q->error(q, job->error(), job->errorString());
+    return false;
+}
+
+void DriveMirror::Private::finish()
+{
+    synchronizing = false;
+    if (!save()) {
+        Q_EMIT q->error(q, KGAPI2::UnknownError, tr("Failed to store Drive mirror in %1").arg(storePath));
+        return;
+    }
+    Q_EMIT q->synchronized(q);
+}
+
+void DriveMirror::Private::insert(const FilePtr &file)
+{
+    remove(file->id());
+
+    files.insert(file->id(), file);
+    const auto parents = file->parents();
+    for (const ParentReferencePtr &parent : parents) {
+        if (!parent) {
+            continue;
+        }
+        children[parent->id()].insert(file->id());
+        if (parent->isRoot() && rootFolderId.isEmpty()) {
+            rootFolderId = parent->id();
+        }
+    }
+}
+
+bool DriveMirror::Private::remove(const QString &fileId)
+{
+    const FilePtr file = files.take(fileId);
+    if (!file) {
+        return false;
+    }
+
+    const auto parents = file->parents();
+    for (const ParentReferencePtr &parent : parents) {
+        if (!parent) {
+            continue;
+        }
+        auto it = children.find(parent->id());
+        if (it != children.end()) {
+            it->remove(fileId);
+            if (it->isEmpty()) {
+                children.erase(it);
+            }
+        }
+    }
+    return true;
+}
+
+void DriveMirror::Private::load()
+{
+    QFile store(storePath);
+    if (!store.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(store.readAll()).object();
+    largestChangeId = root.value(QLatin1StringView("largestChangeId")).toVariant().toLongLong();
+    rootFolderId = root.value(QLatin1StringView("rootFolderId")).toString();
+
+    const QJsonArray items = root.value(QLatin1StringView("items")).toArray();
+    for (const QJsonValue &item : items) {
+        const FilePtr file = File::fromJSON(item.toObject().toVariantMap());
+        if (file && !file->id().isEmpty()) {
+            insert(file);
+        }
+    }
+    qCDebug(KGAPIDebug) << "Loaded" << files.count() << "files from Drive mirror" << storePath;
+}
+
+bool DriveMirror::Private::save()
+{
+    QJsonArray items;
+    for (const FilePtr &file : std::as_const(files)) {
+        const QVariantMap data = StoredFile::toJSON(file);
+        if (!data.isEmpty()) {
+            items.append(QJsonObject::fromVariantMap(data));
+        }
+    }
+
+    QJsonObject root;
+    // Same as in the API, int64 values are stored as strings
+    root.insert(QLatin1StringView("largestChangeId"), QString::number(largestChangeId));
+    root.insert(QLatin1StringView("rootFolderId"), rootFolderId);
+    root.insert(QLatin1StringView("items"), items);
+
+    QSaveFile store(storePath);
+    if (!store.open(QIODevice::WriteOnly)) {
+        qCWarning(KGAPIDebug) << "Failed to open Drive mirror store" << storePath << store.errorString();
+        return false;
+    }
+    store.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return store.commit();
+}
+
+DriveMirror::DriveMirror(const AccountPtr &account, const QString &storePath, QObject *parent)
+    : QObject(parent)
+    , d(new Private(this))
+{
+    d->account = account;
+    d->storePath = storePath;
+    connect(&d->pollTimer, &QTimer::timeout, this, &DriveMirror::synchronize);
+
+    d->load();
+}
+
+DriveMirror::~DriveMirror() = default;
+
+AccountPtr DriveMirror::account() const
+{
+    return d->account;
+}
+
+void DriveMirror::setAccount(const AccountPtr &account)
+{
+    d->account = account;
+}
+
+QString DriveMirror::storePath() const
+{
+    return d->storePath;
+}
+
+int DriveMirror::pollInterval() const
+{
+    return d->pollTimer.isActive() ? d->pollTimer.interval() / 1000 : 0;
+}
+
+void DriveMirror::setPollInterval(int seconds)
+{
+    if (seconds > 0) {
+        d->pollTimer.start(seconds * 1000);
+    } else {
+        d->pollTimer.stop();
+    }
+}
+
+bool DriveMirror::isSynchronizing() const
+{
+    return d->synchronizing;
+}
+
+bool DriveMirror::isValid() const
+{
+    return d->largestChangeId > 0;
+}
+
+qlonglong DriveMirror::largestChangeId() const
+{
+    return d->largestChangeId;
+}
+
+QString DriveMirror::rootFolderId() const
+{
+    return d->rootFolderId;
+}
+
+FilePtr DriveMirror::file(const QString &fileId) const
+{
+    return d->files.value(fileId);
+}
+
+FilesList DriveMirror::files() const
+{
+    return d->files.values();
+}
+
+FilesList DriveMirror::children(const QString &folderId) const
+{
+    const QString id = folderId == QLatin1StringView("root") ? d->rootFolderId : folderId;
+    const auto childIds = d->children.value(id);
+
+    FilesList result;
+    result.reserve(childIds.size());
+    for (const QString &childId : childIds) {
+        result.push_back(d->files.value(childId));
+    }
+    return result;
+}
+
+FilesList DriveMirror::search(const QString &text, Qt::CaseSensitivity cs) const
+{
+    FilesList result;
+    for (const FilePtr &file : std::as_const(d->files)) {
+        if (file->title().contains(text, cs)) {
+            result.push_back(file);
+        }
+    }
+    return result;
+}
+
+void DriveMirror::synchronize()
+{
+    if (d->synchronizing) {
+        return;
+    }
+
+    d->synchronizing = true;
+    if (isValid()) {
+        d->fetchChanges();
+    } else {
+        d->fetchAbout();
+    }
+}
+
+void DriveMirror::reset()
+{
+    d->files.clear();
+    d->children.clear();
+    d->largestChangeId = 0;
+    d->rootFolderId.clear();
+    QFile::remove(d->storePath);
+}
+
+#include "moc_drivemirror.cpp"
@@ -0,0 +1,150 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "kgapidrive_export.h"
+#include "types.h"
+
+#include <QObject>
+#include <QScopedPointer>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @brief Local copy of Drive file metadata kept up to date via the changes feed
+ *
+ * The first synchronize() lists all files of the account, following calls
+ * only fetch changes since the last synchronization and apply them, including
+ * deletions, trashing and moves between folders. The state is persisted to
+ * a JSON file, so a new DriveMirror continues where the last one stopped.
+ *
+ * Browsing and searching the mirror is served from memory without any API
+ * calls. Trashed files are not part of the mirror.
+ *
+ * @since 6.9.0
+ */
+class KGAPIDRIVE_EXPORT DriveMirror : public QObject
+{
+    Q_OBJECT
+
+    /**
+     * Interval in seconds in which the mirror synchronizes automatically.
+     * Default is 0, i.e. the mirror is only synchronized by calling synchronize().
+     */
+    Q_PROPERTY(int pollInterval READ pollInterval WRITE setPollInterval)
+
+public:
+    /**
+     * @brief Constructs a mirror of files of @p account stored in @p storePath
+     *
+     * If @p storePath exists the previously synchronized state is loaded from it.
+     */
+    explicit DriveMirror(const AccountPtr &account, const QString &storePath, QObject *parent = nullptr);
+    ~DriveMirror() override;
+
+    [[nodiscard]] AccountPtr account() const;
+    void setAccount(const AccountPtr &account);
+
+    [[nodiscard]] QString storePath() const;
+
+    [[nodiscard]] int pollInterval() const;
+    void setPollInterval(int seconds);
+
+    /**
+     * @brief Returns whether a synchronization is in progress
+     */
+    [[nodiscard]] bool isSynchronizing() const;
+
+    /**
+     * @brief Returns whether the mirror has been synchronized at least once
+     */
+    [[nodiscard]] bool isValid() const;
+
+    /**
+     * @brief Returns ID of the last change applied to the mirror
+     */
+    [[nodiscard]] qlonglong largestChangeId() const;
+
+    /**
+     * @brief Returns ID of the root folder of My Drive
+     */
+    [[nodiscard]] QString rootFolderId() const;
+
+    /**
+     * @brief Returns file with ID @p fileId or a null pointer
+     */
+    [[nodiscard]] FilePtr file(const QString &fileId) const;
+
+    /**
+     * @brief Returns all files in the mirror
+     */
+    [[nodiscard]] FilesList files() const;
+
+    /**
+     * @brief Returns files in folder @p folderId
+     *
+     * The "root" alias can be used for the root folder.
+     */
+    [[nodiscard]] FilesList children(const QString &folderId) const;
+
+    /**
+     * @brief Returns files whose title contains @p text
+     */
+    [[nodiscard]] FilesList search(const QString &text, Qt::CaseSensitivity cs = Qt::CaseInsensitive) const;
+
+public Q_SLOTS:
+    /**
+     * @brief Brings the mirror up to date
+     *
+     * Emits synchronized() when done, or error() when the synchronization
+     * fails. Does nothing when a synchronization is already in progress.
+     */
+    void synchronize();
+
+    /**
+     * @brief Discards the mirrored state
+     *
+     * The next synchronize() will list all files again.
+     */
+    void reset();
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted when the mirror has been brought up to date and stored
+     */
+    void synchronized(KGAPI2::Drive::DriveMirror *mirror);
+
+    /**
+     * @brief Emitted when file @p fileId was added, modified or moved
+     */
+    void fileChanged(KGAPI2::Drive::DriveMirror *mirror, const QString &fileId);
+
+    /**
+     * @brief Emitted when file @p fileId was deleted or trashed
+     */
+    void fileRemoved(KGAPI2::Drive::DriveMirror *mirror, const QString &fileId);
+
+    /**
+     * @brief Emitted when synchronization fails, the mirror keeps its previous state
+     */
+    void error(KGAPI2::Drive::DriveMirror *mirror, KGAPI2::Error error, const QString &errorString);
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
@@ -0,0 +1,385 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "drivepathresolver.h"
+#include "account.h"
+#include "debug.h"
+#include "drivemirror.h"
+#include "file.h"
+#include "filefetchjob.h"
+#include "filesearchquery.h"
+#include "parentreference.h"
+
+#include <QHash>
+#include <QMultiHash>
+#include <QPointer>
+#include <QSet>
+#include <QSharedPointer>
+#include <QTimer>
+
+#include <utility>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+// Maximum number of titles looked up in a single files query
+static constexpr int MaxLookupTitles = 50;
+static const QString RootKey = QStringLiteral("root");
+
+struct Lookup {
+    QStringList paths;
+    int pendingJobs = 0;
+    Error error = KGAPI2::NoError;
+    QString errorString;
+};
+}
+
+class Q_DECL_HIDDEN DrivePathResolver::Private
+{
+public:
+    Private(DrivePathResolver *parent);
+
+    static QStringList splitPath(const QString &path);
+    static QString parentKey(const ParentReferencePtr &parent);
+    static QStringList parentKeys(const FilePtr &file);
+
+    QString childId(const QString &parentKey, const QString &title, bool preferFolder) const;
+    QString walk(const QStringList &components, int &missing) const;
+    QString cachedFileId(const QString &path) const;
+
+    void insert(const FilePtr &file);
+    bool remove(const QString &fileId);
+
+    void scheduleLookup();
+    void lookup();
+    void lookupFinished(const QSharedPointer<Lookup> &batch);
+
+    AccountPtr account;
+    QPointer<DriveMirror> mirror;
+
+    QHash<QString /* file ID */, FilePtr> files;
+    QHash<QString /* parent ID */, QMultiHash<QString /* title */, QString /* file ID */>> children;
+    mutable QHash<QString /* path */, QString /* file ID */> pathCache;
+
+    QStringList pendingPaths;
+    bool lookupScheduled = false;
+
+private:
+    DrivePathResolver *const q;
+};
+
+DrivePathResolver::Private::Private(DrivePathResolver *parent)
+    : q(parent)
+{
+}
+
+QStringList DrivePathResolver::Private::splitPath(const QString &path)
+{
+    return path.split(QLatin1Char('/'), Qt::SkipEmptyParts);
+}
+
+QString DrivePathResolver::Private::parentKey(const ParentReferencePtr &parent)
+{
+    // Paths start at the root folder, whose real ID we may not know
+    return parent->isRoot() ? RootKey : parent->id();
+}
+
+QStringList DrivePathResolver::Private::parentKeys(const FilePtr &file)
+{
+    QStringList keys;
+    const auto parents = file->parents();
+    for (const ParentReferencePtr &parent : parents) {
+        keys.append(parentKey(parent));
+    }
+    return keys;
+}
+
+QString DrivePathResolver::Private::childId(const QString &parentKey, const QString &title, bool preferFolder) const
+{
+    const auto it = children.constFind(parentKey);
+    if (it == children.cend()) {
+        return QString();
+    }
+
+    const auto ids = it->values(title);
+    if (ids.isEmpty()) {
+        return QString();
+    }
+    if (preferFolder) {
+        for (const QString &id : ids) {
+            if (files.value(id)->isFolder()) {
+                return id;
+            }
+        }
+    }
+    return ids.constFirst();
+}
+
+QString DrivePathResolver::Private::walk(const QStringList &components, int &missing) const
+{
+    QString id = RootKey;
+    for (int i = 0; i < components.size(); ++i) {
+        id = childId(id, components.at(i), i < components.size() - 1);
+        if (id.isEmpty()) {
+            missing = i;
+            return QString();
+        }
+    }
+
+    missing = -1;
+    return id;
+}
+
+QString DrivePathResolver::Private::cachedFileId(const QString &path) const
+{
+    const QStringList components = splitPath(path);
+    const QString normalizedPath = QLatin1Char('/') + components.join(QLatin1Char('/'));
+
+    const auto cached = pathCache.constFind(normalizedPath);
+    if (cached != pathCache.cend()) {
+        return *cached;
+    }
+
+    int missing = -1;
+    const QString id = walk(components, missing);
+    if (!id.isEmpty()) {
+        pathCache.insert(normalizedPath, id);
+    }
+    return id;
+}
+
+void DrivePathResolver::Private::insert(const FilePtr &file)
+{
+    if (file->labels() && file->labels()->trashed()) {
+        remove(file->id());
+        return;
+    }
+
+    const FilePtr old = files.value(file->id());
+    if (old) {
+        if (old->title() == file->title() && parentKeys(old) == parentKeys(file)) {
+            files.insert(file->id(), file);
+            pathCache.removeIf([&file](const auto &it) {
+                return it.value() == file->id();
+            });
+            return;
+        }
+        remove(file->id());
+    }
+
+    files.insert(file->id(), file);
+    const QStringList keys = parentKeys(file);
+    for (const QString &key : keys) {
+        children[key].insert(file->title(), file->id());
+    }
+}
+
+bool DrivePathResolver::Private::remove(const QString &fileId)
+{
+    const FilePtr file = files.take(fileId);
+    if (!file) {
+        return false;
+    }
+
+    const QStringList keys = parentKeys(file);
+    for (const QString &key : keys) {
+        auto it = children.find(key);
+        if (it != children.end()) {
+            it->remove(file->title(), fileId);
+            if (it->isEmpty()) {
+                children.erase(it);
+            }
+        }
+    }
+
+    // Paths of the file and of everything below it are no longer valid
+    pathCache.clear();
+    return true;
+}
+
+void DrivePathResolver::Private::scheduleLookup()
+{
+    if (lookupScheduled) {
+        return;
+    }
+
+    lookupScheduled = true;
+    QTimer::singleShot(0, q, [this]() {
+        lookup();
+    });
+}
+
+void DrivePathResolver::Private::lookup()
+{
+    lookupScheduled = false;
+
+    auto pending = QSharedPointer<Lookup>::create();
+    QSet<QString> titles;
+    const QStringList paths = std::exchange(pendingPaths, {});
+    for (const QString &path : paths) {
+        const QStringList components = splitPath(path);
+        int missing = -1;
+        const QString id = walk(components, missing);
+        if (!id.isEmpty() || components.isEmpty()) {
+            Q_EMIT q->resolved(q, path, components.isEmpty() ? RootKey : id);
+            continue;
+        }
+
+        pending->paths.append(path);
+        for (int i = missing; i < components.size(); ++i) {
+            titles.insert(components.at(i));
+        }
+    }
+
+    if (pending->paths.isEmpty()) {
+        return;
+    }
+
+    // All missing components of all paths are looked up at once, the paths
+    // are then resolved from the cache
+    const QStringList titleList(titles.cbegin(), titles.cend());
+    qCDebug(KGAPIDebug) << "Looking up" << titleList.size() << "path components for" << pending->paths.size() << "paths";
+    for (qsizetype i = 0; i < titleList.size(); i += MaxLookupTitles) {
+        FileSearchQuery titlesQuery(FileSearchQuery::Or);
+        for (const QString &title : titleList.mid(i, MaxLookupTitles)) {
+            titlesQuery.addQuery(FileSearchQuery::Title, FileSearchQuery::Equals, title);
+        }
+        FileSearchQuery query;
+        query.addQuery(FileSearchQuery::Trashed, FileSearchQuery::Equals, false);
+        query.addQuery(titlesQuery);
+
+        auto job = new FileFetchJob(query, account, q);
+        job->setFields({File::Fields::Id, File::Fields::Title, File::Fields::MimeType, File::Fields::Parents, File::Fields::Labels});
+        ++pending->pendingJobs;
+        connect(job, &Job::finished, q, [this, job, pending]() {
+            job->deleteLater();
+            if (job->error() != KGAPI2::NoError) {
+                pending->error = job->error();
+                pending->errorString = job->errorString();
+            } else {
+                const auto items = job->items();
+                for (const ObjectPtr &item : items) {
+                    if (const FilePtr file = item.dynamicCast<File>()) {
+                        insert(file);
+                    }
+                }
+            }
+
+            if (--pending->pendingJobs == 0) {
+                lookupFinished(pending);
+            }
+        });
+    }
+}
+
+void DrivePathResolver::Private::lookupFinished(const QSharedPointer<Lookup> &batch)
+{
+    if (batch->error != KGAPI2::NoError) {
+        qCWarning(KGAPIDebug) << "Failed to resolve paths:" << batch->errorString;
+        Q_EMIT q->error(q, batch->paths, batch->error, batch->errorString);
+        return;
+    }
+
+    for (const QString &path : std::as_const(batch->paths)) {
+        Q_EMIT q->resolved(q, path, cachedFileId(path));
+    }
+}
+
+DrivePathResolver::DrivePathResolver(const AccountPtr &account, QObject *parent)
+    : QObject(parent)
+    , d(new Private(this))
+{
+    d->account = account;
+}
+
+DrivePathResolver::~DrivePathResolver() = default;
+
+AccountPtr DrivePathResolver::account() const
+{
+    return d->account;
+}
+
+void DrivePathResolver::setAccount(const AccountPtr &account)
+{
+    d->account = account;
+}
+
+QString DrivePathResolver::cachedFileId(const QString &path) const
+{
+    if (Private::splitPath(path).isEmpty()) {
+        return RootKey;
+    }
+    return d->cachedFileId(path);
+}
+
+void DrivePathResolver::resolve(const QStringList &paths)
+{
+    for (const QString &path : paths) {
+        const QString id = cachedFileId(path);
+        if (!id.isEmpty()) {
+            Q_EMIT resolved(this, path, id);
+        } else if (d->mirror && d->mirror->isValid()) {
+            // The mirror has all the files, the path does not exist
+            Q_EMIT resolved(this, path, QString());
+        } else {
+            d->pendingPaths.append(path);
+            d->scheduleLookup();
+        }
+    }
+}
+
+void DrivePathResolver::resolve(const QString &path)
+{
+    resolve(QStringList{path});
+}
+
+void DrivePathResolver::setMirror(DriveMirror *mirror)
+{
+    if (d->mirror) {
+        disconnect(d->mirror, nullptr, this, nullptr);
+    }
+
+    d->mirror = mirror;
+    if (!mirror) {
+        return;
+    }
+
+    const auto files = mirror->files();
+    for (const FilePtr &file : files) {
+        updateFile(file);
+    }
+    connect(mirror, &DriveMirror::fileChanged, this, [this](DriveMirror *source, const QString &fileId) {
+        updateFile(source->file(fileId));
+    });
+    connect(mirror, &DriveMirror::fileRemoved, this, [this](DriveMirror *, const QString &fileId) {
+        removeFile(fileId);
+    });
+}
+
+void DrivePathResolver::updateFile(const FilePtr &file)
+{
+    if (file && !file->id().isEmpty()) {
+        d->insert(file);
+    }
+}
+
+void DrivePathResolver::removeFile(const QString &fileId)
+{
+    d->remove(fileId);
+}
+
+void DrivePathResolver::clear()
+{
+    d->files.clear();
+    d->children.clear();
+    d->pathCache.clear();
+}
+
+#include "moc_drivepathresolver.cpp"
@@ -0,0 +1,118 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "kgapidrive_export.h"
+#include "types.h"
+
+#include <QObject>
+#include <QScopedPointer>
+#include <QStringList>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+class DriveMirror;
+
+/**
+ * @brief Resolves paths like "/Projects/2026/report.pdf" to file IDs
+ *
+ * The resolver keeps a cache of the folder graph built from File::parents()
+ * of every file it has seen. Paths whose components are all cached are
+ * resolved from memory. For the others the missing components of all pending
+ * paths are looked up by their titles in a single files query, and the paths
+ * are resolved once the reply arrives.
+ *
+ * When files are modified, moved or deleted the cache has to be updated via
+ * updateFile() and removeFile(), or it can be kept up to date automatically
+ * by a DriveMirror, see setMirror().
+ *
+ * Paths are always absolute and relative to the root folder of My Drive.
+ * When a folder contains several files with the same title, the first one
+ * found is used.
+ *
+ * @since 6.9.0
+ */
+class KGAPIDRIVE_EXPORT DrivePathResolver : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DrivePathResolver(const AccountPtr &account, QObject *parent = nullptr);
+    ~DrivePathResolver() override;
+
+    [[nodiscard]] AccountPtr account() const;
+    void setAccount(const AccountPtr &account);
+
+    /**
+     * @brief Returns ID of file at @p path from the cache
+     *
+     * Never sends any request. Returns an empty string when some component of
+     * the path is not cached. The root folder is returned as "root".
+     */
+    [[nodiscard]] QString cachedFileId(const QString &path) const;
+
+    /**
+     * @brief Resolves @p paths and emits resolved() for each of them
+     *
+     * Cached paths are resolved immediately. The others are collected and
+     * looked up together once control returns to the event loop, so
+     * resolving many paths in a row results in a single query.
+     */
+    void resolve(const QStringList &paths);
+    void resolve(const QString &path);
+
+    /**
+     * @brief Populates the cache from @p mirror and follows its changes
+     *
+     * With a mirror all paths are resolved locally without any requests.
+     * Passing a null pointer detaches the current mirror.
+     */
+    void setMirror(DriveMirror *mirror);
+
+    /**
+     * @brief Adds @p file to the cache or updates its title and parents
+     */
+    void updateFile(const KGAPI2::Drive::FilePtr &file);
+
+    /**
+     * @brief Removes file @p fileId from the cache
+     */
+    void removeFile(const QString &fileId);
+
+    /**
+     * @brief Clears the whole cache
+     */
+    void clear();
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted when @p path has been resolved
+     *
+     * @p fileId is empty when the path does not exist.
+     */
+    void resolved(KGAPI2::Drive::DrivePathResolver *resolver, const QString &path, const QString &fileId);
+
+    /**
+     * @brief Emitted when looking up @p paths failed
+     */
+    void error(KGAPI2::Drive::DrivePathResolver *resolver, const QStringList &paths, KGAPI2::Error error, const QString &errorString);
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
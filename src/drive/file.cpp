@@ -1030,6 +1030,15 @@ const QString File::Fields::Version = QStringLiteral("version");
 const QString File::Fields::SharingUser = QStringLiteral("sharingUser");
 const QString File::Fields::Permissions = QStringLiteral("permissions");
 
+const QString File::Labels::Fields::Starred = QStringLiteral("starred");
+const QString File::Labels::Fields::Hidden = QStringLiteral("hidden");
+const QString File::Labels::Fields::Trashed = QStringLiteral("trashed");
+const QString File::Labels::Fields::Restricted = QStringLiteral("restricted");
+const QString File::Labels::Fields::Viewed = QStringLiteral("viewed");
+
+const QString File::Thumbnail::Fields::Image = QStringLiteral("image");
+const QString File::Thumbnail::Fields::MimeType = QStringLiteral("mimeType");
+
 FilePtr File::fromJSON(const QByteArray &jsonData)
 {
     QJsonDocument document = QJsonDocument::fromJson(jsonData);
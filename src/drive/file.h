@@ -119,6 +119,22 @@ public:
          */
         void setViewed(bool viewed);
 
+        /**
+         * @brief Names of the labels properties
+         *
+         * Use with Job::buildSubfields() to fetch only some of the labels,
+         * e.g. Job::buildSubfields(File::Fields::Labels, {File::Labels::Fields::Starred}).
+         *
+         * @since 6.9.0
+         */
+        struct Fields {
+            static const QString Starred;
+            static const QString Hidden;
+            static const QString Trashed;
+            static const QString Restricted;
+            static const QString Viewed;
+        };
+
     private:
         class Private;
         Private *const d;
@@ -302,6 +318,16 @@ public:
 
         [[nodiscard]] QString mimeType() const;
 
+        /**
+         * @brief Names of the thumbnail properties
+         *
+         * @since 6.9.0
+         */
+        struct Fields {
+            static const QString Image;
+            static const QString MimeType;
+        };
+
     private:
         explicit Thumbnail(const QVariantMap &jsonMap);
 
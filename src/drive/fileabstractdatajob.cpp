@@ -30,6 +30,7 @@ public:
     QString timedTextLanguage;
     QString timedTextTrackName;
     bool useContentAsIndexableText = false;
+    BandwidthLimiter::Priority transferPriority = BandwidthLimiter::Background;
 };
 
 FileAbstractDataJob::Private::Private()
@@ -192,6 +193,21 @@ bool FileAbstractDataJob::useContentAsIndexableText() const
     return d->useContentAsIndexableText;
 }
 
+BandwidthLimiter::Priority FileAbstractDataJob::transferPriority() const
+{
+    return d->transferPriority;
+}
+
+void FileAbstractDataJob::setTransferPriority(BandwidthLimiter::Priority priority)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify transferPriority property when job is running";
+        return;
+    }
+
+    d->transferPriority = priority;
+}
+
 QUrl FileAbstractDataJob::updateUrl(QUrl &url)
 {
     QUrlQuery query(url);
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "bandwidthlimiter.h"
 #include "createjob.h"
 #include "kgapidrive_export.h"
 
@@ -163,6 +164,19 @@ public:
     [[nodiscard]] bool useContentAsIndexableText() const;
     void setUseContentAsIndexableText(bool useContentAsIndexableText);
 
+    /**
+     * @brief Sets priority of the upload in BandwidthLimiter
+     *
+     * Background uploads are slowed down to stay within the limits set in
+     * BandwidthLimiter::instance(), interactive ones are not.
+     *
+     * Defaults to BandwidthLimiter::Background.
+     *
+     * @since 6.9.0
+     */
+    void setTransferPriority(BandwidthLimiter::Priority priority);
+    [[nodiscard]] BandwidthLimiter::Priority transferPriority() const;
+
 protected:
     QUrl updateUrl(QUrl &url);
 
@@ -7,7 +7,9 @@
  */
 
 #include "fileabstractmodifyjob.h"
+#include "debug.h"
 #include "file.h"
+#include "fileerrors_p.h"
 #include "utils.h"
 
 #include <QNetworkReply>
@@ -17,16 +19,26 @@
 using namespace KGAPI2;
 using namespace KGAPI2::Drive;
 
+namespace
+{
+static constexpr int DefaultConcurrentRequests = 8;
+}
+
 class Q_DECL_HIDDEN FileAbstractModifyJob::Private
 {
 public:
     Private(FileAbstractModifyJob *parent);
-    void processNext();
+    void enqueueRequests();
+    void fileFinished(const QString &fileId);
 
     QStringList filesIds;
+    bool isMultiple = false;
 
     bool supportsAllDrives = true;
 
+    FileErrors errors;
+    int processedFiles = 0;
+
 private:
     FileAbstractModifyJob *const q;
 };
@@ -36,24 +48,27 @@ FileAbstractModifyJob::Private::Private(FileAbstractModifyJob *parent)
 {
 }
 
-void FileAbstractModifyJob::Private::processNext()
+void FileAbstractModifyJob::Private::enqueueRequests()
 {
-    if (filesIds.isEmpty()) {
-        q->emitFinished();
-        return;
-    }
+    for (const QString &fileId : std::as_const(filesIds)) {
+        QUrl url = q->url(fileId);
 
-    const QString fileId = filesIds.takeFirst();
-    QUrl url = q->url(fileId);
+        QUrlQuery query(url);
+        query.addQueryItem(QStringLiteral("supportsAllDrives"), Utils::bool2Str(supportsAllDrives));
+        url.setQuery(query);
 
-    QUrlQuery query(url);
-    query.addQueryItem(QStringLiteral("supportsAllDrives"), Utils::bool2Str(supportsAllDrives));
-    url.setQuery(query);
+        QNetworkRequest request(url);
+        request.setHeader(QNetworkRequest::ContentLengthHeader, 0);
+        request.setAttribute(QNetworkRequest::User, fileId);
 
-    QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::ContentLengthHeader, 0);
+        q->enqueueRequest(request);
+    }
+}
 
-    q->enqueueRequest(request);
+void FileAbstractModifyJob::Private::fileFinished(const QString &fileId)
+{
+    q->emitProgress(++processedFiles, filesIds.size());
+    Q_EMIT q->fileProcessed(q, fileId);
 }
 
 FileAbstractModifyJob::FileAbstractModifyJob(const QString &fileId, const AccountPtr &account, QObject *parent)
@@ -68,6 +83,9 @@ FileAbstractModifyJob::FileAbstractModifyJob(const QStringList &filesIds, const
     , d(new Private(this))
 {
     d->filesIds << filesIds;
+    d->filesIds.removeDuplicates();
+    d->isMultiple = true;
+    setMaxConcurrentRequests(DefaultConcurrentRequests);
 }
 
 FileAbstractModifyJob::FileAbstractModifyJob(const FilePtr &file, const AccountPtr &account, QObject *parent)
@@ -84,6 +102,9 @@ FileAbstractModifyJob::FileAbstractModifyJob(const FilesList &files, const Accou
     for (const FilePtr &file : std::as_const(files)) {
         d->filesIds << file->id();
     }
+    d->filesIds.removeDuplicates();
+    d->isMultiple = true;
+    setMaxConcurrentRequests(DefaultConcurrentRequests);
 }
 
 FileAbstractModifyJob::~FileAbstractModifyJob()
@@ -93,7 +114,15 @@ FileAbstractModifyJob::~FileAbstractModifyJob()
 
 void FileAbstractModifyJob::start()
 {
-    d->processNext();
+    d->errors.clear();
+    d->processedFiles = 0;
+
+    if (d->filesIds.isEmpty()) {
+        emitFinished();
+        return;
+    }
+
+    d->enqueueRequests();
 }
 
 bool FileAbstractModifyJob::supportsAllDrives() const
@@ -106,6 +135,27 @@ void FileAbstractModifyJob::setSupportsAllDrives(bool supportsAllDrives)
     d->supportsAllDrives = supportsAllDrives;
 }
 
+QStringList FileAbstractModifyJob::failedFilesIds() const
+{
+    QStringList ids;
+    for (const QString &fileId : std::as_const(d->filesIds)) {
+        if (d->errors.contains(fileId)) {
+            ids << fileId;
+        }
+    }
+    return ids;
+}
+
+Error FileAbstractModifyJob::fileError(const QString &fileId) const
+{
+    return d->errors.error(fileId);
+}
+
+QString FileAbstractModifyJob::fileErrorString(const QString &fileId) const
+{
+    return d->errors.errorString(fileId);
+}
+
 ObjectsList FileAbstractModifyJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
 {
     const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
@@ -117,11 +167,31 @@ ObjectsList FileAbstractModifyJob::handleReplyWithItems(const QNetworkReply *rep
         setError(KGAPI2::InvalidResponse);
         setErrorString(tr("Invalid response content type"));
         emitFinished();
+        return items;
     }
 
-    d->processNext();
+    d->fileFinished(currentRequest().attribute(QNetworkRequest::User).toString());
 
     return items;
 }
 
+bool FileAbstractModifyJob::handleError(int statusCode, const QByteArray &rawData)
+{
+    if (!d->isMultiple) {
+        return ModifyJob::handleError(statusCode, rawData);
+    }
+
+    if (!FileErrors::isFileError(statusCode, rawData)) {
+        // Errors that are not specific to a single file abort the whole job
+        return ModifyJob::handleError(statusCode, rawData);
+    }
+
+    const QString fileId = currentRequest().attribute(QNetworkRequest::User).toString();
+    d->errors.insertReply(fileId, statusCode, rawData);
+    qCWarning(KGAPIDebug) << "Failed to modify file" << fileId << ":" << d->errors.errorString(fileId);
+
+    d->fileFinished(fileId);
+    return true;
+}
+
 #include "moc_fileabstractmodifyjob.cpp"
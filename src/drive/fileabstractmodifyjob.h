@@ -19,6 +19,15 @@ namespace KGAPI2
 namespace Drive
 {
 
+/**
+ * @brief Base class for jobs that change state of files, like FileTrashJob
+ *
+ * When the job is given a list of files, up to Job::maxConcurrentRequests()
+ * requests (8 by default) are in flight at once. A failure on one of the
+ * files then does not abort the job: it is recorded and can be checked with
+ * failedFilesIds() and fileError(). A job for a single file fails as a
+ * whole, like any other job.
+ */
 class KGAPIDRIVE_EXPORT FileAbstractModifyJob : public KGAPI2::ModifyJob
 {
     Q_OBJECT
@@ -50,9 +59,35 @@ public:
      */
     KGAPIDRIVE_DEPRECATED void setSupportsAllDrives(bool supportsAllDrives);
 
+    /**
+     * @brief Returns IDs of files that could not be modified
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] QStringList failedFilesIds() const;
+
+    /**
+     * @brief Returns the error that occurred on file @p fileId
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] KGAPI2::Error fileError(const QString &fileId) const;
+    [[nodiscard]] QString fileErrorString(const QString &fileId) const;
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted as soon as file @p fileId has been processed
+     *
+     * Use fileError() to check whether it succeeded.
+     *
+     * @since 6.9.0
+     */
+    void fileProcessed(KGAPI2::Drive::FileAbstractModifyJob *job, const QString &fileId);
+
 protected:
     void start() override;
     KGAPI2::ObjectsList handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData) override;
+    bool handleError(int statusCode, const QByteArray &rawData) override;
 
     virtual QUrl url(const QString &fileId) = 0;
 
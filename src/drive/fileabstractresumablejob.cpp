@@ -7,20 +7,41 @@
  */
 
 #include "fileabstractresumablejob.h"
+#include "account.h"
+#include "chunksizing_p.h"
 #include "debug.h"
+#include "uploadbodydevice_p.h"
 #include "utils.h"
 
+#include <QElapsedTimer>
 #include <QMimeDatabase>
 #include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QThreadPool>
 #include <QUrlQuery>
 
+#include <limits>
+#include <utility>
+
 using namespace KGAPI2;
 using namespace KGAPI2::Drive;
 
 namespace
 {
-static const int ChunkSize = 262144;
+// The pending chunk is held in memory, so chunks never get bigger than this
+static constexpr qint64 MaximumChunkSize = 64 * 1024 * 1024;
+static const int MaxRecoveryAttempts = 5;
+
+// Range header has form "bytes=0-N", no header means no bytes were persisted
+qint64 confirmedBytes(const QNetworkReply *reply)
+{
+    const QByteArray range = reply->rawHeader("Range");
+    const int dash = range.indexOf('-');
+    if (range.startsWith("bytes=") && dash > 0) {
+        return range.mid(dash + 1).toLongLong() + 1;
+    }
+    return 0;
+}
 }
 
 class Q_DECL_HIDDEN FileAbstractResumableJob::Private
@@ -32,6 +53,17 @@ public:
     void processNext();
     void readFromDevice();
     bool isTotalSizeKnown() const;
+    void appendData(const QByteArray &data);
+    void adaptChunkSize(qint64 bytes, qint64 elapsed);
+    void hashDevice();
+    void deviceHashed(const QString &checksum);
+    void startUpload();
+
+    bool recover();
+    void queryUploadStatus();
+    void handleStatusReply(const QNetworkReply *reply, const QByteArray &rawData);
+    bool resumeFrom(const QNetworkReply *reply);
+    bool rewindTo(qint64 offset);
 
     void _k_uploadProgress(qint64 bytesSent, qint64 totalBytes);
 
@@ -39,9 +71,30 @@ public:
     QIODevice *device = nullptr;
 
     QString sessionPath;
-    QList<QByteArray> chunks;
-    int uploadedSize = 0;
-    int totalUploadSize = 0;
+    // Data written by the client and not sent yet
+    QByteArray buffer;
+    qint64 uploadedSize = 0;
+    qint64 totalUploadSize = 0;
+
+    qint64 chunkSize = ChunkSizing::Granularity;
+    qint64 maximumChunkSize = MaximumChunkSize;
+    bool adaptiveChunkSize = false;
+    QElapsedTimer requestTimer;
+    qint64 roundTripTime = 0; // msecs
+
+    // Last chunk sent to the server, kept until the server confirms it
+    QByteArray inFlight;
+    qint64 inFlightOffset = 0;
+    qint64 deviceOffset = 0;
+    qint64 bytesToSkip = 0;
+    bool resumeSession = false;
+    bool queryingStatus = false;
+    int recoveryAttempts = 0;
+
+    bool deduplicate = false;
+    bool deduplicated = false;
+    FileHashIndex hashIndex;
+    QThreadPool hashPool;
 
     enum SessionState { ReadyStart, Started, ClientEnough, Completed };
 
@@ -72,10 +125,10 @@ void FileAbstractResumableJob::Private::startUploadSession()
     QNetworkRequest request(url);
     QByteArray rawData;
     if (!metaData.isNull()) {
-        if (metaData->mimeType().isEmpty() && !chunks.isEmpty()) {
+        if (metaData->mimeType().isEmpty() && !buffer.isEmpty()) {
             // No mimeType set, determine from title and first chunk
             const QMimeDatabase db;
-            const QMimeType mime = db.mimeTypeForFileNameAndData(metaData->title(), chunks.constFirst());
+            const QMimeType mime = db.mimeTypeForFileNameAndData(metaData->title(), buffer);
             const QString contentType = mime.name();
             metaData->setMimeType(contentType);
             qCDebug(KGAPIDebug) << "Metadata mimeType was missing, determined" << contentType;
@@ -97,12 +150,17 @@ void FileAbstractResumableJob::Private::uploadChunk(bool lastChunk)
 {
     QString rangeHeader;
     QByteArray partData;
-    if (chunks.isEmpty()) {
+    if (buffer.isEmpty()) {
         // We have consumed everything but must send one last request with total file size
         qCDebug(KGAPIDebug) << "Chunks is empty, sending only final size" << uploadedSize;
         rangeHeader = QStringLiteral("bytes */%1").arg(uploadedSize);
     } else {
-        partData = chunks.takeFirst();
+        if (buffer.size() <= chunkSize) {
+            partData = std::exchange(buffer, QByteArray());
+        } else {
+            partData = buffer.left(chunkSize);
+            buffer.remove(0, partData.size());
+        }
         // Build range header from saved upload size and new
         QString tempRangeHeader = QStringLiteral("bytes %1-%2/%3").arg(uploadedSize).arg(uploadedSize + partData.size() - 1);
         if (lastChunk) {
@@ -123,9 +181,69 @@ void FileAbstractResumableJob::Private::uploadChunk(bool lastChunk)
     request.setRawHeader(QByteArray("Content-Range"), rangeHeader.toUtf8());
     request.setHeader(QNetworkRequest::ContentLengthHeader, partData.length());
     q->enqueueRequest(request, partData);
+    inFlight = partData;
+    inFlightOffset = uploadedSize;
     uploadedSize += partData.size();
 }
 
+void FileAbstractResumableJob::Private::hashDevice()
+{
+    // Hashing reads the whole device, keep it off the event loop. The job
+    // does not touch the device until it is done.
+    QIODevice *source = device;
+    hashPool.start([this, source]() {
+        const QString checksum = FileHashIndex::md5Checksum(source);
+        QMetaObject::invokeMethod(
+            q,
+            [this, checksum]() {
+                if (q->isRunning()) {
+                    deviceHashed(checksum);
+                }
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+void FileAbstractResumableJob::Private::deviceHashed(const QString &checksum)
+{
+    if (!device->seek(deviceOffset)) {
+        q->setError(KGAPI2::UnknownError);
+        q->setErrorString(tr("Failed to seek in the source device"));
+        q->emitFinished();
+        return;
+    }
+
+    FilePtr existing;
+    const QString fileId = q->targetFileId();
+    if (fileId.isEmpty()) {
+        existing = hashIndex.findDuplicate(checksum, metaData);
+    } else if (const FilePtr current = hashIndex.file(fileId); current && current->md5Checksum().compare(checksum, Qt::CaseInsensitive) == 0) {
+        existing = current;
+    }
+    if (existing && !checksum.isEmpty()) {
+        qCDebug(KGAPIDebug) << "Content already exists as" << existing->id() << ", skipping upload";
+        metaData = existing;
+        deduplicated = true;
+        q->emitFinished();
+        return;
+    }
+
+    startUpload();
+}
+
+void FileAbstractResumableJob::Private::startUpload()
+{
+    if (device) {
+        readFromDevice();
+    }
+    // Ask for more chunks right away in case
+    // write() wasn't called before starting
+    if (buffer.isEmpty()) {
+        q->emitReadyWrite();
+    }
+    processNext();
+}
+
 void FileAbstractResumableJob::Private::processNext()
 {
     qCDebug(KGAPIDebug) << "Processing next";
@@ -135,7 +253,7 @@ void FileAbstractResumableJob::Private::processNext()
         startUploadSession();
         return;
     case Started: {
-        if (chunks.isEmpty() || chunks.constFirst().size() < ChunkSize) {
+        if (buffer.size() < chunkSize) {
             qCDebug(KGAPIDebug) << "Chunks empty or not big enough to process, asking for more";
 
             if (device) {
@@ -152,6 +270,10 @@ void FileAbstractResumableJob::Private::processNext()
         return;
     }
     case ClientEnough: {
+        if (buffer.size() > chunkSize) {
+            uploadChunk(false);
+            return;
+        }
         uploadChunk(true);
         sessionState = Completed;
         return;
@@ -165,14 +287,15 @@ void FileAbstractResumableJob::Private::processNext()
 
 void KGAPI2::Drive::FileAbstractResumableJob::Private::readFromDevice()
 {
-    char buf[ChunkSize];
-    int read = device->read(buf, ChunkSize);
+    QByteArray data(qMax(chunkSize - buffer.size(), ChunkSizing::Granularity), Qt::Uninitialized);
+    const qint64 read = device->read(data.data(), data.size());
     if (read == -1) {
         qCWarning(KGAPIDebug) << "Failed reading from device" << device->errorString();
         return;
     }
     qCDebug(KGAPIDebug) << "Read from device bytes" << read;
-    q->write(QByteArray(buf, read));
+    data.truncate(read);
+    q->write(data);
 }
 
 bool FileAbstractResumableJob::Private::isTotalSizeKnown() const
@@ -180,11 +303,161 @@ bool FileAbstractResumableJob::Private::isTotalSizeKnown() const
     return totalUploadSize != 0;
 }
 
+void FileAbstractResumableJob::Private::appendData(const QByteArray &data)
+{
+    qsizetype pos = 0;
+    if (bytesToSkip > 0) {
+        // Resuming a session, the server already has the beginning of the data
+        pos = qMin<qint64>(bytesToSkip, data.size());
+        bytesToSkip -= pos;
+    }
+
+    if (buffer.isEmpty() && pos == 0) {
+        // Share the data instead of copying it, the common case when reading whole chunks from a device
+        buffer = data;
+    } else {
+        buffer.append(data.constData() + pos, data.size() - pos);
+    }
+}
+
+void FileAbstractResumableJob::Private::adaptChunkSize(qint64 bytes, qint64 elapsed)
+{
+    if (!adaptiveChunkSize) {
+        return;
+    }
+
+    const qint64 newSize = ChunkSizing::adapt(chunkSize, maximumChunkSize, bytes, elapsed, roundTripTime);
+    if (newSize != chunkSize) {
+        qCDebug(KGAPIDebug) << "Sent" << bytes << "bytes in" << elapsed << "ms, RTT" << roundTripTime << "ms, changing chunk size to" << newSize;
+        chunkSize = newSize;
+    }
+}
+
+bool FileAbstractResumableJob::Private::recover()
+{
+    if (sessionPath.isEmpty() || sessionState == ReadyStart) {
+        return false;
+    }
+
+    if (++recoveryAttempts > MaxRecoveryAttempts) {
+        qCWarning(KGAPIDebug) << "Giving up recovering upload session after" << MaxRecoveryAttempts << "attempts";
+        return false;
+    }
+
+    qCDebug(KGAPIDebug) << "Upload interrupted, querying upload session status, attempt" << recoveryAttempts;
+    queryUploadStatus();
+    return true;
+}
+
+void FileAbstractResumableJob::Private::queryUploadStatus()
+{
+    QString totalSymbol = QStringLiteral("*");
+    if (sessionState == Completed) {
+        // The last chunk has been sent already, so the final size is known
+        totalSymbol = QString::number(inFlightOffset + inFlight.size());
+    } else if (isTotalSizeKnown()) {
+        totalSymbol = QString::number(totalUploadSize);
+    }
+
+    QNetworkRequest request(QUrl(sessionPath));
+    request.setRawHeader(QByteArray("Content-Range"), QStringLiteral("bytes */%1").arg(totalSymbol).toUtf8());
+    request.setHeader(QNetworkRequest::ContentLengthHeader, 0);
+
+    queryingStatus = true;
+    q->enqueueRequest(request);
+}
+
+void FileAbstractResumableJob::Private::handleStatusReply(const QNetworkReply *reply, const QByteArray &rawData)
+{
+    queryingStatus = false;
+
+    const int replyCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (replyCode == KGAPI2::OK || replyCode == KGAPI2::Created) {
+        qCDebug(KGAPIDebug) << "Server has already received the whole upload";
+        const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+        if (Utils::stringToContentType(contentType) == KGAPI2::JSON) {
+            metaData = File::fromJSON(rawData);
+            hashIndex.addFile(metaData);
+        }
+        sessionState = Completed;
+        processNext();
+        return;
+    }
+
+    if (replyCode != KGAPI2::ResumeIncomplete) {
+        if (!recover()) {
+            q->setError(KGAPI2::UnknownError);
+            q->setErrorString(tr("Failed querying upload session status"));
+            q->emitFinished();
+        }
+        return;
+    }
+
+    if (resumeFrom(reply)) {
+        processNext();
+    }
+}
+
+bool FileAbstractResumableJob::Private::resumeFrom(const QNetworkReply *reply)
+{
+    // Server could send us a new upload session location any time, use it if present
+    const QString newUploadLocation = reply->header(QNetworkRequest::LocationHeader).toString();
+    if (!newUploadLocation.isEmpty()) {
+        qCDebug(KGAPIDebug) << "Got new location" << newUploadLocation;
+        sessionPath = newUploadLocation;
+    }
+
+    // The server may persist less than was sent, continue from where it stopped
+    const qint64 confirmed = confirmedBytes(reply);
+    qCDebug(KGAPIDebug) << "Server confirms" << confirmed << "bytes";
+    if (!rewindTo(confirmed)) {
+        qCWarning(KGAPIDebug) << "Can't resume upload from offset" << confirmed;
+        q->setError(KGAPI2::UnknownError);
+        q->setErrorString(tr("Failed resuming upload, the data is no longer available"));
+        q->emitFinished();
+        return false;
+    }
+    return true;
+}
+
+bool FileAbstractResumableJob::Private::rewindTo(qint64 offset)
+{
+    const qint64 inFlightEnd = inFlightOffset + inFlight.size();
+    if (offset >= inFlightOffset && offset <= inFlightEnd) {
+        // Re-send only the part of the last chunk that did not make it
+        buffer.prepend(inFlight.mid(offset - inFlightOffset));
+    } else if (device && !device->isSequential() && device->seek(deviceOffset + offset)) {
+        buffer.clear();
+        sessionState = Started;
+    } else if (offset > inFlightEnd && buffer.isEmpty() && sessionState == Started) {
+        // Resuming a persisted session, drop the data the server already has
+        bytesToSkip = offset - inFlightEnd;
+    } else {
+        return false;
+    }
+
+    inFlight.clear();
+    inFlightOffset = offset;
+    uploadedSize = offset;
+    if (sessionState == Completed) {
+        sessionState = ClientEnough;
+    }
+    return true;
+}
+
 void FileAbstractResumableJob::Private::_k_uploadProgress(qint64 bytesSent, qint64 totalBytes)
 {
     // uploadedSize corresponds to total bytes enqueued (including current chunk upload)
     qint64 totalUploaded = uploadedSize - totalBytes + bytesSent;
-    q->emitProgress(totalUploaded, totalUploadSize);
+    Q_EMIT q->uploadProgress(q, totalUploaded, totalUploadSize);
+
+    // Job::progress() only takes int, scale the values down for files over 2 GiB
+    qint64 total = totalUploadSize;
+    while (total > std::numeric_limits<int>::max()) {
+        total /= 1024;
+        totalUploaded /= 1024;
+    }
+    q->emitProgress(static_cast<int>(totalUploaded), static_cast<int>(total));
 }
 
 FileAbstractResumableJob::FileAbstractResumableJob(const AccountPtr &account, QObject *parent)
@@ -215,14 +488,18 @@ FileAbstractResumableJob::FileAbstractResumableJob(QIODevice *device, const File
     d->metaData = metadata;
 }
 
-FileAbstractResumableJob::~FileAbstractResumableJob() = default;
+FileAbstractResumableJob::~FileAbstractResumableJob()
+{
+    // Hashing posts its result to this object, it must not outlive it
+    d->hashPool.waitForDone();
+}
 
 FilePtr FileAbstractResumableJob::metadata() const
 {
     return d->metaData;
 }
 
-void FileAbstractResumableJob::setUploadSize(int size)
+void FileAbstractResumableJob::setUploadSize(qint64 size)
 {
     if (isRunning()) {
         qCWarning(KGAPIDebug) << "Can't set upload size when the job is already running";
@@ -232,6 +509,56 @@ void FileAbstractResumableJob::setUploadSize(int size)
     d->totalUploadSize = size;
 }
 
+qint64 FileAbstractResumableJob::uploadSize() const
+{
+    return d->totalUploadSize;
+}
+
+void FileAbstractResumableJob::setChunkSize(qint64 size)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify chunkSize property when job is running";
+        return;
+    }
+
+    d->chunkSize = qMin(ChunkSizing::roundToGranularity(size), MaximumChunkSize);
+}
+
+qint64 FileAbstractResumableJob::chunkSize() const
+{
+    return d->chunkSize;
+}
+
+void FileAbstractResumableJob::setAdaptiveChunkSize(bool adaptive)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify adaptiveChunkSize property when job is running";
+        return;
+    }
+
+    d->adaptiveChunkSize = adaptive;
+}
+
+bool FileAbstractResumableJob::adaptiveChunkSize() const
+{
+    return d->adaptiveChunkSize;
+}
+
+void FileAbstractResumableJob::setMaximumChunkSize(qint64 size)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify maximumChunkSize property when job is running";
+        return;
+    }
+
+    d->maximumChunkSize = qMin(ChunkSizing::roundToGranularity(size), MaximumChunkSize);
+}
+
+qint64 FileAbstractResumableJob::maximumChunkSize() const
+{
+    return d->maximumChunkSize;
+}
+
 void FileAbstractResumableJob::write(const QByteArray &data)
 {
     qCDebug(KGAPIDebug) << "Received" << data.size() << "bytes to upload";
@@ -242,40 +569,90 @@ void FileAbstractResumableJob::write(const QByteArray &data)
         return;
     }
 
-    int pos = 0;
-    // Might need to add to last chunk
-    if (!d->chunks.isEmpty() && d->chunks.last().size() < ChunkSize) {
-        QByteArray lastChunk = d->chunks.takeLast();
-        int missing = ChunkSize - lastChunk.size();
-        qCDebug(KGAPIDebug) << "Previous last chunk was" << lastChunk.size() << "bytes and could use" << missing << "bytes more, adding to it";
-        lastChunk.append(data.mid(0, missing));
-        pos = missing;
-        d->chunks << lastChunk;
+    d->appendData(data);
+}
+
+QUrl FileAbstractResumableJob::uploadSession() const
+{
+    return QUrl(d->sessionPath);
+}
+
+void FileAbstractResumableJob::setUploadSession(const QUrl &sessionUrl)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify uploadSession property when job is running";
+        return;
     }
 
-    int dataSize = data.size();
-    QList<QByteArray> chunks;
-    while (pos < dataSize) {
-        QByteArray chunk = data.mid(pos, ChunkSize);
-        chunks << chunk;
-        pos += chunk.size();
+    d->sessionPath = sessionUrl.toString();
+    d->resumeSession = !d->sessionPath.isEmpty();
+}
+
+qint64 FileAbstractResumableJob::uploadedSize() const
+{
+    return d->uploadedSize;
+}
+
+void FileAbstractResumableJob::setDeduplicate(bool deduplicate)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify deduplicate property when job is running";
+        return;
     }
 
-    qCDebug(KGAPIDebug) << "Added" << chunks.size() << "new chunks";
-    d->chunks << chunks;
+    d->deduplicate = deduplicate;
+}
+
+bool FileAbstractResumableJob::deduplicate() const
+{
+    return d->deduplicate;
+}
+
+void FileAbstractResumableJob::setHashIndex(const FileHashIndex &index)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify hashIndex property when job is running";
+        return;
+    }
+
+    d->hashIndex = index;
+}
+
+FileHashIndex FileAbstractResumableJob::hashIndex() const
+{
+    return d->hashIndex;
+}
+
+bool FileAbstractResumableJob::isDeduplicated() const
+{
+    return d->deduplicated;
 }
 
 void FileAbstractResumableJob::start()
 {
-    if (d->device) {
-        d->readFromDevice();
+    d->recoveryAttempts = 0;
+    d->queryingStatus = false;
+    d->inFlight.clear();
+    d->inFlightOffset = 0;
+    d->bytesToSkip = 0;
+    d->deviceOffset = d->device ? d->device->pos() : 0;
+    d->deduplicated = false;
+
+    if (d->resumeSession) {
+        // Ask the server how much of the data from a previous run it has
+        d->sessionState = Private::Started;
+        d->queryUploadStatus();
+        return;
     }
-    // Ask for more chunks right away in case
-    // write() wasn't called before starting
-    if (d->chunks.isEmpty()) {
-        emitReadyWrite();
+
+    // Only content of a seekable device can be checked before it's uploaded
+    if (d->deduplicate && d->device && !d->device->isSequential()) {
+        // Continues once the content is hashed
+        d->hashDevice();
+        return;
     }
-    d->processNext();
+
+    d->startUpload();
 }
 
 void FileAbstractResumableJob::dispatchRequest(QNetworkAccessManager *accessManager,
@@ -285,9 +662,19 @@ void FileAbstractResumableJob::dispatchRequest(QNetworkAccessManager *accessMana
 {
     Q_UNUSED(contentType)
 
+    d->requestTimer.start();
+
     QNetworkReply *reply;
     if (d->sessionState == Private::ReadyStart) {
         reply = accessManager->post(request, data);
+    } else if (!data.isEmpty()) {
+        // Let the bandwidth limiter pace sending of the chunk
+        auto body = new UploadBodyDevice;
+        body->appendData(data);
+        body->setThrottle(account() ? account()->accountName() : QString(), transferPriority());
+        body->open(QIODevice::ReadOnly);
+        reply = accessManager->put(request, body);
+        body->setParent(reply);
     } else {
         reply = accessManager->put(request, data);
     }
@@ -299,9 +686,28 @@ void FileAbstractResumableJob::dispatchRequest(QNetworkAccessManager *accessMana
     }
 }
 
+bool FileAbstractResumableJob::handleError(int statusCode, const QByteArray &rawData)
+{
+    // Server errors can interrupt the upload at any point, find out where to continue
+    if (statusCode >= KGAPI2::InternalError && d->recover()) {
+        return true;
+    }
+
+    return FileAbstractDataJob::handleError(statusCode, rawData);
+}
+
 void FileAbstractResumableJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
 {
-    Q_UNUSED(rawData)
+    const qint64 elapsed = d->requestTimer.isValid() ? d->requestTimer.elapsed() : 0;
+    if (d->inFlight.isEmpty() || d->queryingStatus) {
+        // Requests without a body give a good estimate of the round-trip time
+        d->roundTripTime = elapsed;
+    }
+
+    if (d->queryingStatus) {
+        d->handleStatusReply(reply, rawData);
+        return;
+    }
 
     int replyCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
 
@@ -319,6 +725,7 @@ void FileAbstractResumableJob::handleReply(const QNetworkReply *reply, const QBy
         qCDebug(KGAPIDebug) << "Got upload session location" << uploadLocation;
         d->sessionPath = uploadLocation;
         d->sessionState = Private::Started;
+        Q_EMIT uploadSessionStarted(this, QUrl(uploadLocation));
         break;
     }
     case Private::Started: {
@@ -330,10 +737,16 @@ void FileAbstractResumableJob::handleReply(const QNetworkReply *reply, const QBy
             ContentType ct = Utils::stringToContentType(contentType);
             if (ct == KGAPI2::JSON) {
                 d->metaData = File::fromJSON(rawData);
+                d->hashIndex.addFile(d->metaData);
             }
             return;
         }
 
+        // No HTTP status means the connection broke down
+        if (replyCode == 0 && d->recover()) {
+            return;
+        }
+
         // Google will continue answering ResumeIncomplete until the total upload size is declared
         // in the Content-Range header or until last upload range not total upload size.
         if (replyCode != KGAPI2::ResumeIncomplete) {
@@ -344,19 +757,30 @@ void FileAbstractResumableJob::handleReply(const QNetworkReply *reply, const QBy
             return;
         }
 
-        // Server could send us a new upload session location any time, use it if present
-        const QString newUploadLocation = reply->header(QNetworkRequest::LocationHeader).toString();
-        if (!newUploadLocation.isEmpty()) {
-            qCDebug(KGAPIDebug) << "Got new location" << newUploadLocation;
-            d->sessionPath = newUploadLocation;
+        const qint64 sentSize = d->inFlight.size();
+        const qint64 sentEnd = d->inFlightOffset + sentSize;
+        if (!d->resumeFrom(reply)) {
+            return;
+        }
+        d->recoveryAttempts = 0;
+        // Only a chunk that was persisted as a whole says something about the throughput
+        if (d->uploadedSize == sentEnd) {
+            d->adaptChunkSize(sentSize, elapsed - d->roundTripTime);
         }
-
-        const QString readRange = QString::fromUtf8(reply->rawHeader(QStringLiteral("Range").toUtf8()));
-        qCDebug(KGAPIDebug) << "Server confirms range" << readRange;
         break;
     }
     case Private::ClientEnough:
     case Private::Completed:
+        if (replyCode == 0 && d->recover()) {
+            return;
+        }
+        if (replyCode == KGAPI2::ResumeIncomplete) {
+            // Not the last chunk, or the server did not persist all of it
+            if (!d->resumeFrom(reply)) {
+                return;
+            }
+            break;
+        }
         if (replyCode != KGAPI2::OK) {
             qCWarning(KGAPIDebug) << "Failed completing upload session" << replyCode;
             setError(KGAPI2::UnknownError);
@@ -368,6 +792,7 @@ void FileAbstractResumableJob::handleReply(const QNetworkReply *reply, const QBy
         ContentType ct = Utils::stringToContentType(contentType);
         if (ct == KGAPI2::JSON) {
             d->metaData = File::fromJSON(rawData);
+            d->hashIndex.addFile(d->metaData);
         }
         break;
     }
@@ -375,6 +800,11 @@ void FileAbstractResumableJob::handleReply(const QNetworkReply *reply, const QBy
     d->processNext();
 }
 
+QString FileAbstractResumableJob::targetFileId() const
+{
+    return QString();
+}
+
 void FileAbstractResumableJob::emitReadyWrite()
 {
     Q_EMIT readyWrite(this);
@@ -11,6 +11,7 @@
 #include "account.h"
 #include "file.h"
 #include "fileabstractdatajob.h"
+#include "filehashindex.h"
 #include "kgapidrive_export.h"
 
 namespace KGAPI2
@@ -32,6 +33,11 @@ namespace Drive
  * Writing 0 bytes will indicate that the File has been completely transferred
  * and the Job will close the upload session.
  *
+ * When a chunk upload is interrupted by a network or server error, the Job
+ * asks the server how many bytes it has persisted and continues from there.
+ * The session URL can be stored and passed to setUploadSession() of a new
+ * Job to continue an upload started by another process.
+ *
  * @see <a href="https://developers.google.com/drive/api/v2/manage-uploads#resumable">Perform a resumable upload</a>
  * @see readyWrite, write
  *
@@ -95,9 +101,49 @@ public:
 
     /**
      * @brief Sets the total upload size and is required for progress reporting
-     * via the Job::progress() signal.
+     * via the Job::progress() and uploadProgress() signals.
+     *
+     * Job::progress() only carries int values, for uploads over 2 GiB the
+     * values are scaled down. Use uploadProgress() to get exact byte counts.
+     */
+    void setUploadSize(qint64 size);
+    [[nodiscard]] qint64 uploadSize() const;
+
+    /**
+     * @brief Sets size of the uploaded chunks
+     *
+     * Every chunk is uploaded in a separate request, so bigger chunks reduce
+     * the number of round-trips, at the cost of memory and of more data to
+     * re-send when a chunk fails. The size is rounded up to a multiple of
+     * 256 KiB as required by Google and limited to 64 MiB. Defaults to 256 KiB.
+     *
+     * @since 6.9.0
+     */
+    void setChunkSize(qint64 size);
+    [[nodiscard]] qint64 chunkSize() const;
+
+    /**
+     * @brief Sets whether the chunk size should adapt to the connection
+     *
+     * When enabled the Job measures throughput and round-trip time of the
+     * uploaded chunks and grows the chunk size, starting from chunkSize(),
+     * until uploading a chunk takes several round-trips, up to
+     * maximumChunkSize(). Disabled by default.
+     *
+     * @since 6.9.0
+     */
+    void setAdaptiveChunkSize(bool adaptive);
+    [[nodiscard]] bool adaptiveChunkSize() const;
+
+    /**
+     * @brief Sets the upper limit of the chunk size in adaptive mode
+     *
+     * Defaults to 64 MiB, which is also the largest allowed value.
+     *
+     * @since 6.9.0
      */
-    void setUploadSize(int size);
+    void setMaximumChunkSize(qint64 size);
+    [[nodiscard]] qint64 maximumChunkSize() const;
 
     /**
      * @brief This function writes all the bytes in \p data to the upload session.
@@ -116,6 +162,68 @@ public:
      */
     void write(const QByteArray &data);
 
+    /**
+     * @brief Returns URL of the upload session
+     *
+     * The URL is known once uploadSessionStarted() has been emitted. Together
+     * with the data it can be used to resume the upload in a new Job.
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] QUrl uploadSession() const;
+
+    /**
+     * @brief Continues upload in an existing upload session
+     *
+     * Instead of opening a new session the Job asks the server for the amount
+     * of data it has already received and uploads only the rest. If the Job
+     * was constructed with a seekable device it seeks past the persisted
+     * data, otherwise the beginning of the data passed to write() is skipped,
+     * so the data must always be provided from the start.
+     *
+     * Upload sessions expire after about a week.
+     *
+     * @since 6.9.0
+     */
+    void setUploadSession(const QUrl &sessionUrl);
+
+    /**
+     * @brief Returns number of bytes sent to the upload session so far
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] qint64 uploadedSize() const;
+
+    /**
+     * @brief Sets whether upload of content that already exists in Drive
+     *        should be skipped
+     * When the Job was constructed with a seekable device it computes MD5
+     * checksum of the content before opening the upload session and looks
+     * it up in hashIndex(). If a file with the same content and title exists
+     * in the target folder, or the modified file already has this content,
+     * nothing is uploaded and metadata() returns the existing file. Data
+     * passed via write() can't be checked in advance and is always uploaded.
+     * Disabled by default.
+     * @since 6.9.0
+     */
+    void setDeduplicate(bool deduplicate);
+    [[nodiscard]] bool deduplicate() const;
+
+    /**
+     * @brief Sets index of known files used for deduplication
+     * The uploaded file is added to the index once the Job finishes.
+     * @since 6.9.0
+     */
+    void setHashIndex(const FileHashIndex &index);
+    [[nodiscard]] FileHashIndex hashIndex() const;
+
+    /**
+     * @brief Returns whether the upload was skipped because identical content
+     *        already existed
+     * @since 6.9.0
+     */
+    [[nodiscard]] bool isDeduplicated() const;
+
 protected:
     /**
      * @brief KGAPI2::Job::start implementation
@@ -130,6 +238,14 @@ protected:
      */
     void handleReply(const QNetworkReply *reply, const QByteArray &rawData) override;
 
+    /**
+     * @brief KGAPI2::Job::handleError implementation
+     *
+     * @param statusCode
+     * @param rawData
+     */
+    bool handleError(int statusCode, const QByteArray &rawData) override;
+
     /**
      * @brief KGAPI2::Job::dispatchRequest implementation
      *
@@ -150,6 +266,13 @@ protected:
      */
     virtual QUrl createUrl() = 0;
 
+    /**
+     * @brief Returns ID of the file whose content is replaced by the upload
+     * Used by deduplication, returns an empty string for new files.
+     * @since 6.9.0
+     */
+    virtual QString targetFileId() const;
+
 Q_SIGNALS:
 
     /**
@@ -169,6 +292,25 @@ Q_SIGNALS:
      */
     void readyWrite(KGAPI2::Drive::FileAbstractResumableJob *job);
 
+    /**
+     * @brief Emitted when a new upload session has been opened
+     *
+     * The @p sessionUrl can be persisted to resume the upload later.
+     *
+     * @see setUploadSession
+     * @since 6.9.0
+     */
+    void uploadSessionStarted(KGAPI2::Drive::FileAbstractResumableJob *job, const QUrl &sessionUrl);
+
+    /**
+     * @brief Emitted when a part of the data has been uploaded
+     *
+     * Only emitted when the total size was set via setUploadSize().
+     *
+     * @since 6.9.0
+     */
+    void uploadProgress(KGAPI2::Drive::FileAbstractResumableJob *job, qint64 processed, qint64 total);
+
 private:
     class Private;
     QScopedPointer<Private> d;
@@ -7,7 +7,12 @@
  */
 
 #include "fileabstractuploadjob.h"
+#include "account.h"
 #include "debug.h"
+#include "driveservice.h"
+#include "filesearchquery.h"
+#include "parentreference.h"
+#include "uploadbodydevice_p.h"
 #include "utils.h"
 
 #include <QNetworkReply>
@@ -18,28 +23,64 @@
 #include <QFileInfo>
 #include <QMimeDatabase>
 #include <QMimeType>
+#include <QPointer>
+#include <QThreadPool>
 #include <QUrlQuery>
 
+#include <limits>
+
 using namespace KGAPI2;
 using namespace KGAPI2::Drive;
 
+namespace
+{
+static constexpr int DefaultConcurrentUploads = 4;
+// Maximum number of titles looked up in a single files query
+static constexpr int MaxLookupTitles = 50;
+static const auto LookupRequestAttribute = static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User + 1);
+}
+
 class Q_DECL_HIDDEN FileAbstractUploadJob::Private
 {
 public:
     Private(FileAbstractUploadJob *parent);
     void processNext();
-    QByteArray buildMultipart(const QString &filePath, const FilePtr &metaData, QString &boundary);
-    QByteArray readFile(const QString &filePath, QString &contentType);
+    bool enqueueFile(const QString &filePath, const FilePtr &metaData);
+    UploadBodyDevice *buildMultipart(const QString &filePath, const FilePtr &metaData, QString &boundary);
+    UploadBodyDevice *openFile(const QString &filePath, QString &contentType);
 
-    void _k_uploadProgress(qint64 bytesSent, qint64 totalBytes);
+    void updateProgress(const QString &filePath, qint64 bytesSent);
+
+    void hashFiles();
+    void lookupDuplicates();
+    void enqueueLookup(const QString &parentId, const QStringList &titles);
+    FilePtr findDuplicate(const QString &filePath, const FilePtr &metaData);
 
-    int originalFilesCount = 0;
     QMap<QString, FilePtr> files;
+    // Files waiting for upload, filled from files when the job starts
+    QMap<QString, FilePtr> pendingFiles;
 
     QMap<QString, FilePtr> uploadedFiles;
 
     File::SerializationOptions serializationOptions = File::NoOptions;
 
+    // Content of the files currently being uploaded, streamed from disk
+    QHash<QString /* file path */, QPointer<UploadBodyDevice>> bodies;
+    int uploadsInFlight = 0;
+
+    // Byte-accurate progress over all files
+    QHash<QString /* file path */, qint64> fileSizes;
+    QHash<QString /* file path */, qint64> bytesSent;
+    qint64 totalBytes = 0;
+    qint64 processedBytes = 0;
+
+    bool deduplicate = false;
+    FileHashIndex hashIndex;
+    QHash<QString /* file path */, QString /* checksum */> checksums;
+    QStringList deduplicatedFiles;
+    int lookupsInFlight = 0;
+    QThreadPool hashPool;
+
 private:
     FileAbstractUploadJob *const q;
 };
@@ -47,14 +88,18 @@ private:
 FileAbstractUploadJob::Private::Private(FileAbstractUploadJob *parent)
     : q(parent)
 {
+    q->setMaxConcurrentRequests(DefaultConcurrentUploads);
 }
 
-QByteArray FileAbstractUploadJob::Private::readFile(const QString &filePath, QString &contentType)
+UploadBodyDevice *FileAbstractUploadJob::Private::openFile(const QString &filePath, QString &contentType)
 {
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly)) {
         qCWarning(KGAPIDebug) << "Failed to access" << filePath;
-        return QByteArray();
+        return nullptr;
+    }
+    if (file.size() == 0) {
+        return nullptr;
     }
 
     if (contentType.isEmpty()) {
@@ -63,65 +108,82 @@ QByteArray FileAbstractUploadJob::Private::readFile(const QString &filePath, QSt
         contentType = mime.name();
         qCDebug(KGAPIDebug) << "Determined content type" << contentType << "for" << filePath;
     }
-
-    file.reset();
-    QByteArray output = file.readAll();
-
     file.close();
 
-    return output;
+    auto device = new UploadBodyDevice(q);
+    if (!device->appendFile(filePath)) {
+        delete device;
+        return nullptr;
+    }
+
+    return device;
 }
 
-QByteArray FileAbstractUploadJob::Private::buildMultipart(const QString &filePath, const FilePtr &metaData, QString &boundary)
+UploadBodyDevice *FileAbstractUploadJob::Private::buildMultipart(const QString &filePath, const FilePtr &metaData, QString &boundary)
 {
     QString fileContentType = metaData->mimeType();
-    QByteArray fileContent;
-
-    fileContent = readFile(filePath, fileContentType);
-    if (fileContent.isEmpty()) {
-        return QByteArray();
+    UploadBodyDevice *body = openFile(filePath, fileContentType);
+    if (!body) {
+        return nullptr;
     }
 
     qCDebug(KGAPIDebug) << "Setting content type" << fileContentType << "for" << filePath;
 
     // Wannabe implementation of RFC2387, i.e. multipart/related
-    QByteArray body;
     QFileInfo finfo(filePath);
     const QByteArray md5 = QCryptographicHash::hash(finfo.fileName().toLatin1(), QCryptographicHash::Md5);
     boundary = QString::fromLatin1(md5.toHex());
 
-    body += "--" + boundary.toLatin1() + '\n';
-    body += "Content-Type: application/json; charset=UTF-8\n";
-    body += '\n';
-    body += File::toJSON(metaData, q->serializationOptions());
-    body += '\n';
-    body += '\n';
-    body += "--" + boundary.toLatin1() + '\n';
-    body += "Content-Type: " + fileContentType.toLatin1() + '\n';
-    body += '\n';
-    body += fileContent;
-    body += '\n';
-    body += "--" + boundary.toLatin1() + "--";
+    QByteArray header;
+    header += "--" + boundary.toLatin1() + '\n';
+    header += "Content-Type: application/json; charset=UTF-8\n";
+    header += '\n';
+    header += File::toJSON(metaData, q->serializationOptions());
+    header += '\n';
+    header += '\n';
+    header += "--" + boundary.toLatin1() + '\n';
+    header += "Content-Type: " + fileContentType.toLatin1() + '\n';
+    header += '\n';
+
+    // The file content itself is only read from disk while the request is being sent
+    body->prependData(header);
+    body->appendData("\n--" + boundary.toLatin1() + "--");
 
     return body;
 }
 
 void FileAbstractUploadJob::Private::processNext()
 {
-    if (files.isEmpty()) {
+    const int window = q->maxConcurrentRequests() > 0 ? q->maxConcurrentRequests() : std::numeric_limits<int>::max();
+    while (uploadsInFlight < window && !pendingFiles.isEmpty()) {
+        const QString filePath = pendingFiles.cbegin().key();
+        const FilePtr metaData = pendingFiles.take(filePath);
+        if (deduplicate) {
+            if (const FilePtr existing = findDuplicate(filePath, metaData)) {
+                qCDebug(KGAPIDebug) << filePath << "already exists as" << existing->id() << ", skipping upload";
+                uploadedFiles.insert(filePath, existing);
+                deduplicatedFiles.append(filePath);
+                updateProgress(filePath, fileSizes.value(filePath));
+                continue;
+            }
+        }
+        if (enqueueFile(filePath, metaData)) {
+            ++uploadsInFlight;
+        }
+    }
+
+    if (uploadsInFlight == 0) {
         q->emitFinished();
-        return;
     }
+}
 
-    const QString filePath = files.cbegin().key();
+bool FileAbstractUploadJob::Private::enqueueFile(const QString &filePath, const FilePtr &metaData)
+{
     if (!filePath.startsWith(QLatin1StringView("?=")) && !QFile::exists(filePath)) {
         qCWarning(KGAPIDebug) << filePath << "is not a valid file path";
-        processNext();
-        return;
+        return false;
     }
 
-    const FilePtr metaData = files.take(filePath);
-
     QUrl url;
     if (filePath.startsWith(QLatin1StringView("?="))) {
         url = q->createUrl(QString(), metaData);
@@ -134,28 +196,27 @@ void FileAbstractUploadJob::Private::processNext()
 
     QByteArray rawData;
     QString contentType;
+    UploadBodyDevice *body = nullptr;
 
     // just to be sure
     query.removeQueryItem(QStringLiteral("uploadType"));
     if (metaData.isNull()) {
         query.addQueryItem(QStringLiteral("uploadType"), QStringLiteral("media"));
 
-        rawData = readFile(filePath, contentType);
-        if (rawData.isEmpty()) {
-            processNext();
-            return;
+        body = openFile(filePath, contentType);
+        if (!body) {
+            return false;
         }
 
     } else if (!filePath.startsWith(QLatin1StringView("?="))) {
         query.addQueryItem(QStringLiteral("uploadType"), QStringLiteral("multipart"));
 
         QString boundary;
-        rawData = buildMultipart(filePath, metaData, boundary);
+        body = buildMultipart(filePath, metaData, boundary);
 
         contentType = QStringLiteral("multipart/related; boundary=%1").arg(boundary);
-        if (rawData.isEmpty()) {
-            processNext();
-            return;
+        if (!body) {
+            return false;
         }
     } else {
         rawData = File::toJSON(metaData, q->serializationOptions());
@@ -165,22 +226,163 @@ void FileAbstractUploadJob::Private::processNext()
     url.setQuery(query);
 
     QNetworkRequest request(url);
-    request.setHeader(QNetworkRequest::ContentLengthHeader, rawData.length());
+    request.setHeader(QNetworkRequest::ContentLengthHeader, body ? body->size() : rawData.length());
     request.setHeader(QNetworkRequest::ContentTypeHeader, contentType);
     request.setAttribute(QNetworkRequest::User, filePath);
 
+    bodies.insert(filePath, body);
     q->enqueueRequest(request, rawData, contentType);
+    return true;
+}
+
+void FileAbstractUploadJob::Private::updateProgress(const QString &filePath, qint64 sent)
+{
+    if (totalBytes <= 0) {
+        // Nothing but metadata to upload, count the files instead
+        q->emitProgress(uploadedFiles.size(), files.size());
+        return;
+    }
+
+    // Multipart bodies are slightly bigger than the file itself, count at most the file size
+    const qint64 previous = bytesSent.value(filePath);
+    const qint64 current = qMin(sent, fileSizes.value(filePath));
+    bytesSent.insert(filePath, current);
+    processedBytes += current - previous;
+
+    // Job::progress() only takes int, scale the values down for uploads over 2 GiB
+    qint64 processed = processedBytes;
+    qint64 total = totalBytes;
+    while (total > std::numeric_limits<int>::max()) {
+        processed /= 1024;
+        total /= 1024;
+    }
+    q->emitProgress(static_cast<int>(processed), static_cast<int>(total));
+}
+
+void FileAbstractUploadJob::Private::hashFiles()
+{
+    QStringList filePaths;
+    for (auto it = files.cbegin(), end = files.cend(); it != end; ++it) {
+        if (!it.key().startsWith(QLatin1StringView("?="))) {
+            filePaths.append(it.key());
+        }
+    }
+
+    // Hashing reads the whole files, keep it off the event loop
+    hashPool.start([this, filePaths]() {
+        QHash<QString, QString> result;
+        for (const QString &filePath : filePaths) {
+            result.insert(filePath, FileHashIndex::md5Checksum(filePath));
+        }
+        QMetaObject::invokeMethod(
+            q,
+            [this, result]() {
+                if (!q->isRunning()) {
+                    return;
+                }
+                checksums = result;
+                lookupDuplicates();
+                // Uploads start once we know what is already in Drive
+                if (lookupsInFlight == 0) {
+                    processNext();
+                }
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+void FileAbstractUploadJob::Private::lookupDuplicates()
+{
+    // Look up all the files that will be uploaded into the same folder in a single query
+    QMap<QString /* parent ID */, QStringList /* titles */> lookups;
+    for (auto it = files.cbegin(), end = files.cend(); it != end; ++it) {
+        const FilePtr &metaData = it.value();
+        if (it.key().startsWith(QLatin1StringView("?=")) || !metaData || metaData->title().isEmpty() || !q->targetFileId(it.key()).isEmpty()) {
+            continue;
+        }
+
+        const QString checksum = checksums.value(it.key());
+        if (checksum.isEmpty()) {
+            continue;
+        }
+
+        // Files without parents are never considered duplicates
+        const auto parents = metaData->parents();
+        for (const ParentReferencePtr &parent : parents) {
+            if (parent && !parent->id().isEmpty() && !hashIndex.find(checksum, parent->id(), metaData->title())) {
+                lookups[parent->id()].append(metaData->title());
+            }
+        }
+    }
+
+    for (auto it = lookups.cbegin(), end = lookups.cend(); it != end; ++it) {
+        for (qsizetype i = 0; i < it.value().size(); i += MaxLookupTitles) {
+            enqueueLookup(it.key(), it.value().mid(i, MaxLookupTitles));
+        }
+    }
+}
+
+void FileAbstractUploadJob::Private::enqueueLookup(const QString &parentId, const QStringList &titles)
+{
+    FileSearchQuery titlesQuery(FileSearchQuery::Or);
+    for (const QString &title : titles) {
+        titlesQuery.addQuery(FileSearchQuery::Title, FileSearchQuery::Equals, title);
+    }
+
+    FileSearchQuery searchQuery;
+    searchQuery.addQuery(FileSearchQuery::Parents, FileSearchQuery::In, parentId);
+    searchQuery.addQuery(FileSearchQuery::Trashed, FileSearchQuery::Equals, false);
+    searchQuery.addQuery(titlesQuery);
+
+    QUrl url = DriveService::fetchFilesUrl();
+    QUrlQuery query(url);
+    query.addQueryItem(QStringLiteral("q"), searchQuery.serialize());
+    query.addQueryItem(QStringLiteral("includeItemsFromAllDrives"), Utils::bool2Str(q->supportsAllDrives()));
+    query.addQueryItem(QStringLiteral("supportsAllDrives"), Utils::bool2Str(q->supportsAllDrives()));
+    url.setQuery(query);
+
+    QNetworkRequest request(url);
+    request.setAttribute(LookupRequestAttribute, true);
+    q->enqueueRequest(request);
+    ++lookupsInFlight;
 }
 
-void FileAbstractUploadJob::Private::_k_uploadProgress(qint64 bytesSent, qint64 totalBytes)
+FilePtr FileAbstractUploadJob::Private::findDuplicate(const QString &filePath, const FilePtr &metaData)
 {
-    // Each file consists of 100 units, so if we have two files, one already
-    // uploaded and the other one uploaded from 50%, the values are (150, 200)
+    if (filePath.startsWith(QLatin1StringView("?="))) {
+        return FilePtr();
+    }
 
-    int processedParts = (originalFilesCount - files.count() - 1) * 100;
-    int currentFileParts = 100.0 * ((qreal)bytesSent / (qreal)totalBytes);
+    // All files were hashed when the job started
+    const QString checksum = checksums.value(filePath);
+    if (checksum.isEmpty()) {
+        return FilePtr();
+    }
+
+    // Modifying an existing file, skip the upload if the content has not changed
+    const QString fileId = q->targetFileId(filePath);
+    if (!fileId.isEmpty()) {
+        const FilePtr current = hashIndex.file(fileId);
+        if (current && current->md5Checksum().compare(checksum, Qt::CaseInsensitive) == 0) {
+            return current;
+        }
+        return FilePtr();
+    }
 
-    q->emitProgress(processedParts + currentFileParts, originalFilesCount * 100);
+    // Drive assigns new files an ID, only the title and the parents identify a duplicate
+    if (!metaData) {
+        return FilePtr();
+    }
+    const auto parents = metaData->parents();
+    for (const ParentReferencePtr &parent : parents) {
+        if (!parent) {
+            continue;
+        }
+        if (const FilePtr existing = hashIndex.find(checksum, parent->id(), metaData->title())) {
+            return existing;
+        }
+    }
+    return FilePtr();
 }
 
 FileAbstractUploadJob::FileAbstractUploadJob(const FilePtr &metadata, const AccountPtr &account, QObject *parent)
@@ -188,7 +390,6 @@ FileAbstractUploadJob::FileAbstractUploadJob(const FilePtr &metadata, const Acco
     , d(new Private(this))
 {
     d->files.insert(QStringLiteral("?=0"), metadata);
-    d->originalFilesCount = 1;
 }
 
 FileAbstractUploadJob::FileAbstractUploadJob(const FilesList &metadata, const AccountPtr &account, QObject *parent)
@@ -200,7 +401,6 @@ FileAbstractUploadJob::FileAbstractUploadJob(const FilesList &metadata, const Ac
         d->files.insert(QStringLiteral("?=%1").arg(i), file);
         ++i;
     }
-    d->originalFilesCount = d->files.count();
 }
 
 FileAbstractUploadJob::FileAbstractUploadJob(const QString &filePath, const AccountPtr &account, QObject *parent)
@@ -208,7 +408,6 @@ FileAbstractUploadJob::FileAbstractUploadJob(const QString &filePath, const Acco
     , d(new Private(this))
 {
     d->files.insert(filePath, FilePtr());
-    d->originalFilesCount = 1;
 }
 
 FileAbstractUploadJob::FileAbstractUploadJob(const QString &filePath, const FilePtr &metaData, const AccountPtr &account, QObject *parent)
@@ -216,7 +415,6 @@ FileAbstractUploadJob::FileAbstractUploadJob(const QString &filePath, const File
     , d(new Private(this))
 {
     d->files.insert(filePath, metaData);
-    d->originalFilesCount = 1;
 }
 
 FileAbstractUploadJob::FileAbstractUploadJob(const QStringList &filePaths, const AccountPtr &account, QObject *parent)
@@ -226,7 +424,6 @@ FileAbstractUploadJob::FileAbstractUploadJob(const QStringList &filePaths, const
     for (const QString &filePath : filePaths) {
         d->files.insert(filePath, FilePtr());
     }
-    d->originalFilesCount = d->files.count();
 }
 
 FileAbstractUploadJob::FileAbstractUploadJob(const QMap<QString, FilePtr> &files, const AccountPtr &account, QObject *parent)
@@ -234,16 +431,40 @@ FileAbstractUploadJob::FileAbstractUploadJob(const QMap<QString, FilePtr> &files
     , d(new Private(this))
 {
     d->files = files;
-    d->originalFilesCount = d->files.count();
 }
 
 FileAbstractUploadJob::~FileAbstractUploadJob()
 {
+    // Hashing posts its result to this object, it must not outlive it
+    d->hashPool.waitForDone();
     delete d;
 }
 
 void FileAbstractUploadJob::start()
 {
+    d->pendingFiles = d->files;
+    d->uploadsInFlight = 0;
+    d->fileSizes.clear();
+    d->bytesSent.clear();
+    d->processedBytes = 0;
+    d->totalBytes = 0;
+    for (auto it = d->files.cbegin(), end = d->files.cend(); it != end; ++it) {
+        if (!it.key().startsWith(QLatin1StringView("?="))) {
+            const qint64 size = QFileInfo(it.key()).size();
+            d->fileSizes.insert(it.key(), size);
+            d->totalBytes += size;
+        }
+    }
+
+    d->checksums.clear();
+    d->deduplicatedFiles.clear();
+    d->lookupsInFlight = 0;
+    if (d->deduplicate) {
+        // Continues once the files are hashed
+        d->hashFiles();
+        return;
+    }
+
     d->processNext();
 }
 
@@ -252,6 +473,41 @@ QMap<QString, FilePtr> FileAbstractUploadJob::files() const
     return d->uploadedFiles;
 }
 
+void FileAbstractUploadJob::setDeduplicate(bool deduplicate)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify deduplicate property when job is running";
+        return;
+    }
+
+    d->deduplicate = deduplicate;
+}
+
+bool FileAbstractUploadJob::deduplicate() const
+{
+    return d->deduplicate;
+}
+
+void FileAbstractUploadJob::setHashIndex(const FileHashIndex &index)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify hashIndex property when job is running";
+        return;
+    }
+
+    d->hashIndex = index;
+}
+
+FileHashIndex FileAbstractUploadJob::hashIndex() const
+{
+    return d->hashIndex;
+}
+
+QStringList FileAbstractUploadJob::deduplicatedFiles() const
+{
+    return d->deduplicatedFiles;
+}
+
 void FileAbstractUploadJob::dispatchRequest(QNetworkAccessManager *accessManager,
                                             const QNetworkRequest &request,
                                             const QByteArray &data,
@@ -259,24 +515,61 @@ void FileAbstractUploadJob::dispatchRequest(QNetworkAccessManager *accessManager
 {
     Q_UNUSED(contentType)
 
-    QNetworkReply *reply = dispatch(accessManager, request, data);
+    if (request.attribute(LookupRequestAttribute).toBool()) {
+        accessManager->get(request);
+        return;
+    }
 
-    connect(reply, &QNetworkReply::uploadProgress, this, [this](qint64 bytesSent, qint64 totalBytes) {
-        d->_k_uploadProgress(bytesSent, totalBytes);
+    const QString filePath = request.attribute(QNetworkRequest::User).toString();
+    UploadBodyDevice *body = d->bodies.value(filePath);
+
+    QNetworkReply *reply = nullptr;
+    if (body) {
+        // (Re)start streaming the body from the beginning, the request may be a retry
+        if (!body->isOpen()) {
+            body->open(QIODevice::ReadOnly);
+        }
+        body->seek(0);
+        body->setThrottle(account() ? account()->accountName() : QString(), transferPriority());
+        reply = dispatchBody(accessManager, request, body);
+    } else {
+        reply = dispatch(accessManager, request, data);
+    }
+
+    connect(reply, &QNetworkReply::uploadProgress, this, [this, filePath](qint64 bytesSent, qint64 totalBytes) {
+        Q_UNUSED(totalBytes)
+        d->updateProgress(filePath, bytesSent);
     });
 }
 
 void FileAbstractUploadJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
 {
+    const QNetworkRequest request = reply->request();
+    if (request.attribute(LookupRequestAttribute).toBool()) {
+        FeedData feedData;
+        d->hashIndex.addFiles(File::fromJSONFeed(rawData, feedData));
+        if (feedData.nextPageUrl.isValid()) {
+            QNetworkRequest nextRequest(feedData.nextPageUrl);
+            nextRequest.setAttribute(LookupRequestAttribute, true);
+            enqueueRequest(nextRequest);
+        } else if (--d->lookupsInFlight == 0) {
+            d->processNext();
+        }
+        return;
+    }
+
+    const QString filePath = request.attribute(QNetworkRequest::User).toString();
+    delete d->bodies.take(filePath);
+    --d->uploadsInFlight;
+
     const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
     ContentType ct = Utils::stringToContentType(contentType);
     if (ct == KGAPI2::JSON) {
-        const QNetworkRequest request = reply->request();
-        const QString filePath = request.attribute(QNetworkRequest::User).toString();
-
         FilePtr file = File::fromJSON(rawData);
 
         d->uploadedFiles.insert(filePath, file);
+        d->hashIndex.addFile(file);
+        d->updateProgress(filePath, d->fileSizes.value(filePath));
     } else {
         setError(KGAPI2::InvalidResponse);
         setErrorString(tr("Invalid response content type"));
@@ -287,6 +580,17 @@ void FileAbstractUploadJob::handleReply(const QNetworkReply *reply, const QByteA
     d->processNext();
 }
 
+QNetworkReply *FileAbstractUploadJob::dispatchBody(QNetworkAccessManager *accessManager, const QNetworkRequest &request, QIODevice *body)
+{
+    return accessManager->post(request, body);
+}
+
+QString FileAbstractUploadJob::targetFileId(const QString &filePath) const
+{
+    Q_UNUSED(filePath)
+    return QString();
+}
+
 void FileAbstractUploadJob::setSerializationOptions(File::SerializationOptions options)
 {
     d->serializationOptions = options;
@@ -10,11 +10,14 @@
 
 #include "file.h"
 #include "fileabstractdatajob.h"
+#include "filehashindex.h"
 #include "kgapidrive_export.h"
 
 #include <QMap>
 #include <QStringList>
 
+class QIODevice;
+
 namespace KGAPI2
 {
 
@@ -34,8 +37,48 @@ public:
     explicit FileAbstractUploadJob(const QMap<QString /* file path */, FilePtr /* metadata */> &files, const AccountPtr &account, QObject *parent = nullptr);
     ~FileAbstractUploadJob() override;
 
+    /**
+     * @brief Returns the uploaded files, keyed by their local file path
+     *
+     * Files are uploaded concurrently, at most Job::maxConcurrentRequests()
+     * (4 by default) at a time.
+     */
     QMap<QString /* file path */, FilePtr /* metadata */> files() const;
 
+    /**
+     * @brief Sets whether files that already exist in Drive should be skipped
+     *
+     * Before uploading a file the Job computes MD5 checksum of its content and
+     * looks for a file with the same checksum and title in the target folder,
+     * first in hashIndex() and then, batched by folder, in Drive itself.
+     * When such file exists it is returned by files() instead of uploading
+     * the content again. When modifying a file the upload is skipped if its
+     * content has not changed. Disabled by default.
+     *
+     * @since 6.9.0
+     */
+    void setDeduplicate(bool deduplicate);
+    [[nodiscard]] bool deduplicate() const;
+
+    /**
+     * @brief Sets index of known files used for deduplication
+     *
+     * Once the Job finishes hashIndex() also contains the files found in Drive
+     * and the uploaded files, so it can be reused by following uploads.
+     *
+     * @since 6.9.0
+     */
+    void setHashIndex(const FileHashIndex &index);
+    [[nodiscard]] FileHashIndex hashIndex() const;
+
+    /**
+     * @brief Returns paths of the files that were not uploaded because
+     *        identical files already existed
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] QStringList deduplicatedFiles() const;
+
 protected:
     void start() override;
     void dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType) override;
@@ -43,6 +86,26 @@ protected:
 
     virtual QUrl createUrl(const QString &filePath, const FilePtr &metaData) = 0;
     virtual QNetworkReply *dispatch(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data) = 0;
+
+    /**
+     * @brief Sends @p request with content streamed from @p body
+     *
+     * Used for uploads of file content, which is read from disk only while
+     * the request is being sent. The default implementation sends a POST
+     * request.
+     *
+     * @since 6.9.0
+     */
+    virtual QNetworkReply *dispatchBody(QNetworkAccessManager *accessManager, const QNetworkRequest &request, QIODevice *body);
+
+    /**
+     * @brief Returns ID of the file whose content is replaced by upload of @p filePath
+     *
+     * Used by deduplication, returns an empty string for new files.
+     *
+     * @since 6.9.0
+     */
+    virtual QString targetFileId(const QString &filePath) const;
     void setSerializationOptions(File::SerializationOptions options);
     [[nodiscard]] File::SerializationOptions serializationOptions() const;
 
@@ -51,7 +114,6 @@ private:
     Private *const d;
     friend class Private;
 
-    Q_PRIVATE_SLOT(d, void _k_uploadProgress(qint64 uploadedBytes, qint64 totalBytes))
 };
 
 } // namespace Drive
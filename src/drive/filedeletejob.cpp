@@ -7,18 +7,29 @@
  */
 
 #include "filedeletejob.h"
+#include "debug.h"
 #include "driveservice.h"
 #include "file.h"
+#include "fileerrors_p.h"
 
 #include <QNetworkRequest>
 
 using namespace KGAPI2;
 using namespace KGAPI2::Drive;
 
+namespace
+{
+static constexpr int DefaultConcurrentRequests = 8;
+}
+
 class Q_DECL_HIDDEN FileDeleteJob::Private
 {
 public:
     QStringList filesIDs;
+    bool isMultiple = false;
+
+    FileErrors errors;
+    int processedFiles = 0;
 };
 
 FileDeleteJob::FileDeleteJob(const QString &fileId, const AccountPtr &account, QObject *parent)
@@ -33,6 +44,9 @@ FileDeleteJob::FileDeleteJob(const QStringList &filesIds, const AccountPtr &acco
     , d(new Private)
 {
     d->filesIDs << filesIds;
+    d->filesIDs.removeDuplicates();
+    d->isMultiple = true;
+    setMaxConcurrentRequests(DefaultConcurrentRequests);
 }
 
 FileDeleteJob::FileDeleteJob(const FilePtr &file, const AccountPtr &account, QObject *parent)
@@ -49,6 +63,9 @@ FileDeleteJob::FileDeleteJob(const FilesList &files, const AccountPtr &account,
     for (const FilePtr &file : std::as_const(files)) {
         d->filesIDs << file->id();
     }
+    d->filesIDs.removeDuplicates();
+    d->isMultiple = true;
+    setMaxConcurrentRequests(DefaultConcurrentRequests);
 }
 
 FileDeleteJob::~FileDeleteJob()
@@ -56,18 +73,72 @@ FileDeleteJob::~FileDeleteJob()
     delete d;
 }
 
+QStringList FileDeleteJob::failedFilesIds() const
+{
+    QStringList ids;
+    for (const QString &fileId : std::as_const(d->filesIDs)) {
+        if (d->errors.contains(fileId)) {
+            ids << fileId;
+        }
+    }
+    return ids;
+}
+
+Error FileDeleteJob::fileError(const QString &fileId) const
+{
+    return d->errors.error(fileId);
+}
+
+QString FileDeleteJob::fileErrorString(const QString &fileId) const
+{
+    return d->errors.errorString(fileId);
+}
+
 void FileDeleteJob::start()
 {
+    d->errors.clear();
+    d->processedFiles = 0;
+
     if (d->filesIDs.isEmpty()) {
         emitFinished();
         return;
     }
 
-    const QString fileId = d->filesIDs.takeFirst();
-    const QUrl url = DriveService::deleteFileUrl(fileId);
+    for (const QString &fileId : std::as_const(d->filesIDs)) {
+        QNetworkRequest request(DriveService::deleteFileUrl(fileId));
+        request.setAttribute(QNetworkRequest::User, fileId);
+        enqueueRequest(request);
+    }
+}
+
+void FileDeleteJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
+{
+    Q_UNUSED(reply)
+    Q_UNUSED(rawData)
+
+    // All requests are enqueued by start(), the job finishes once all of them are done
+    emitProgress(++d->processedFiles, d->filesIDs.size());
+    Q_EMIT fileProcessed(this, currentRequest().attribute(QNetworkRequest::User).toString());
+}
+
+bool FileDeleteJob::handleError(int statusCode, const QByteArray &rawData)
+{
+    if (!d->isMultiple) {
+        return DeleteJob::handleError(statusCode, rawData);
+    }
+
+    if (!FileErrors::isFileError(statusCode, rawData)) {
+        // Errors that are not specific to a single file abort the whole job
+        return DeleteJob::handleError(statusCode, rawData);
+    }
+
+    const QString fileId = currentRequest().attribute(QNetworkRequest::User).toString();
+    d->errors.insertReply(fileId, statusCode, rawData);
+    qCWarning(KGAPIDebug) << "Failed to delete file" << fileId << ":" << d->errors.errorString(fileId);
 
-    QNetworkRequest request(url);
-    enqueueRequest(request);
+    emitProgress(++d->processedFiles, d->filesIDs.size());
+    Q_EMIT fileProcessed(this, fileId);
+    return true;
 }
 
 #include "moc_filedeletejob.cpp"
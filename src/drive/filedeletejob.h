@@ -19,6 +19,15 @@ namespace KGAPI2
 namespace Drive
 {
 
+/**
+ * @brief Permanently deletes files, skipping the trash
+ *
+ * When the job is given a list of files, up to Job::maxConcurrentRequests()
+ * requests (8 by default) are in flight at once. A failure on one of the
+ * files then does not abort the job: it is recorded and can be checked with
+ * failedFilesIds() and fileError(). A job for a single file fails as a
+ * whole, like any other job.
+ */
 class KGAPIDRIVE_EXPORT FileDeleteJob : public KGAPI2::DeleteJob
 {
     Q_OBJECT
@@ -30,8 +39,35 @@ public:
     explicit FileDeleteJob(const FilesList &files, const AccountPtr &account, QObject *parent = nullptr);
     ~FileDeleteJob() override;
 
+    /**
+     * @brief Returns IDs of files that could not be deleted
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] QStringList failedFilesIds() const;
+
+    /**
+     * @brief Returns the error that occurred on file @p fileId
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] KGAPI2::Error fileError(const QString &fileId) const;
+    [[nodiscard]] QString fileErrorString(const QString &fileId) const;
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted as soon as file @p fileId has been processed
+     *
+     * Use fileError() to check whether it was deleted.
+     *
+     * @since 6.9.0
+     */
+    void fileProcessed(KGAPI2::Drive::FileDeleteJob *job, const QString &fileId);
+
 protected:
     void start() override;
+    void handleReply(const QNetworkReply *reply, const QByteArray &rawData) override;
+    bool handleError(int statusCode, const QByteArray &rawData) override;
 
 private:
     class Private;
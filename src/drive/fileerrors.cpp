@@ -0,0 +1,64 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "fileerrors_p.h"
+#include "utils.h"
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+bool FileErrors::isFileError(int statusCode, const QByteArray &rawData)
+{
+    switch (statusCode) {
+    case KGAPI2::BadRequest:
+    case KGAPI2::NotFound:
+    case KGAPI2::Conflict:
+    case KGAPI2::Gone:
+        return true;
+    case KGAPI2::Forbidden:
+        // Rate limits are reported as 403 as well, but only mean "not now"
+        return !Utils::isRateLimitError(rawData);
+    default:
+        return false;
+    }
+}
+
+void FileErrors::insert(const QString &key, Error error, const QString &errorString)
+{
+    mErrors.insert(key, {error, errorString});
+}
+
+void FileErrors::insertReply(const QString &key, int statusCode, const QByteArray &rawData)
+{
+    insert(key, static_cast<Error>(statusCode), Utils::parseErrorMessage(rawData));
+}
+
+void FileErrors::clear()
+{
+    mErrors.clear();
+}
+
+bool FileErrors::contains(const QString &key) const
+{
+    return mErrors.contains(key);
+}
+
+QStringList FileErrors::keys() const
+{
+    return mErrors.keys();
+}
+
+Error FileErrors::error(const QString &key) const
+{
+    return mErrors.value(key).error;
+}
+
+QString FileErrors::errorString(const QString &key) const
+{
+    return mErrors.value(key).errorString;
+}
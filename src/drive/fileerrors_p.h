@@ -0,0 +1,66 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "types.h"
+
+#include <QHash>
+#include <QString>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @internal
+ *
+ * Errors of individual files in jobs that process several files at once and
+ * carry on when some of them fail.
+ */
+class Q_DECL_HIDDEN FileErrors
+{
+public:
+    /**
+     * Returns whether an error reply with HTTP @p statusCode and body
+     * @p rawData concerns only the file the request was for. Other errors,
+     * e.g. an expired token or an exceeded rate limit, concern the whole job.
+     */
+    static bool isFileError(int statusCode, const QByteArray &rawData = QByteArray());
+
+    /**
+     * Records that @p key failed with @p error, replacing a previous error
+     */
+    void insert(const QString &key, Error error, const QString &errorString);
+
+    /**
+     * Records that @p key failed with error reply @p rawData
+     */
+    void insertReply(const QString &key, int statusCode, const QByteArray &rawData);
+
+    void clear();
+
+    [[nodiscard]] bool contains(const QString &key) const;
+    [[nodiscard]] QStringList keys() const;
+    [[nodiscard]] Error error(const QString &key) const;
+    [[nodiscard]] QString errorString(const QString &key) const;
+
+private:
+    struct FileError {
+        Error error = KGAPI2::NoError;
+        QString errorString;
+    };
+
+    QHash<QString, FileError> mErrors;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
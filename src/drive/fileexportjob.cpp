@@ -0,0 +1,310 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "fileexportjob.h"
+#include "account.h"
+#include "debug.h"
+#include "file.h"
+#include "fileerrors_p.h"
+#include "filefetchcontentjob.h"
+
+#include <QDir>
+#include <QHash>
+#include <QMimeDatabase>
+#include <QPointer>
+#include <QQueue>
+#include <QSaveFile>
+#include <QSet>
+
+#include <utility>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+// Exports are converted on the server, which is much slower than plain downloads
+static constexpr int DefaultConcurrentRequests = 4;
+}
+
+class Q_DECL_HIDDEN FileExportJob::Private
+{
+public:
+    Private(FileExportJob *parent);
+
+    void startExports();
+    void exportFile(const FilePtr &file);
+    void exportFinished(FileFetchContentJob *job, const FilePtr &file, QSaveFile *saveFile);
+    void fileFailed(const QString &fileId, Error error, const QString &errorString);
+    void fileFinished(const QString &fileId);
+    void abortExports();
+    QString targetPath(const FilePtr &file, const QString &mimeType);
+
+    FilesList files;
+    QStringList mimeTypes;
+    QPointer<QIODevice> destination;
+    QString directory;
+    bool isMultiple = false;
+
+    QQueue<FilePtr> pendingFiles;
+    QHash<FileFetchContentJob *, QString /* file ID */> exportsInFlight;
+    int processedFiles = 0;
+
+    QHash<QString /* file ID */, QString /* MIME type */> exportedMimeTypes;
+    QHash<QString /* file ID */, QString /* path */> exportedPaths;
+    FileErrors errors;
+    QSet<QString> usedPaths;
+
+private:
+    FileExportJob *const q;
+};
+
+FileExportJob::Private::Private(FileExportJob *parent)
+    : q(parent)
+{
+}
+
+void FileExportJob::Private::startExports()
+{
+    const int window = q->maxConcurrentRequests();
+    while ((window <= 0 || exportsInFlight.size() < window) && !pendingFiles.isEmpty()) {
+        exportFile(pendingFiles.dequeue());
+    }
+
+    if (q->isRunning() && exportsInFlight.isEmpty() && pendingFiles.isEmpty()) {
+        q->emitFinished();
+    }
+}
+
+void FileExportJob::Private::exportFile(const FilePtr &file)
+{
+    const QString mimeType = FileExportJob::selectMimeType(file, mimeTypes);
+    if (mimeType.isEmpty()) {
+        fileFailed(file->id(), KGAPI2::BadRequest, tr("File %1 can't be exported to any of the requested formats").arg(file->title()));
+        return;
+    }
+
+    QSaveFile *saveFile = nullptr;
+    if (!destination) {
+        // The file only replaces an existing one once the export succeeds
+        const QString path = targetPath(file, mimeType);
+        saveFile = new QSaveFile(path);
+        if (!saveFile->open(QIODevice::WriteOnly)) {
+            fileFailed(file->id(), KGAPI2::UnknownError, tr("Failed to open %1 for writing: %2").arg(path, saveFile->errorString()));
+            delete saveFile;
+            return;
+        }
+        exportedPaths.insert(file->id(), path);
+    }
+    exportedMimeTypes.insert(file->id(), mimeType);
+
+    auto job = new FileFetchContentJob(file->exportLinks().value(mimeType), q->account(), q);
+    if (saveFile) {
+        saveFile->setParent(job);
+        job->setDestination(saveFile);
+    } else {
+        job->setDestination(destination);
+    }
+
+    QObject::connect(job, &Job::finished, q, [this, job, file, saveFile]() {
+        exportFinished(job, file, saveFile);
+    });
+    exportsInFlight.insert(job, file->id());
+}
+
+void FileExportJob::Private::exportFinished(FileFetchContentJob *job, const FilePtr &file, QSaveFile *saveFile)
+{
+    job->deleteLater();
+    if (!q->isRunning()) {
+        return;
+    }
+    exportsInFlight.remove(job);
+
+    Error error = job->error();
+    QString errorString = job->errorString();
+    if (error == KGAPI2::NoError && saveFile && !saveFile->commit()) {
+        error = KGAPI2::UnknownError;
+        errorString = tr("Failed to write %1: %2").arg(saveFile->fileName(), saveFile->errorString());
+    }
+
+    if (error == KGAPI2::NoError) {
+        fileFinished(file->id());
+    } else if (isMultiple && error != KGAPI2::UnknownError && !FileErrors::isFileError(error)) {
+        // Not specific to a single file, e.g. an expired token. UnknownError
+        // means that the exported file could not be written.
+        q->setError(error);
+        q->setErrorString(errorString);
+        abortExports();
+        q->emitFinished();
+        return;
+    } else {
+        exportedPaths.remove(file->id());
+        fileFailed(file->id(), error, errorString);
+    }
+
+    startExports();
+}
+
+void FileExportJob::Private::fileFailed(const QString &fileId, Error error, const QString &errorString)
+{
+    qCWarning(KGAPIDebug) << "Failed to export file" << fileId << ":" << errorString;
+    exportedMimeTypes.remove(fileId);
+    errors.insert(fileId, error, errorString);
+
+    q->emitProgress(++processedFiles, files.size());
+    if (!isMultiple) {
+        q->setError(error);
+        q->setErrorString(errorString);
+        q->emitFinished();
+    }
+}
+
+void FileExportJob::Private::fileFinished(const QString &fileId)
+{
+    q->emitProgress(++processedFiles, files.size());
+    Q_EMIT q->fileExported(q, fileId);
+}
+
+void FileExportJob::Private::abortExports()
+{
+    // Unfinished exports are discarded along with their save files
+    const auto exports = std::exchange(exportsInFlight, {});
+    for (auto it = exports.cbegin(); it != exports.cend(); ++it) {
+        exportedMimeTypes.remove(it.value());
+        exportedPaths.remove(it.value());
+        delete it.key();
+    }
+    pendingFiles.clear();
+}
+
+QString FileExportJob::Private::targetPath(const FilePtr &file, const QString &mimeType)
+{
+    QString name = file->title();
+    name.replace(QLatin1Char('/'), QLatin1Char('_'));
+    name.replace(QLatin1Char('\\'), QLatin1Char('_'));
+    if (name.isEmpty()) {
+        name = file->id();
+    }
+
+    const QString suffix = QMimeDatabase().mimeTypeForName(mimeType).preferredSuffix();
+    const QString extension = suffix.isEmpty() ? QString() : QLatin1Char('.') + suffix;
+
+    // Files in Drive may share a title, don't let them overwrite each other
+    QString path = QDir(directory).filePath(name + extension);
+    if (usedPaths.contains(path)) {
+        path = QDir(directory).filePath(name + QLatin1StringView(" (") + file->id() + QLatin1Char(')') + extension);
+    }
+    usedPaths.insert(path);
+    return path;
+}
+
+FileExportJob::FileExportJob(const FilePtr &file, const QString &mimeType, QIODevice *destination, const AccountPtr &account, QObject *parent)
+    : FetchJob(account, parent)
+    , d(new Private(this))
+{
+    d->files = {file};
+    d->mimeTypes = {mimeType};
+    d->destination = destination;
+}
+
+FileExportJob::FileExportJob(const FilesList &files, const QStringList &mimeTypes, const QString &directory, const AccountPtr &account, QObject *parent)
+    : FetchJob(account, parent)
+    , d(new Private(this))
+{
+    d->files = files;
+    d->mimeTypes = mimeTypes;
+    d->directory = directory;
+    d->isMultiple = true;
+    setMaxConcurrentRequests(DefaultConcurrentRequests);
+}
+
+FileExportJob::~FileExportJob() = default;
+
+FilesList FileExportJob::files() const
+{
+    return d->files;
+}
+
+QStringList FileExportJob::mimeTypes() const
+{
+    return d->mimeTypes;
+}
+
+QString FileExportJob::exportedMimeType(const QString &fileId) const
+{
+    return d->exportedMimeTypes.value(fileId);
+}
+
+QString FileExportJob::exportedFilePath(const QString &fileId) const
+{
+    return d->exportedPaths.value(fileId);
+}
+
+QStringList FileExportJob::failedFilesIds() const
+{
+    QStringList ids;
+    for (const FilePtr &file : std::as_const(d->files)) {
+        if (d->errors.contains(file->id())) {
+            ids << file->id();
+        }
+    }
+    return ids;
+}
+
+Error FileExportJob::fileError(const QString &fileId) const
+{
+    return d->errors.error(fileId);
+}
+
+QString FileExportJob::fileErrorString(const QString &fileId) const
+{
+    return d->errors.errorString(fileId);
+}
+
+QString FileExportJob::selectMimeType(const FilePtr &file, const QStringList &mimeTypes)
+{
+    const auto exportLinks = file->exportLinks();
+    for (const QString &mimeType : mimeTypes) {
+        if (exportLinks.contains(mimeType)) {
+            return mimeType;
+        }
+    }
+    return QString();
+}
+
+void FileExportJob::start()
+{
+    d->pendingFiles.clear();
+    d->exportsInFlight.clear();
+    d->processedFiles = 0;
+    d->exportedMimeTypes.clear();
+    d->exportedPaths.clear();
+    d->errors.clear();
+    d->usedPaths.clear();
+
+    if (!d->isMultiple && !d->destination) {
+        setError(KGAPI2::UnknownError);
+        setErrorString(tr("No destination device set"));
+        emitFinished();
+        return;
+    }
+
+    if (d->isMultiple && !QDir().mkpath(d->directory)) {
+        setError(KGAPI2::UnknownError);
+        setErrorString(tr("Failed to create directory %1").arg(d->directory));
+        emitFinished();
+        return;
+    }
+
+    for (const FilePtr &file : std::as_const(d->files)) {
+        d->pendingFiles.enqueue(file);
+    }
+    d->startExports();
+}
+
+#include "moc_fileexportjob.cpp"
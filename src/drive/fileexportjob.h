@@ -0,0 +1,122 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "fetchjob.h"
+#include "kgapidrive_export.h"
+
+#include <QScopedPointer>
+#include <QStringList>
+
+class QIODevice;
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @brief Exports Google Docs, Sheets, Slides and Drawings to regular file formats
+ *
+ * Google-native files have no File::downloadUrl(), they can only be
+ * downloaded converted to one of the formats listed in File::exportLinks().
+ * The job picks the first of the requested MIME types that the file can be
+ * exported to and streams the converted content to a device or a file, so
+ * the content is never held in memory as a whole.
+ *
+ * When exporting a list of files into a directory, up to
+ * Job::maxConcurrentRequests() files (4 by default) are exported at once and
+ * a failure on one of them does not abort the job. It is recorded and can be
+ * checked with failedFilesIds() and fileError().
+ *
+ * @since 6.9.0
+ */
+class KGAPIDRIVE_EXPORT FileExportJob : public KGAPI2::FetchJob
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Exports @p file as @p mimeType into @p destination
+     *
+     * The device must be open for writing and must stay valid until the job
+     * finishes; the job does not take ownership of it.
+     */
+    explicit FileExportJob(const FilePtr &file, const QString &mimeType, QIODevice *destination, const AccountPtr &account, QObject *parent = nullptr);
+
+    /**
+     * @brief Exports @p files into directory @p directory
+     *
+     * Each file is exported to the first of @p mimeTypes listed in its
+     * File::exportLinks() and stored as a file named after its title, with
+     * the extension of the chosen format. Existing files are overwritten.
+     */
+    explicit FileExportJob(const FilesList &files,
+                           const QStringList &mimeTypes,
+                           const QString &directory,
+                           const AccountPtr &account,
+                           QObject *parent = nullptr);
+    ~FileExportJob() override;
+
+    [[nodiscard]] FilesList files() const;
+
+    /**
+     * @brief Requested export formats, in order of preference
+     */
+    [[nodiscard]] QStringList mimeTypes() const;
+
+    /**
+     * @brief Returns the format file @p fileId was exported to
+     */
+    [[nodiscard]] QString exportedMimeType(const QString &fileId) const;
+
+    /**
+     * @brief Returns path of the file @p fileId was exported to
+     *
+     * Only available when exporting into a directory.
+     */
+    [[nodiscard]] QString exportedFilePath(const QString &fileId) const;
+
+    /**
+     * @brief Returns IDs of files that could not be exported
+     */
+    [[nodiscard]] QStringList failedFilesIds() const;
+
+    /**
+     * @brief Returns the error that occurred on file @p fileId
+     */
+    [[nodiscard]] KGAPI2::Error fileError(const QString &fileId) const;
+    [[nodiscard]] QString fileErrorString(const QString &fileId) const;
+
+    /**
+     * @brief Returns the first of @p mimeTypes that @p file can be exported to
+     *
+     * Returns an empty string when @p file can't be exported to any of them.
+     */
+    [[nodiscard]] static QString selectMimeType(const FilePtr &file, const QStringList &mimeTypes);
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted as soon as file @p fileId has been exported
+     */
+    void fileExported(KGAPI2::Drive::FileExportJob *job, const QString &fileId);
+
+protected:
+    void start() override;
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
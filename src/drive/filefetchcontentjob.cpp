@@ -7,10 +7,27 @@
  */
 
 #include "filefetchcontentjob.h"
+#include "account.h"
+#include "debug.h"
 #include "file.h"
 
+#include <QCryptographicHash>
+#include <QFileDevice>
+#include <QHash>
 #include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+
+#include <limits>
+
+namespace
+{
+static constexpr qint64 StreamBufferSize = 1024 * 1024;
+// Smaller buffer for throttled downloads, so that the network does not run too far ahead of the limit
+static constexpr qint64 ThrottledBufferSize = 64 * 1024;
+}
 
 using namespace KGAPI2;
 using namespace KGAPI2::Drive;
@@ -21,10 +38,36 @@ public:
     Private(FileFetchContentJob *parent);
 
     void _k_downloadProgress(qint64 downloaded, qint64 total);
+    void _k_readyRead(QNetworkReply *reply);
+    bool prepareReply(const QNetworkReply *reply);
+    bool writeData(const QNetworkReply *reply, const QByteArray &data);
+    bool consumeData(const QNetworkReply *reply, const QByteArray &data);
+    QString accountName() const;
+    bool hashDestination();
+    void enqueueRange(qint64 from, qint64 to);
+    void verifyChecksum();
+    void fail(const QString &errorString);
 
     QUrl url;
     QByteArray fileData;
 
+    QPointer<QIODevice> destination;
+    QString expectedMd5;
+    qint64 fileSize = -1;
+    bool resumeFromDestination = false;
+    int segmentCount = 1;
+    BandwidthLimiter::Priority transferPriority = BandwidthLimiter::Background;
+
+    QCryptographicHash hash{QCryptographicHash::Md5};
+    // Whether hash covers all the data written so far, in order
+    bool hashIsIncremental = true;
+    bool segmented = false;
+    int pendingReplies = 0;
+    qint64 bytesWritten = 0;
+    QHash<const QNetworkReply *, qint64> writePositions;
+    // Replies waiting for the bandwidth limiter
+    QSet<const QNetworkReply *> delayedReplies;
+
 private:
     FileFetchContentJob *const q;
 };
@@ -36,7 +79,186 @@ FileFetchContentJob::Private::Private(FileFetchContentJob *parent)
 
 void FileFetchContentJob::Private::_k_downloadProgress(qint64 downloaded, qint64 total)
 {
-    q->emitProgress(downloaded, total);
+    Q_EMIT q->downloadProgress(q, downloaded, total);
+
+    // Job::progress() only takes int, scale the values down for files over 2 GiB
+    while (total > std::numeric_limits<int>::max()) {
+        total /= 1024;
+        downloaded /= 1024;
+    }
+    q->emitProgress(static_cast<int>(downloaded), static_cast<int>(total));
+}
+
+void FileFetchContentJob::Private::_k_readyRead(QNetworkReply *reply)
+{
+    // Don't stream error pages and redirects into the destination, Job handles those
+    const int replyCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (replyCode < 200 || replyCode >= 300 || !q->isRunning() || delayedReplies.contains(reply) || reply->bytesAvailable() == 0) {
+        return;
+    }
+
+    if (destination && !prepareReply(reply)) {
+        reply->abort();
+        return;
+    }
+
+    auto limiter = BandwidthLimiter::instance();
+    while (reply->bytesAvailable() > 0) {
+        qint64 size = qMin(reply->bytesAvailable(), StreamBufferSize);
+        // The limits may change while the download is running, check them for every read
+        const bool limited = limiter->isLimited(accountName(), BandwidthLimiter::Download);
+        reply->setReadBufferSize(limited && transferPriority == BandwidthLimiter::Background ? ThrottledBufferSize : StreamBufferSize);
+        if (limited) {
+            size = limiter->acquire(accountName(), BandwidthLimiter::Download, transferPriority, size);
+            if (size == 0) {
+                // Leave the rest in the reply buffer, which stops the reply from
+                // reading more from the network until there's room again
+                delayedReplies.insert(reply);
+                QTimer::singleShot(limiter->msecsUntilAvailable(accountName(), BandwidthLimiter::Download), reply, [this, reply]() {
+                    delayedReplies.remove(reply);
+                    _k_readyRead(reply);
+                });
+                return;
+            }
+        }
+
+        if (!consumeData(reply, reply->read(size))) {
+            reply->abort();
+            return;
+        }
+    }
+}
+
+bool FileFetchContentJob::Private::prepareReply(const QNetworkReply *reply)
+{
+    if (writePositions.contains(reply)) {
+        return true;
+    }
+
+    const QNetworkRequest request = reply->request();
+    qint64 position = request.attribute(QNetworkRequest::User).toLongLong();
+    const int replyCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (request.hasRawHeader("Range") && replyCode != KGAPI2::PartialContent) {
+        if (segmented) {
+            fail(tr("Server does not support downloading byte ranges"));
+            return false;
+        }
+
+        // The server ignored the Range header and sends the whole file, start over
+        qCDebug(KGAPIDebug) << "Server ignored Range request, restarting download from the beginning";
+        position = 0;
+        if (auto file = qobject_cast<QFileDevice *>(destination.data())) {
+            file->resize(0);
+        }
+        hash.reset();
+        hashIsIncremental = true;
+        bytesWritten = 0;
+    }
+
+    writePositions.insert(reply, position);
+    return true;
+}
+
+bool FileFetchContentJob::Private::writeData(const QNetworkReply *reply, const QByteArray &data)
+{
+    if (data.isEmpty()) {
+        return true;
+    }
+
+    const qint64 position = writePositions.value(reply);
+    if (!destination || (!destination->isSequential() && destination->pos() != position && !destination->seek(position))
+        || destination->write(data) != data.size()) {
+        qCWarning(KGAPIDebug) << "Failed to write downloaded data:" << (destination ? destination->errorString() : QStringLiteral("no device"));
+        fail(tr("Failed to write downloaded data"));
+        return false;
+    }
+
+    writePositions.insert(reply, position + data.size());
+    if (hashIsIncremental) {
+        hash.addData(data);
+    }
+
+    bytesWritten += data.size();
+    if (fileSize > 0 && (segmented || resumeFromDestination)) {
+        _k_downloadProgress(bytesWritten, fileSize);
+    }
+
+    return true;
+}
+
+bool FileFetchContentJob::Private::consumeData(const QNetworkReply *reply, const QByteArray &data)
+{
+    if (!destination) {
+        fileData.append(data);
+        return true;
+    }
+    return writeData(reply, data);
+}
+
+QString FileFetchContentJob::Private::accountName() const
+{
+    return q->account() ? q->account()->accountName() : QString();
+}
+
+bool FileFetchContentJob::Private::hashDestination()
+{
+    if (!destination || destination->isSequential() || !destination->isReadable()) {
+        return false;
+    }
+
+    hash.reset();
+    if (!destination->seek(0)) {
+        return false;
+    }
+    while (!destination->atEnd()) {
+        const QByteArray chunk = destination->read(StreamBufferSize);
+        if (chunk.isEmpty()) {
+            return false;
+        }
+        hash.addData(chunk);
+    }
+    return true;
+}
+
+void FileFetchContentJob::Private::enqueueRange(qint64 from, qint64 to)
+{
+    QNetworkRequest request(url);
+    if (to >= 0) {
+        request.setRawHeader("Range", "bytes=" + QByteArray::number(from) + '-' + QByteArray::number(to));
+    } else if (from > 0) {
+        request.setRawHeader("Range", "bytes=" + QByteArray::number(from) + '-');
+    }
+    request.setAttribute(QNetworkRequest::User, from);
+
+    q->enqueueRequest(request);
+    ++pendingReplies;
+}
+
+void FileFetchContentJob::Private::verifyChecksum()
+{
+    if (expectedMd5.isEmpty()) {
+        return;
+    }
+
+    if (!hashIsIncremental && !hashDestination()) {
+        qCDebug(KGAPIDebug) << "Destination can't be read back, skipping checksum verification";
+        return;
+    }
+
+    const QString checksum = q->md5Checksum();
+    if (checksum.compare(expectedMd5, Qt::CaseInsensitive) != 0) {
+        qCWarning(KGAPIDebug) << "Checksum mismatch, expected" << expectedMd5 << "got" << checksum;
+        q->setError(KGAPI2::InvalidResponse);
+        q->setErrorString(tr("Downloaded content does not match the file checksum"));
+        q->emitFinished();
+    }
+}
+
+void FileFetchContentJob::Private::fail(const QString &errorString)
+{
+    q->setError(KGAPI2::UnknownError);
+    q->setErrorString(errorString);
+    q->emitFinished();
 }
 
 FileFetchContentJob::FileFetchContentJob(const FilePtr &file, const AccountPtr &account, QObject *parent)
@@ -44,6 +266,8 @@ FileFetchContentJob::FileFetchContentJob(const FilePtr &file, const AccountPtr &
     , d(new Private(this))
 {
     d->url = file->downloadUrl();
+    d->expectedMd5 = file->md5Checksum();
+    d->fileSize = file->fileSize();
 }
 
 FileFetchContentJob::FileFetchContentJob(const QUrl &url, const AccountPtr &account, QObject *parent)
@@ -63,10 +287,127 @@ QByteArray FileFetchContentJob::data() const
     return d->fileData;
 }
 
+void FileFetchContentJob::setDestination(QIODevice *device)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify destination property when job is running";
+        return;
+    }
+
+    d->destination = device;
+}
+
+QIODevice *FileFetchContentJob::destination() const
+{
+    return d->destination;
+}
+
+QString FileFetchContentJob::md5Checksum() const
+{
+    return QString::fromLatin1(d->hash.result().toHex());
+}
+
+bool FileFetchContentJob::resumeFromDestination() const
+{
+    return d->resumeFromDestination;
+}
+
+void FileFetchContentJob::setResumeFromDestination(bool resume)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify resumeFromDestination property when job is running";
+        return;
+    }
+
+    d->resumeFromDestination = resume;
+}
+
+int FileFetchContentJob::segmentCount() const
+{
+    return d->segmentCount;
+}
+
+void FileFetchContentJob::setSegmentCount(int count)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify segmentCount property when job is running";
+        return;
+    }
+
+    d->segmentCount = qMax(1, count);
+}
+
+BandwidthLimiter::Priority FileFetchContentJob::transferPriority() const
+{
+    return d->transferPriority;
+}
+
+void FileFetchContentJob::setTransferPriority(BandwidthLimiter::Priority priority)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify transferPriority property when job is running";
+        return;
+    }
+
+    d->transferPriority = priority;
+}
+
 void FileFetchContentJob::start()
 {
-    QNetworkRequest request(d->url);
-    enqueueRequest(request);
+    d->fileData.clear();
+    d->hash.reset();
+    d->hashIsIncremental = true;
+    d->segmented = false;
+    d->pendingReplies = 0;
+    d->bytesWritten = 0;
+    d->writePositions.clear();
+    d->delayedReplies.clear();
+
+    if (!d->destination) {
+        QNetworkRequest request(d->url);
+        enqueueRequest(request);
+        return;
+    }
+
+    const bool seekable = !d->destination->isSequential();
+    if (d->segmentCount > 1 && d->fileSize > 0 && seekable) {
+        d->segmented = true;
+        d->hashIsIncremental = false;
+        if (auto file = qobject_cast<QFileDevice *>(d->destination.data())) {
+            file->resize(d->fileSize);
+        }
+
+        const int count = static_cast<int>(qMin<qint64>(d->segmentCount, d->fileSize));
+        const qint64 segmentSize = (d->fileSize + count - 1) / count;
+        for (qint64 from = 0; from < d->fileSize; from += segmentSize) {
+            d->enqueueRange(from, qMin(from + segmentSize, d->fileSize) - 1);
+        }
+        return;
+    }
+
+    qint64 offset = 0;
+    if (d->resumeFromDestination && seekable) {
+        offset = d->destination->size();
+        if (offset > 0) {
+            // The checksum has to cover the part that is already on disk as well
+            d->hashIsIncremental = d->hashDestination();
+            if (!d->destination->seek(offset)) {
+                d->fail(tr("Failed to seek in the destination device"));
+                return;
+            }
+        }
+
+        if (d->fileSize > 0 && offset >= d->fileSize) {
+            qCDebug(KGAPIDebug) << "Download already complete, nothing to resume";
+            d->verifyChecksum();
+            if (isRunning()) {
+                emitFinished();
+            }
+            return;
+        }
+    }
+
+    d->enqueueRange(offset, -1);
 }
 
 void FileFetchContentJob::dispatchRequest(QNetworkAccessManager *accessManager,
@@ -78,16 +419,41 @@ void FileFetchContentJob::dispatchRequest(QNetworkAccessManager *accessManager,
     Q_UNUSED(contentType)
 
     QNetworkReply *reply = accessManager->get(request);
-    connect(reply, &QNetworkReply::downloadProgress, this, [this](qint64 downloaded, qint64 total) {
-        d->_k_downloadProgress(downloaded, total);
+    // Keep at most StreamBufferSize bytes of the body in memory, the readyRead
+    // handler adjusts the buffer to the bandwidth limits
+    reply->setReadBufferSize(StreamBufferSize);
+    connect(reply, &QNetworkReply::readyRead, this, [this, reply]() {
+        d->_k_readyRead(reply);
     });
+    if (!d->segmented && !(d->resumeFromDestination && d->fileSize > 0)) {
+        connect(reply, &QNetworkReply::downloadProgress, this, [this](qint64 downloaded, qint64 total) {
+            d->_k_downloadProgress(downloaded, total);
+        });
+    }
 }
 
 void FileFetchContentJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
 {
-    Q_UNUSED(reply)
+    // Whatever was not consumed by the readyRead handler. The reply buffer
+    // is small when throttled, so let it through rather than stalling the job.
+    d->delayedReplies.remove(reply);
+    if (BandwidthLimiter::instance()->isLimited(d->accountName(), BandwidthLimiter::Download)) {
+        BandwidthLimiter::instance()->acquire(d->accountName(), BandwidthLimiter::Download, BandwidthLimiter::Interactive, rawData.size());
+    }
+
+    if (!d->destination) {
+        d->fileData.append(rawData);
+        return;
+    }
+
+    if (!d->prepareReply(reply) || !d->writeData(reply, rawData)) {
+        return;
+    }
+    d->writePositions.remove(reply);
 
-    d->fileData = rawData;
+    if (--d->pendingReplies == 0) {
+        d->verifyChecksum();
+    }
 }
 
 ObjectsList FileFetchContentJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
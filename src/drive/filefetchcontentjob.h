@@ -8,9 +8,12 @@
 
 #pragma once
 
+#include "bandwidthlimiter.h"
 #include "fetchjob.h"
 #include "kgapidrive_export.h"
 
+class QIODevice;
+
 namespace KGAPI2
 {
 namespace Drive
@@ -25,8 +28,97 @@ public:
     explicit FileFetchContentJob(const QUrl &url, const AccountPtr &account, QObject *parent = nullptr);
     ~FileFetchContentJob() override;
 
+    /**
+     * @brief Returns the downloaded content
+     *
+     * The content is only kept in memory when no destination device
+     * was set.
+     */
     [[nodiscard]] QByteArray data() const;
 
+    /**
+     * @brief Sets a device to stream the downloaded content into
+     *
+     * The content is written to @p device as it arrives instead of being
+     * buffered in memory, so data() returns an empty array. The device must
+     * be open for writing and must stay valid until the job finishes; the
+     * job does not take ownership of it.
+     *
+     * When the job was constructed from a File with a known md5Checksum,
+     * the written content is verified against it and the job fails with
+     * KGAPI2::InvalidResponse on mismatch.
+     *
+     * @since 6.9.0
+     */
+    void setDestination(QIODevice *device);
+    [[nodiscard]] QIODevice *destination() const;
+
+    /**
+     * @brief Returns hex-encoded MD5 checksum of the content streamed into
+     *        destination device
+     *
+     * In segmented mode the checksum is only available when the destination
+     * is readable.
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] QString md5Checksum() const;
+
+    /**
+     * @brief Sets whether to continue a previously interrupted download
+     *
+     * When enabled and the destination device is seekable, the content
+     * already present in the destination is kept and only the remaining
+     * bytes are requested using an HTTP Range request. If the server
+     * ignores the range the download starts over from the beginning.
+     *
+     * The destination should be open in QIODevice::ReadWrite mode so that
+     * the existing content can be included in checksum verification.
+     *
+     * @since 6.9.0
+     */
+    void setResumeFromDestination(bool resume);
+    [[nodiscard]] bool resumeFromDestination() const;
+
+    /**
+     * @brief Sets number of byte ranges to download concurrently
+     *
+     * When @p count is bigger than 1, the job was constructed from a File with
+     * known size and the destination device is seekable, the destination is
+     * preallocated and the file is fetched in @p count concurrent segments.
+     * This only pays off for large files on high-latency links.
+     *
+     * Defaults to 1, i.e. the file is downloaded in a single stream.
+     *
+     * @since 6.9.0
+     */
+    void setSegmentCount(int count);
+    [[nodiscard]] int segmentCount() const;
+
+    /**
+     * @brief Sets priority of the download in BandwidthLimiter
+     *
+     * Background downloads are slowed down to stay within the limits set in
+     * BandwidthLimiter::instance(), interactive ones are not.
+     *
+     * Defaults to BandwidthLimiter::Background.
+     *
+     * @since 6.9.0
+     */
+    void setTransferPriority(BandwidthLimiter::Priority priority);
+    [[nodiscard]] BandwidthLimiter::Priority transferPriority() const;
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted when a part of the content has been downloaded
+     *
+     * Job::progress() only carries int values, for files over 2 GiB the
+     * values are scaled down. This signal carries exact byte counts.
+     *
+     * @since 6.9.0
+     */
+    void downloadProgress(KGAPI2::Drive::FileFetchContentJob *job, qint64 downloaded, qint64 total);
+
 protected:
     void start() override;
     void handleReply(const QNetworkReply *reply, const QByteArray &rawData) override;
@@ -11,31 +11,62 @@
 #include "driveservice.h"
 #include "file.h"
 #include "filesearchquery.h"
+#include "user.h"
 #include "utils.h"
 
 #include <QNetworkReply>
 #include <QNetworkRequest>
+#include <QSet>
 #include <QUrlQuery>
 
+#include <algorithm>
+
 using namespace KGAPI2;
 using namespace KGAPI2::Drive;
 
+namespace
+{
+static constexpr int DefaultConcurrentFetches = 8;
+static constexpr int MaxResultsLimit = 1000;
+static constexpr int DefaultMaxQueryLength = 2000;
+}
+
 class Q_DECL_HIDDEN FileFetchJob::Private
 {
 public:
     Private(FileFetchJob *parent);
     void processNext();
+    void enqueueSearch(const QString &queryString);
+    void enqueueFiles();
+
+    static QString corporaToString(Corpora corpora);
+    static QString spacesToString(Spaces spaces);
 
     FileSearchQuery searchQuery;
     QStringList filesIDs;
     bool isFeed = false;
+    bool isMultiple = false;
     bool includeItemsFromAllDrives = true;
     bool supportsAllDrives = true;
 
     bool updateViewedDate = false;
 
+    int maxResults = 0;
+    Corpora corpora = DefaultCorpora;
+    QString driveId;
+    Spaces spaces = DefaultSpaces;
+    int maxQueryLength = DefaultMaxQueryLength;
+
+    // IDs of found files, used to merge results of a split query
+    QSet<QString> foundIds;
+    bool isSplit = false;
+
     QStringList fields;
 
+    // Fetched files in the order of filesIDs
+    FilesList files;
+    QList<int> notFoundIndexes;
+
 private:
     FileFetchJob *const q;
 };
@@ -45,62 +76,137 @@ FileFetchJob::Private::Private(FileFetchJob *parent)
 {
 }
 
+QString FileFetchJob::Private::corporaToString(Corpora corpora)
+{
+    switch (corpora) {
+    case DefaultCorpora:
+        return QStringLiteral("default");
+    case DomainCorpora:
+        return QStringLiteral("domain");
+    case DriveCorpora:
+        return QStringLiteral("drive");
+    case AllDrivesCorpora:
+        return QStringLiteral("allDrives");
+    }
+
+    Q_ASSERT(false);
+    return QString();
+}
+
+QString FileFetchJob::Private::spacesToString(Spaces spaces)
+{
+    QStringList list;
+    if (spaces & DriveSpace) {
+        list << QStringLiteral("drive");
+    }
+    if (spaces & AppDataFolderSpace) {
+        list << QStringLiteral("appDataFolder");
+    }
+    if (spaces & PhotosSpace) {
+        list << QStringLiteral("photos");
+    }
+    return list.join(QLatin1Char(','));
+}
+
 void FileFetchJob::Private::processNext()
 {
-    QUrl url;
+    foundIds.clear();
+    isSplit = false;
 
-    if (isFeed) {
-        url = DriveService::fetchFilesUrl();
+    if (searchQuery.isEmpty()) {
+        enqueueSearch(QString());
+        return;
+    }
 
-        QUrlQuery query(url);
-        if (!searchQuery.isEmpty()) {
-            query.addQueryItem(QStringLiteral("q"), searchQuery.serialize());
-        }
+    // Long queries are split into several shorter ones which are sent
+    // concurrently, their results are merged
+    const QList<SearchQuery> queries = maxQueryLength > 0 ? searchQuery.split(maxQueryLength) : QList<SearchQuery>{searchQuery};
+    isSplit = queries.size() > 1;
+    if (isSplit) {
+        qCDebug(KGAPIDebug) << "Search query split into" << queries.size() << "queries";
+    }
+    for (const SearchQuery &query : queries) {
+        enqueueSearch(query.serialize());
+    }
+}
 
-        query.addQueryItem(QStringLiteral("includeItemsFromAllDrives"), Utils::bool2Str(includeItemsFromAllDrives));
+void FileFetchJob::Private::enqueueSearch(const QString &queryString)
+{
+    QUrl url = DriveService::fetchFilesUrl();
 
-        url.setQuery(query);
+    QUrlQuery query(url);
+    if (!queryString.isEmpty()) {
+        query.addQueryItem(QStringLiteral("q"), queryString);
+    }
 
-        if (!fields.isEmpty()) {
-            // Deserializing requires kind attribute, always force add it
-            if (!fields.contains(File::Fields::Kind)) {
-                fields << File::Fields::Kind;
-            }
-            Job *baseJob = dynamic_cast<Job *>(q);
-            baseJob->setFields({File::Fields::Etag,
-                                File::Fields::Kind,
-                                File::Fields::NextLink,
-                                File::Fields::NextPageToken,
-                                File::Fields::SelfLink,
-                                Job::buildSubfields(File::Fields::Items, fields)});
-        }
-    } else {
-        if (filesIDs.isEmpty()) {
-            q->emitFinished();
-            return;
-        }
+    if (maxResults > 0) {
+        query.addQueryItem(QStringLiteral("maxResults"), QString::number(maxResults));
+    }
+    if (corpora != DefaultCorpora) {
+        query.addQueryItem(QStringLiteral("corpora"), corporaToString(corpora));
+    }
+    if (!driveId.isEmpty()) {
+        query.addQueryItem(QStringLiteral("driveId"), driveId);
+    }
+    if (spaces != DefaultSpaces) {
+        query.addQueryItem(QStringLiteral("spaces"), spacesToString(spaces));
+    }
 
-        const QString fileId = filesIDs.takeFirst();
-        url = DriveService::fetchFileUrl(fileId);
+    query.addQueryItem(QStringLiteral("includeItemsFromAllDrives"), Utils::bool2Str(includeItemsFromAllDrives));
+    query.addQueryItem(QStringLiteral("supportsAllDrives"), Utils::bool2Str(supportsAllDrives));
+    url.setQuery(query);
 
-        if (!fields.isEmpty()) {
-            // Deserializing requires kind attribute, always force add it
-            if (!fields.contains(File::Fields::Kind)) {
-                fields << File::Fields::Kind;
-            }
-            Job *baseJob = dynamic_cast<Job *>(q);
-            baseJob->setFields(fields);
+    if (!fields.isEmpty()) {
+        // Deserializing requires kind attribute, always force add it
+        if (!fields.contains(File::Fields::Kind)) {
+            fields << File::Fields::Kind;
         }
+        Job *baseJob = dynamic_cast<Job *>(q);
+        baseJob->setFields({File::Fields::Etag,
+                            File::Fields::Kind,
+                            File::Fields::NextLink,
+                            File::Fields::NextPageToken,
+                            File::Fields::SelfLink,
+                            Job::buildSubfields(File::Fields::Items, fields)});
     }
 
-    QUrlQuery withDriveSupportQuery(url);
-    withDriveSupportQuery.addQueryItem(QStringLiteral("supportsAllDrives"), Utils::bool2Str(supportsAllDrives));
-    url.setQuery(withDriveSupportQuery);
-
     QNetworkRequest request(url);
     q->enqueueRequest(request);
 }
 
+void FileFetchJob::Private::enqueueFiles()
+{
+    files = FilesList(filesIDs.size());
+    notFoundIndexes.clear();
+
+    if (filesIDs.isEmpty()) {
+        q->emitFinished();
+        return;
+    }
+
+    if (!fields.isEmpty()) {
+        // Deserializing requires kind attribute, always force add it
+        if (!fields.contains(File::Fields::Kind)) {
+            fields << File::Fields::Kind;
+        }
+        Job *baseJob = dynamic_cast<Job *>(q);
+        baseJob->setFields(fields);
+    }
+
+    // All requests are enqueued at once, the job dispatches at most
+    // maxConcurrentRequests() of them at a time
+    for (int i = 0; i < filesIDs.size(); ++i) {
+        QUrl url = DriveService::fetchFileUrl(filesIDs.at(i));
+        QUrlQuery withDriveSupportQuery(url);
+        withDriveSupportQuery.addQueryItem(QStringLiteral("supportsAllDrives"), Utils::bool2Str(supportsAllDrives));
+        url.setQuery(withDriveSupportQuery);
+
+        QNetworkRequest request(url);
+        request.setAttribute(QNetworkRequest::User, i);
+        q->enqueueRequest(request);
+    }
+}
+
 FileFetchJob::FileFetchJob(const QString &fileId, const AccountPtr &account, QObject *parent)
     : FetchJob(account, parent)
     , d(new Private(this))
@@ -113,6 +219,8 @@ FileFetchJob::FileFetchJob(const QStringList &filesIds, const AccountPtr &accoun
     , d(new Private(this))
 {
     d->filesIDs << filesIds;
+    d->isMultiple = true;
+    setMaxConcurrentRequests(DefaultConcurrentFetches);
 }
 
 FileFetchJob::FileFetchJob(const AccountPtr &account, QObject *parent)
@@ -128,6 +236,7 @@ FileFetchJob::FileFetchJob(const FileSearchQuery &query, const AccountPtr &accou
 {
     d->isFeed = true;
     d->searchQuery = query;
+    setMaxConcurrentRequests(DefaultConcurrentFetches);
 }
 
 FileFetchJob::~FileFetchJob()
@@ -150,9 +259,122 @@ void FileFetchJob::setUpdateViewedDate(bool updateViewedDate)
     d->updateViewedDate = updateViewedDate;
 }
 
+QStringList FileFetchJob::notFoundFilesIds() const
+{
+    QList<int> indexes = d->notFoundIndexes;
+    std::sort(indexes.begin(), indexes.end());
+
+    QStringList ids;
+    ids.reserve(indexes.size());
+    for (int index : std::as_const(indexes)) {
+        ids << d->filesIDs.at(index);
+    }
+    return ids;
+}
+
+int FileFetchJob::maxResults() const
+{
+    return d->maxResults;
+}
+
+void FileFetchJob::setMaxResults(int maxResults)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify maxResults property when job is running.";
+        return;
+    }
+
+    d->maxResults = qBound(0, maxResults, MaxResultsLimit);
+}
+
+FileFetchJob::Corpora FileFetchJob::corpora() const
+{
+    return d->corpora;
+}
+
+void FileFetchJob::setCorpora(Corpora corpora)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify corpora property when job is running.";
+        return;
+    }
+
+    d->corpora = corpora;
+}
+
+QString FileFetchJob::driveId() const
+{
+    return d->driveId;
+}
+
+void FileFetchJob::setDriveId(const QString &driveId)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify driveId property when job is running.";
+        return;
+    }
+
+    d->driveId = driveId;
+}
+
+FileFetchJob::Spaces FileFetchJob::spaces() const
+{
+    return d->spaces;
+}
+
+void FileFetchJob::setSpaces(Spaces spaces)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify spaces property when job is running.";
+        return;
+    }
+
+    d->spaces = spaces;
+}
+
+int FileFetchJob::maxQueryLength() const
+{
+    return d->maxQueryLength;
+}
+
+void FileFetchJob::setMaxQueryLength(int maxQueryLength)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify maxQueryLength property when job is running.";
+        return;
+    }
+
+    d->maxQueryLength = qMax(0, maxQueryLength);
+}
+
+ObjectsList FileFetchJob::items() const
+{
+    if (d->isFeed) {
+        return FetchJob::items();
+    }
+
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Called items() on a running job, returning empty list.";
+        return ObjectsList();
+    }
+
+    ObjectsList items;
+    items.reserve(d->files.size());
+    for (const FilePtr &file : std::as_const(d->files)) {
+        if (file) {
+            items << file;
+        }
+    }
+    return items;
+}
+
 void FileFetchJob::start()
 {
-    d->processNext();
+    if (d->isFeed) {
+        d->processNext();
+    } else {
+        d->enqueueFiles();
+    }
 }
 
 void FileFetchJob::setFields(const QStringList &fields)
@@ -225,6 +447,20 @@ const QStringList &FileFetchJob::FieldShorthands::sharingFields()
     return sharingFields;
 }
 
+const QStringList &FileFetchJob::FieldShorthands::listingFields()
+{
+    static const QStringList listingFields = {File::Fields::Id,
+                                              File::Fields::Title,
+                                              File::Fields::MimeType,
+                                              File::Fields::FileSize,
+                                              File::Fields::ModifiedDate,
+                                              File::Fields::IconLink,
+                                              File::Fields::Parents,
+                                              Job::buildSubfields(File::Fields::Labels, {File::Labels::Fields::Starred, File::Labels::Fields::Trashed}),
+                                              Job::buildSubfields(File::Fields::Owners, {User::Fields::Kind, User::Fields::DisplayName})};
+    return listingFields;
+}
+
 ObjectsList FileFetchJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
 {
     ObjectsList items;
@@ -235,7 +471,17 @@ ObjectsList FileFetchJob::handleReplyWithItems(const QNetworkReply *reply, const
         if (d->isFeed) {
             FeedData feedData;
 
-            items << File::fromJSONFeed(rawData, feedData);
+            const FilesList files = File::fromJSONFeed(rawData, feedData);
+            for (const FilePtr &file : files) {
+                // A file may be matched by several parts of a split query
+                if (d->isSplit) {
+                    if (d->foundIds.contains(file->id())) {
+                        continue;
+                    }
+                    d->foundIds.insert(file->id());
+                }
+                items << file;
+            }
 
             if (feedData.nextPageUrl.isValid()) {
                 QNetworkRequest request(feedData.nextPageUrl);
@@ -243,9 +489,12 @@ ObjectsList FileFetchJob::handleReplyWithItems(const QNetworkReply *reply, const
             }
 
         } else {
-            items << File::fromJSON(rawData);
-
-            d->processNext();
+            // Stored by index and returned from items() in the original order,
+            // regardless of the order in which the replies arrive
+            const int index = currentRequest().attribute(QNetworkRequest::User).toInt();
+            if (index >= 0 && index < d->files.size()) {
+                d->files[index] = File::fromJSON(rawData);
+            }
         }
     } else {
         setError(KGAPI2::InvalidResponse);
@@ -257,4 +506,16 @@ ObjectsList FileFetchJob::handleReplyWithItems(const QNetworkReply *reply, const
     return items;
 }
 
+bool FileFetchJob::handleError(int statusCode, const QByteArray &rawData)
+{
+    if (d->isMultiple && statusCode == KGAPI2::NotFound) {
+        const int index = currentRequest().attribute(QNetworkRequest::User).toInt();
+        qCDebug(KGAPIDebug) << "File" << d->filesIDs.value(index) << "does not exist";
+        d->notFoundIndexes << index;
+        return true;
+    }
+
+    return FetchJob::handleError(statusCode, rawData);
+}
+
 #include "moc_filefetchjob.cpp"
@@ -33,7 +33,59 @@ class KGAPIDRIVE_EXPORT FileFetchJob : public KGAPI2::FetchJob
      */
     Q_PROPERTY(bool updateViewedDate READ updateViewedDate WRITE setUpdateViewedDate)
 
+    /**
+     * Maximum number of files returned in a single page of search results.
+     *
+     * Default value is 0, i.e. the server default is used. The largest value
+     * supported by Google Drive is 1000.
+     *
+     * This property can be modified only when the job is not running.
+     *
+     * @since 6.9.0
+     */
+    Q_PROPERTY(int maxResults READ maxResults WRITE setMaxResults)
+
+    /**
+     * Maximum length of a search query sent in a single request.
+     *
+     * Longer queries are split into several shorter ones (see
+     * SearchQuery::split()) which are sent concurrently and whose results are
+     * merged, so that each file is returned only once.
+     *
+     * Default value is 2000, 0 disables splitting.
+     *
+     * This property can be modified only when the job is not running.
+     *
+     * @since 6.9.0
+     */
+    Q_PROPERTY(int maxQueryLength READ maxQueryLength WRITE setMaxQueryLength)
+
 public:
+    /**
+     * @brief Bodies of items (files/documents) to which a search applies
+     *
+     * @since 6.9.0
+     */
+    enum Corpora {
+        DefaultCorpora, ///< Files of the user, the server default
+        DomainCorpora, ///< Files shared to the user's domain
+        DriveCorpora, ///< Files in the shared drive set by setDriveId()
+        AllDrivesCorpora ///< Files of the user and of all shared drives the user is a member of
+    };
+
+    /**
+     * @brief Spaces to search
+     *
+     * @since 6.9.0
+     */
+    enum Space {
+        DefaultSpaces = 0, ///< Use the server default
+        DriveSpace = 1,
+        AppDataFolderSpace = 2,
+        PhotosSpace = 4
+    };
+    Q_DECLARE_FLAGS(Spaces, Space)
+
     struct FieldShorthands {
         /**
          * @since 6.3.0
@@ -47,9 +99,25 @@ public:
          * @since 6.3.0
          */
         static const QStringList &sharingFields();
+        /**
+         * Fields needed to show a file in a listing: ID, title, MIME type,
+         * size, modification date, icon, parents, the starred and trashed
+         * labels and display names of owners.
+         *
+         * @since 6.9.0
+         */
+        static const QStringList &listingFields();
     };
 
     explicit FileFetchJob(const QString &fileId, const AccountPtr &account, QObject *parent = nullptr);
+    /**
+     * @brief Fetches metadata of files @p filesIds
+     *
+     * Up to Job::maxConcurrentRequests() files (8 by default) are fetched at
+     * once. The fetched files are returned from items() in the order of
+     * @p filesIds. Files that do not exist do not fail the job, they are
+     * reported by notFoundFilesIds() instead.
+     */
     explicit FileFetchJob(const QStringList &filesIds, const AccountPtr &account, QObject *parent = nullptr);
     explicit FileFetchJob(const FileSearchQuery &query, const AccountPtr &account, QObject *parent = nullptr);
     explicit FileFetchJob(const AccountPtr &account, QObject *parent = nullptr);
@@ -61,6 +129,81 @@ public:
     bool updateViewedDate() const;
     void setUpdateViewedDate(bool updateViewedDate);
 
+    /**
+     * @brief Returns IDs of requested files that do not exist
+     *
+     * Only files requested via the constructor taking a list of IDs are
+     * reported here, in the order in which they were requested.
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] QStringList notFoundFilesIds() const;
+
+    KGAPI2::ObjectsList items() const override;
+
+    /**
+     * @since 6.9.0
+     */
+    [[nodiscard]] int maxResults() const;
+
+    /**
+     * @brief Sets maximum number of files in a single page of search results
+     *
+     * Values above 1000 are capped to 1000. Raising the page size reduces
+     * the number of requests needed for large listings.
+     *
+     * @since 6.9.0
+     */
+    void setMaxResults(int maxResults);
+
+    /**
+     * @since 6.9.0
+     */
+    [[nodiscard]] int maxQueryLength() const;
+
+    /**
+     * @since 6.9.0
+     */
+    void setMaxQueryLength(int maxQueryLength);
+
+    /**
+     * @since 6.9.0
+     */
+    [[nodiscard]] Corpora corpora() const;
+
+    /**
+     * @brief Sets bodies of items the search applies to
+     *
+     * DriveCorpora requires the shared drive to be set by setDriveId().
+     *
+     * @since 6.9.0
+     */
+    void setCorpora(Corpora corpora);
+
+    /**
+     * @since 6.9.0
+     */
+    [[nodiscard]] QString driveId() const;
+
+    /**
+     * @brief Sets ID of the shared drive to search
+     *
+     * @since 6.9.0
+     */
+    void setDriveId(const QString &driveId);
+
+    /**
+     * @since 6.9.0
+     */
+    [[nodiscard]] Spaces spaces() const;
+
+    /**
+     * @brief Sets spaces to search
+     *
+     * @since 6.9.0
+     */
+    void setSpaces(Spaces spaces);
+
     /**
      * @brief Whether both My Drive and shared drive items should be included in results.
      *
@@ -100,6 +243,7 @@ public:
 protected:
     void start() override;
     KGAPI2::ObjectsList handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData) override;
+    bool handleError(int statusCode, const QByteArray &rawData) override;
 
 private:
     class Private;
@@ -110,3 +254,5 @@ private:
 } // namespace Drive
 
 } // namespace KGAPI2
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(KGAPI2::Drive::FileFetchJob::Spaces)
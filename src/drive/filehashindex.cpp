@@ -0,0 +1,190 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "filehashindex.h"
+#include "file.h"
+#include "parentreference.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QHash>
+#include <QMultiHash>
+
+#include <algorithm>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+static constexpr qint64 ReadBufferSize = 1024 * 1024;
+}
+
+class Q_DECL_HIDDEN FileHashIndex::Private : public QSharedData
+{
+public:
+    Private() = default;
+    Private(const Private &other) = default;
+    ~Private() = default;
+
+    void remove(const QString &fileId);
+
+    QHash<QString /* file ID */, FilePtr> files;
+    QMultiHash<QString /* checksum */, QString /* file ID */> checksums;
+};
+
+void FileHashIndex::Private::remove(const QString &fileId)
+{
+    const FilePtr file = files.take(fileId);
+    if (file) {
+        checksums.remove(file->md5Checksum().toLower(), fileId);
+    }
+}
+
+FileHashIndex::FileHashIndex()
+    : d(new Private)
+{
+}
+
+FileHashIndex::FileHashIndex(const FileHashIndex &other) = default;
+
+FileHashIndex::~FileHashIndex() = default;
+
+FileHashIndex &FileHashIndex::operator=(const FileHashIndex &other) = default;
+
+void FileHashIndex::addFile(const FilePtr &file)
+{
+    if (!file || file->id().isEmpty()) {
+        return;
+    }
+
+    d->remove(file->id());
+    if (file->md5Checksum().isEmpty() || (file->labels() && file->labels()->trashed())) {
+        return;
+    }
+
+    d->files.insert(file->id(), file);
+    d->checksums.insert(file->md5Checksum().toLower(), file->id());
+}
+
+void FileHashIndex::addFiles(const FilesList &files)
+{
+    for (const FilePtr &file : files) {
+        addFile(file);
+    }
+}
+
+void FileHashIndex::removeFile(const QString &fileId)
+{
+    d->remove(fileId);
+}
+
+void FileHashIndex::clear()
+{
+    d->files.clear();
+    d->checksums.clear();
+}
+
+bool FileHashIndex::isEmpty() const
+{
+    return d->files.isEmpty();
+}
+
+int FileHashIndex::count() const
+{
+    return d->files.count();
+}
+
+FilePtr FileHashIndex::file(const QString &fileId) const
+{
+    return d->files.value(fileId);
+}
+
+FilePtr FileHashIndex::find(const QString &md5Checksum, const QString &parentId, const QString &title) const
+{
+    if (md5Checksum.isEmpty() || parentId.isEmpty() || title.isEmpty()) {
+        return FilePtr();
+    }
+
+    const auto fileIds = d->checksums.values(md5Checksum.toLower());
+    for (const QString &fileId : fileIds) {
+        const FilePtr file = d->files.value(fileId);
+        if (file->title() != title) {
+            continue;
+        }
+
+        const auto parents = file->parents();
+        const bool inParent = std::any_of(parents.cbegin(), parents.cend(), [&parentId](const ParentReferencePtr &parent) {
+            return parent && parent->id() == parentId;
+        });
+        if (inParent) {
+            return file;
+        }
+    }
+
+    return FilePtr();
+}
+
+FilePtr FileHashIndex::findDuplicate(const QString &md5Checksum, const FilePtr &metadata) const
+{
+    if (md5Checksum.isEmpty()) {
+        return FilePtr();
+    }
+
+    if (metadata && !metadata->id().isEmpty()) {
+        const FilePtr existing = file(metadata->id());
+        if (existing && existing->md5Checksum().compare(md5Checksum, Qt::CaseInsensitive) == 0) {
+            return existing;
+        }
+        return FilePtr();
+    }
+
+    // Without a title and a parent there is nothing to compare with
+    if (!metadata) {
+        return FilePtr();
+    }
+    const auto parents = metadata->parents();
+    for (const ParentReferencePtr &parent : parents) {
+        if (!parent) {
+            continue;
+        }
+        if (const FilePtr existing = find(md5Checksum, parent->id(), metadata->title())) {
+            return existing;
+        }
+    }
+
+    return FilePtr();
+}
+
+QString FileHashIndex::md5Checksum(QIODevice *device)
+{
+    if (!device || !device->isReadable()) {
+        return QString();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    while (!device->atEnd()) {
+        const QByteArray data = device->read(ReadBufferSize);
+        if (data.isEmpty()) {
+            return QString();
+        }
+        hash.addData(data);
+    }
+
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString FileHashIndex::md5Checksum(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+
+    return md5Checksum(&file);
+}
@@ -0,0 +1,110 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "kgapidrive_export.h"
+#include "types.h"
+
+#include <QSharedDataPointer>
+
+class QIODevice;
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @brief Local index of Drive files by their content checksum
+ *
+ * The index is populated from previous file listings and allows upload jobs
+ * to find out whether a file with identical content already exists in the
+ * target folder without transferring the data again. Only binary files have
+ * a checksum, Google Docs are never indexed.
+ *
+ * @see FileAbstractUploadJob::setDeduplicate
+ * @see FileAbstractResumableJob::setDeduplicate
+ * @since 6.9.0
+ */
+class KGAPIDRIVE_EXPORT FileHashIndex
+{
+public:
+    FileHashIndex();
+    FileHashIndex(const FileHashIndex &other);
+    ~FileHashIndex();
+
+    FileHashIndex &operator=(const FileHashIndex &other);
+
+    /**
+     * @brief Adds @p file to the index, replacing a previous version of it
+     *
+     * Files without a checksum and trashed files are ignored.
+     */
+    void addFile(const FilePtr &file);
+    void addFiles(const FilesList &files);
+
+    /**
+     * @brief Removes file with @p fileId from the index
+     */
+    void removeFile(const QString &fileId);
+
+    void clear();
+
+    [[nodiscard]] bool isEmpty() const;
+    [[nodiscard]] int count() const;
+
+    /**
+     * @brief Returns file with ID @p fileId or a null pointer
+     */
+    [[nodiscard]] FilePtr file(const QString &fileId) const;
+
+    /**
+     * @brief Looks up a file with content identical to @p md5Checksum
+     *
+     * @param md5Checksum Hex-encoded MD5 checksum of the content
+     * @param parentId The file must be in this folder
+     * @param title The file must have exactly this title
+     * @return Returns a matching file or a null pointer, also when
+     *         @p parentId or @p title is empty
+     */
+    [[nodiscard]] FilePtr find(const QString &md5Checksum, const QString &parentId, const QString &title) const;
+
+    /**
+     * @brief Looks up a file that uploading content with @p md5Checksum and
+     *        @p metadata would duplicate
+     *
+     * When @p metadata has an ID the file with that ID is returned if its
+     * content is identical. Otherwise a file with the same title in any of the
+     * parents of @p metadata is looked up. When @p metadata has no title or
+     * no parents, no file is considered a duplicate.
+     */
+    [[nodiscard]] FilePtr findDuplicate(const QString &md5Checksum, const FilePtr &metadata) const;
+
+    /**
+     * @brief Computes hex-encoded MD5 checksum of the remaining content of @p device
+     *
+     * The content is read in small blocks, so files of any size can be hashed.
+     * Returns an empty string when the device can't be read.
+     */
+    [[nodiscard]] static QString md5Checksum(QIODevice *device);
+
+    /**
+     * @brief Computes hex-encoded MD5 checksum of file at @p filePath
+     */
+    [[nodiscard]] static QString md5Checksum(const QString &filePath);
+
+private:
+    class Private;
+    QSharedDataPointer<Private> d;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
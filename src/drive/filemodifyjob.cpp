@@ -12,6 +12,7 @@
 #include "file.h"
 #include "utils.h"
 
+#include <QBuffer>
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
 #include <QUrlQuery>
@@ -29,6 +30,9 @@ public:
     bool createNewRevision = true;
     bool changeModifiedDate = false;
     bool updateViewedDate = true;
+
+    FilePtr original;
+    QBuffer buffer;
 };
 
 FileModifyJob::Private::Private()
@@ -127,6 +131,21 @@ void FileModifyJob::setUpdateViewedDate(bool updateViewedDate)
     d->updateViewedDate = updateViewedDate;
 }
 
+FilePtr FileModifyJob::originalMetadata() const
+{
+    return d->original;
+}
+
+void FileModifyJob::setOriginalMetadata(const FilePtr &original)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify originalMetadata property when job is running";
+        return;
+    }
+
+    d->original = original;
+}
+
 QUrl FileModifyJob::createUrl(const QString &filePath, const FilePtr &metaData)
 {
     QUrl url;
@@ -148,9 +167,35 @@ QUrl FileModifyJob::createUrl(const QString &filePath, const FilePtr &metaData)
     return url;
 }
 
+QNetworkReply *FileModifyJob::dispatchBody(QNetworkAccessManager *accessManager, const QNetworkRequest &request, QIODevice *body)
+{
+    return accessManager->put(request, body);
+}
+
+QString FileModifyJob::targetFileId(const QString &filePath) const
+{
+    return d->files.value(filePath);
+}
+
 QNetworkReply *FileModifyJob::dispatch(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data)
 {
-    return accessManager->put(request, data);
+    const QString filePath = request.attribute(QNetworkRequest::User).toString();
+    if (d->original.isNull() || !filePath.startsWith(QLatin1StringView("?=")) || d->files.value(filePath) != d->original->id()) {
+        return accessManager->put(request, data);
+    }
+
+    const QByteArray patch = Utils::createMergePatch(File::toJSON(d->original, serializationOptions()), data);
+
+    QNetworkRequest r = request;
+    r.setHeader(QNetworkRequest::ContentLengthHeader, patch.size());
+    if (!d->original->etag().isEmpty()) {
+        r.setRawHeader("If-Match", d->original->etag().toUtf8());
+    }
+
+    d->buffer.close();
+    d->buffer.setData(patch);
+    d->buffer.open(QIODevice::ReadOnly);
+    return accessManager->sendCustomRequest(r, "PATCH", &d->buffer);
 }
 
 #include "moc_filemodifyjob.cpp"
@@ -68,8 +68,22 @@ public:
     [[nodiscard]] bool updateViewedDate() const;
     void setUpdateViewedDate(bool updateViewedDate);
 
+    /**
+     * @brief Sets the last fetched state of the file
+     *
+     * When set, metadata-only modifications are sent as a PATCH request
+     * carrying only the changed metadata fields, conditional on the ETag of
+     * @p original. Modifications that upload file content are not affected.
+     *
+     * @since 6.9.0
+     */
+    void setOriginalMetadata(const FilePtr &original);
+    [[nodiscard]] FilePtr originalMetadata() const;
+
 protected:
     QNetworkReply *dispatch(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data) override;
+    QNetworkReply *dispatchBody(QNetworkAccessManager *accessManager, const QNetworkRequest &request, QIODevice *body) override;
+    QString targetFileId(const QString &filePath) const override;
     [[nodiscard]] QUrl createUrl(const QString &filePath, const FilePtr &metaData) override;
 
 private:
@@ -113,4 +113,9 @@ QUrl FileResumableModifyJob::createUrl()
     return url;
 }
 
+QString FileResumableModifyJob::targetFileId() const
+{
+    return d->fileId;
+}
+
 #include "moc_fileresumablemodifyjob.cpp"
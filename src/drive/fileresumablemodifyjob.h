@@ -70,6 +70,7 @@ public:
 
 protected:
     QUrl createUrl() override;
+    QString targetFileId() const override;
 
 private:
     class Private;
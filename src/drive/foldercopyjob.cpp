@@ -0,0 +1,339 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "foldercopyjob.h"
+#include "account.h"
+#include "debug.h"
+#include "driveservice.h"
+#include "file.h"
+#include "foldertreefetchjob.h"
+#include "parentreference.h"
+#include "utils.h"
+
+#include <QFile>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QUrlQuery>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+static constexpr int DefaultConcurrentRequests = 8;
+static const QString RootAlias = QStringLiteral("root");
+}
+
+class Q_DECL_HIDDEN FolderCopyJob::Private
+{
+public:
+    Private(FolderCopyJob *parent);
+
+    void listingFinished(FolderTreeFetchJob *job);
+    bool createNextLevel();
+    bool copyFiles();
+    void enqueueCopy(const QString &sourceId, bool isFolder);
+
+    void loadJournal();
+    void appendJournal(const QString &sourceId, const QString &copyId);
+
+    QString sourceFolderId;
+    QString destinationFolderId;
+    QString journalPath;
+
+    QHash<QString /* source ID */, QString /* source parent ID */> sourceParents;
+    QHash<QString /* source ID */, QString /* title */> titles;
+    QList<QStringList> folderLevels;
+    QStringList files;
+    int currentLevel = 0;
+    int pendingFolders = 0;
+
+    QHash<QString /* source ID */, QString /* copy ID */> copies;
+    QFile journal;
+
+private:
+    FolderCopyJob *const q;
+};
+
+FolderCopyJob::Private::Private(FolderCopyJob *parent)
+    : q(parent)
+{
+}
+
+void FolderCopyJob::Private::listingFinished(FolderTreeFetchJob *job)
+{
+    job->deleteLater();
+    if (job->error() != KGAPI2::NoError) {
+        q->setError(job->error());
+        q->setErrorString(job->errorString());
+        q->emitFinished();
+        return;
+    }
+
+    // Folders are always listed before their content
+    QHash<QString, int> depths = {{sourceFolderId, 0}};
+    const auto items = job->items();
+    for (const ObjectPtr &item : items) {
+        const FilePtr file = item.dynamicCast<File>();
+        const auto parents = file->parents();
+        for (const ParentReferencePtr &parent : parents) {
+            // Files in the root folder refer to it by its real ID, not by the alias
+            const QString parentId = parent->isRoot() && sourceFolderId == RootAlias ? RootAlias : parent->id();
+            const auto depth = depths.constFind(parentId);
+            if (depth == depths.cend()) {
+                continue;
+            }
+
+            sourceParents.insert(file->id(), parentId);
+            titles.insert(file->id(), file->title());
+            if (file->isFolder()) {
+                const int level = *depth;
+                depths.insert(file->id(), level + 1);
+                if (folderLevels.size() <= level) {
+                    folderLevels.resize(level + 1);
+                }
+                folderLevels[level].append(file->id());
+            } else {
+                files.append(file->id());
+            }
+            break;
+        }
+    }
+
+    qCDebug(KGAPIDebug) << "Copying" << sourceParents.size() << "files and folders," << copies.size() - 1 << "already copied";
+    q->emitProgress(copies.size() - 1, sourceParents.size());
+    if (!createNextLevel() && !copyFiles()) {
+        q->emitFinished();
+    }
+}
+
+bool FolderCopyJob::Private::createNextLevel()
+{
+    while (currentLevel < folderLevels.size()) {
+        const QStringList &folders = folderLevels.at(currentLevel++);
+        for (const QString &folderId : folders) {
+            if (!copies.contains(folderId)) {
+                enqueueCopy(folderId, true);
+                ++pendingFolders;
+            }
+        }
+        if (pendingFolders > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FolderCopyJob::Private::copyFiles()
+{
+    bool enqueued = false;
+    for (const QString &fileId : std::as_const(files)) {
+        if (!copies.contains(fileId)) {
+            enqueueCopy(fileId, false);
+            enqueued = true;
+        }
+    }
+    return enqueued;
+}
+
+void FolderCopyJob::Private::enqueueCopy(const QString &sourceId, bool isFolder)
+{
+    FilePtr file(new File());
+    file->setTitle(titles.value(sourceId));
+    file->setParents({ParentReferencePtr(new ParentReference(copies.value(sourceParents.value(sourceId))))});
+
+    QUrl url;
+    if (isFolder) {
+        // Folders cannot be copied, they are created anew
+        file->setMimeType(File::folderMimeType());
+        url = DriveService::uploadMetadataFileUrl(QString());
+    } else {
+        url = DriveService::copyFileUrl(sourceId);
+    }
+    QUrlQuery query(url);
+    query.addQueryItem(QStringLiteral("supportsAllDrives"), Utils::bool2Str(true));
+    url.setQuery(query);
+
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::User, sourceId);
+    q->enqueueRequest(request, File::toJSON(file), QStringLiteral("application/json"));
+}
+
+void FolderCopyJob::Private::loadJournal()
+{
+    copies = {{sourceFolderId, destinationFolderId}};
+    journal.close();
+
+    if (journalPath.isEmpty()) {
+        return;
+    }
+    journal.setFileName(journalPath);
+
+    // The journal is a header line followed by one line per created copy
+    bool resume = false;
+    bool lastLineComplete = true;
+    if (journal.open(QIODevice::ReadOnly)) {
+        const QJsonObject header = QJsonDocument::fromJson(journal.readLine()).object();
+        if (header.value(QLatin1StringView("sourceFolderId")).toString() == sourceFolderId
+            && header.value(QLatin1StringView("destinationFolderId")).toString() == destinationFolderId) {
+            resume = true;
+            while (!journal.atEnd()) {
+                const QByteArray line = journal.readLine();
+                lastLineComplete = line.endsWith('\n');
+                // A line cut short by an interrupted write is skipped
+                const QJsonObject entry = QJsonDocument::fromJson(line).object();
+                const QString sourceId = entry.value(QLatin1StringView("source")).toString();
+                const QString copyId = entry.value(QLatin1StringView("copy")).toString();
+                if (!sourceId.isEmpty() && !copyId.isEmpty()) {
+                    copies.insert(sourceId, copyId);
+                }
+            }
+            qCDebug(KGAPIDebug) << "Resuming copy from journal" << journalPath << "with" << copies.size() - 1 << "copies";
+        } else {
+            qCWarning(KGAPIDebug) << "Ignoring journal" << journalPath << "of a different copy";
+        }
+        journal.close();
+    }
+
+    if (!journal.open(resume ? QIODevice::WriteOnly | QIODevice::Append : QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(KGAPIDebug) << "Failed to open journal" << journalPath << journal.errorString();
+        return;
+    }
+    if (!resume) {
+        QJsonObject header;
+        header.insert(QLatin1StringView("sourceFolderId"), sourceFolderId);
+        header.insert(QLatin1StringView("destinationFolderId"), destinationFolderId);
+        journal.write(QJsonDocument(header).toJson(QJsonDocument::Compact) + '\n');
+    } else if (!lastLineComplete) {
+        journal.write("\n");
+    }
+    journal.flush();
+}
+
+void FolderCopyJob::Private::appendJournal(const QString &sourceId, const QString &copyId)
+{
+    if (!journal.isOpen()) {
+        return;
+    }
+
+    QJsonObject entry;
+    entry.insert(QLatin1StringView("source"), sourceId);
+    entry.insert(QLatin1StringView("copy"), copyId);
+    // Flushed right away, so an interrupted job only loses the copies in flight
+    if (journal.write(QJsonDocument(entry).toJson(QJsonDocument::Compact) + '\n') < 0 || !journal.flush()) {
+        qCWarning(KGAPIDebug) << "Failed to write journal" << journalPath << journal.errorString();
+    }
+}
+
+FolderCopyJob::FolderCopyJob(const QString &sourceFolderId, const QString &destinationFolderId, const AccountPtr &account, QObject *parent)
+    : CreateJob(account, parent)
+    , d(new Private(this))
+{
+    d->sourceFolderId = sourceFolderId;
+    d->destinationFolderId = destinationFolderId;
+    setMaxConcurrentRequests(DefaultConcurrentRequests);
+}
+
+FolderCopyJob::~FolderCopyJob() = default;
+
+QString FolderCopyJob::sourceFolderId() const
+{
+    return d->sourceFolderId;
+}
+
+QString FolderCopyJob::destinationFolderId() const
+{
+    return d->destinationFolderId;
+}
+
+QString FolderCopyJob::journalPath() const
+{
+    return d->journalPath;
+}
+
+void FolderCopyJob::setJournalPath(const QString &journalPath)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify journalPath property when job is running";
+        return;
+    }
+
+    d->journalPath = journalPath;
+}
+
+QString FolderCopyJob::copiedFileId(const QString &sourceFileId) const
+{
+    return sourceFileId == d->sourceFolderId ? QString() : d->copies.value(sourceFileId);
+}
+
+void FolderCopyJob::start()
+{
+    d->sourceParents.clear();
+    d->titles.clear();
+    d->folderLevels.clear();
+    d->files.clear();
+    d->currentLevel = 0;
+    d->pendingFolders = 0;
+    d->loadJournal();
+
+    auto job = new FolderTreeFetchJob(d->sourceFolderId, account(), this);
+    job->setFields({File::Fields::Id, File::Fields::Title, File::Fields::MimeType, File::Fields::Labels, File::Fields::Parents});
+    connect(job, &Job::finished, this, [this, job]() {
+        d->listingFinished(job);
+    });
+}
+
+void FolderCopyJob::aboutToFinish()
+{
+    d->journal.close();
+    if (!d->journalPath.isEmpty() && error() == KGAPI2::NoError) {
+        QFile::remove(d->journalPath);
+    }
+
+    CreateJob::aboutToFinish();
+}
+
+ObjectsList FolderCopyJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
+{
+    const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+    if (Utils::stringToContentType(contentType) != KGAPI2::JSON) {
+        setError(KGAPI2::InvalidResponse);
+        setErrorString(tr("Invalid response content type"));
+        emitFinished();
+        return ObjectsList();
+    }
+
+    const FilePtr copy = File::fromJSON(rawData);
+    if (!copy) {
+        setError(KGAPI2::InvalidResponse);
+        setErrorString(tr("Invalid response"));
+        emitFinished();
+        return ObjectsList();
+    }
+
+    const QString sourceId = currentRequest().attribute(QNetworkRequest::User).toString();
+    d->copies.insert(sourceId, copy->id());
+    d->appendJournal(sourceId, copy->id());
+    emitProgress(d->copies.size() - 1, d->sourceParents.size());
+
+    if (copy->isFolder()) {
+        // The next level can only be created once all its parents exist
+        if (--d->pendingFolders == 0) {
+            if (!d->createNextLevel()) {
+                d->copyFiles();
+            }
+        }
+    }
+
+    return {copy};
+}
+
+#include "moc_foldercopyjob.cpp"
@@ -0,0 +1,81 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "createjob.h"
+#include "kgapidrive_export.h"
+
+#include <QScopedPointer>
+#include <QString>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @brief Copies content of a folder, including all subfolders, to another folder
+ *
+ * The source tree is listed first (see FolderTreeFetchJob). Then the folders
+ * are recreated in the destination folder level by level, all folders of one
+ * level at once, and finally all files are copied on the server. Up to
+ * Job::maxConcurrentRequests() requests (8 by default) are in flight at once.
+ *
+ * When a journal path is set, the IDs of all created folders and copies are
+ * appended there as soon as they are created. If the job fails, it can be started again with the same
+ * journal and it will continue where it stopped instead of copying
+ * everything again.
+ *
+ * The created folders and copies are available from items() when the job
+ * finishes. Trashed files are not copied.
+ *
+ * @since 6.9.0
+ */
+class KGAPIDRIVE_EXPORT FolderCopyJob : public KGAPI2::CreateJob
+{
+    Q_OBJECT
+
+public:
+    explicit FolderCopyJob(const QString &sourceFolderId, const QString &destinationFolderId, const AccountPtr &account, QObject *parent = nullptr);
+    ~FolderCopyJob() override;
+
+    [[nodiscard]] QString sourceFolderId() const;
+    [[nodiscard]] QString destinationFolderId() const;
+
+    /**
+     * @brief Path of the file with the progress journal
+     *
+     * The journal is removed once the job finishes successfully. By default
+     * no journal is kept.
+     */
+    [[nodiscard]] QString journalPath() const;
+    void setJournalPath(const QString &journalPath);
+
+    /**
+     * @brief Returns ID of the copy of file or folder @p sourceFileId
+     *
+     * Returns an empty string when the file has not been copied (yet).
+     */
+    [[nodiscard]] QString copiedFileId(const QString &sourceFileId) const;
+
+protected:
+    void start() override;
+    void aboutToFinish() override;
+    KGAPI2::ObjectsList handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData) override;
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
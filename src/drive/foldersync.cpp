@@ -0,0 +1,1007 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "foldersync.h"
+#include "about.h"
+#include "aboutfetchjob.h"
+#include "account.h"
+#include "change.h"
+#include "changefetchjob.h"
+#include "debug.h"
+#include "file.h"
+#include "filecreatejob.h"
+#include "fileerrors_p.h"
+#include "filefetchcontentjob.h"
+#include "filehashindex.h"
+#include "fileresumablecreatejob.h"
+#include "fileresumablemodifyjob.h"
+#include "filetrashjob.h"
+#include "foldertreefetchjob.h"
+#include "parentreference.h"
+#include "storedfile_p.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMimeDatabase>
+#include <QQueue>
+#include <QSaveFile>
+#include <QSet>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <utility>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+static constexpr int DefaultConcurrentTransfers = 4;
+
+// A file as it was on both sides after the last synchronization
+struct StateEntry {
+    QString fileId;
+    QString md5;
+    qint64 size = 0;
+    qint64 mtime = 0;
+};
+
+struct LocalEntry {
+    QString md5;
+    qint64 size = 0;
+    qint64 mtime = 0;
+};
+
+struct LocalScan {
+    QHash<QString /* path */, LocalEntry> files;
+    QStringList dirs;
+};
+
+struct Transfer {
+    enum Type {
+        Download,
+        Upload,
+    };
+
+    Type type = Download;
+    QString path;
+    // File to download, or to replace by the upload; null for new uploads
+    FilePtr remote;
+};
+}
+
+class Q_DECL_HIDDEN FolderSync::Private
+{
+public:
+    Private(FolderSync *parent);
+
+    void fetchAbout();
+    void listFolder(const QString &folderId);
+    void fetchChanges();
+    void removeRemote(const QString &fileId);
+    bool checkJob(Job *job);
+
+    void scanLocal();
+    static LocalScan scan(const QString &root, const QHash<QString, StateEntry> &known, const QString &excludedPath);
+    void reconcile(const LocalScan &scan);
+    void resolveRemotePaths();
+    void resolveConflict(const QString &path, const FilePtr &remote);
+    void removeLocal(const QString &path);
+
+    void trashRemote(const QHash<QString /* file ID */, QString /* path */> &files);
+    void createFolders();
+    void createFolder(const QString &path, const QString &parentId);
+    void startTransfers();
+    bool download(const Transfer &transfer);
+    void downloadFinished(FileFetchContentJob *job, const Transfer &transfer, QSaveFile *saveFile);
+    bool upload(const Transfer &transfer);
+    void uploadFinished(FileAbstractResumableJob *job, const Transfer &transfer);
+    void fileFailed(const QString &path, Error error, const QString &errorString);
+    void maybeFinish();
+
+    bool isInTree(const FilePtr &file) const;
+    QString remotePath(const QString &fileId, QHash<QString, QString> &paths) const;
+    bool changedSinceScan(const QString &path) const;
+    QString conflictPath(const QString &path) const;
+    QString absolutePath(const QString &path) const;
+    static QString parentPath(const QString &path);
+
+    void load();
+    void restore();
+    bool save();
+
+    AccountPtr account;
+    QString localPath;
+    QString remoteFolderId;
+    QString statePath;
+    int maxConcurrentTransfers = DefaultConcurrentTransfers;
+    bool synchronizing = false;
+
+    // Persisted state
+    QString rootId;
+    qlonglong largestChangeId = 0;
+    QHash<QString /* path */, StateEntry> entries;
+    QHash<QString /* file ID */, FilePtr> remoteFiles;
+
+    // State of the current synchronization
+    QThreadPool pool;
+    int pendingListings = 0;
+    LocalScan local;
+    QHash<QString /* path */, FilePtr> remoteByPath;
+    QSet<QString /* file ID */> unresolvedFiles;
+    QHash<QString /* path */, QString /* folder ID */> remoteFolders;
+    QStringList foldersToCreate;
+    int foldersInFlight = 0;
+    bool trashing = false;
+    QQueue<Transfer> transfers;
+    int transfersInFlight = 0;
+    FileErrors errors;
+
+private:
+    FolderSync *const q;
+};
+
+FolderSync::Private::Private(FolderSync *parent)
+    : q(parent)
+{
+    // Hashing is disk-bound, scans of the same tree would only compete
+    pool.setMaxThreadCount(1);
+}
+
+void FolderSync::Private::fetchAbout()
+{
+    // Remember the change ID before listing the files, changes done during the
+    // listing are then applied again by the next synchronization
+    auto job = new AboutFetchJob(account, q);
+    QObject::connect(job, &Job::finished, q, [this, job]() {
+        job->deleteLater();
+        if (!checkJob(job)) {
+            return;
+        }
+
+        const AboutPtr about = job->aboutData();
+        largestChangeId = about->largestChangeId();
+        rootId = remoteFolderId == QLatin1StringView("root") ? about->rootFolderId() : remoteFolderId;
+        remoteFiles.clear();
+        listFolder(rootId);
+    });
+}
+
+void FolderSync::Private::listFolder(const QString &folderId)
+{
+    auto job = new FolderTreeFetchJob(folderId, account, q);
+    QObject::connect(job, &Job::finished, q, [this, job]() {
+        job->deleteLater();
+        if (!synchronizing || !checkJob(job)) {
+            return;
+        }
+
+        const auto items = job->items();
+        for (const ObjectPtr &item : items) {
+            const FilePtr file = item.dynamicCast<File>();
+            if (file) {
+                remoteFiles.insert(file->id(), file);
+            }
+        }
+
+        if (--pendingListings == 0) {
+            scanLocal();
+        }
+    });
+    ++pendingListings;
+}
+
+void FolderSync::Private::fetchChanges()
+{
+    auto job = new ChangeFetchJob(account, q);
+    job->setStartChangeId(largestChangeId + 1);
+    QObject::connect(job, &Job::finished, q, [this, job]() {
+        job->deleteLater();
+        if (!checkJob(job)) {
+            return;
+        }
+
+        const auto items = job->items();
+        qCDebug(KGAPIDebug) << "Applying" << items.count() << "changes to folder synchronization";
+        qlonglong changeId = qMax(largestChangeId, job->largestChangeId());
+        QStringList newFolders;
+        for (const ObjectPtr &item : items) {
+            const ChangePtr change = item.dynamicCast<Change>();
+            if (!change) {
+                continue;
+            }
+            changeId = qMax(changeId, change->id());
+
+            const FilePtr file = change->file();
+            if (change->deleted() || !file || (file->labels() && file->labels()->trashed()) || !isInTree(file)) {
+                removeRemote(change->fileId());
+                continue;
+            }
+
+            // The content of folders moved into the tree is not part of the
+            // changes, they have to be listed
+            if (file->isFolder() && !remoteFiles.contains(file->id())) {
+                newFolders.append(file->id());
+            }
+            remoteFiles.insert(file->id(), file);
+        }
+        largestChangeId = changeId;
+
+        for (const QString &folderId : std::as_const(newFolders)) {
+            const FilePtr folder = remoteFiles.value(folderId);
+            if (!folder) {
+                continue;
+            }
+            const auto parents = folder->parents();
+            // Subfolders of a new folder are listed together with it
+            const bool listedWithParent = std::any_of(parents.cbegin(), parents.cend(), [&newFolders](const ParentReferencePtr &parent) {
+                return parent && newFolders.contains(parent->id());
+            });
+            if (!listedWithParent) {
+                listFolder(folderId);
+            }
+        }
+
+        if (pendingListings == 0) {
+            scanLocal();
+        }
+    });
+}
+
+void FolderSync::Private::removeRemote(const QString &fileId)
+{
+    // The changes only list the folder that left the tree, not its content.
+    // Drop the content as well, unless it is in another folder of the tree.
+    QStringList removed{fileId};
+    while (!removed.isEmpty()) {
+        const FilePtr file = remoteFiles.take(removed.takeLast());
+        if (!file || !file->isFolder()) {
+            continue;
+        }
+
+        for (auto it = remoteFiles.cbegin(), end = remoteFiles.cend(); it != end; ++it) {
+            bool inFolder = false;
+            bool inTree = false;
+            const auto parents = (*it)->parents();
+            for (const ParentReferencePtr &parent : parents) {
+                if (!parent) {
+                    continue;
+                }
+                if (parent->id() == file->id()) {
+                    inFolder = true;
+                } else if (parent->id() == rootId || remoteFiles.contains(parent->id())) {
+                    inTree = true;
+                }
+            }
+            if (inFolder && !inTree) {
+                removed.append(it.key());
+            }
+        }
+    }
+}
+
+bool FolderSync::Private::checkJob(Job *job)
+{
+    if (job->error() == KGAPI2::NoError) {
+        return true;
+    }
+
+    qCWarning(KGAPIDebug) << "Folder synchronization failed:" << job->errorString();
+    if (synchronizing) {
+        synchronizing = false;
+        pendingListings = 0;
+        // Changes applied so far would be lost with the failed listing, start over next time
+        restore();
+        Q_EMIT q->error(q, job->error(), job->errorString());
+    }
+    return false;
+}
+
+void FolderSync::Private::scanLocal()
+{
+    const QString root = localPath;
+    const QHash<QString, StateEntry> known = entries;
+    const QString excludedPath = QFileInfo(statePath).absoluteFilePath();
+    pool.start([this, root, known, excludedPath]() {
+        const LocalScan result = scan(root, known, excludedPath);
+        QMetaObject::invokeMethod(
+            q,
+            [this, result]() {
+                reconcile(result);
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+LocalScan FolderSync::Private::scan(const QString &root, const QHash<QString, StateEntry> &known, const QString &excludedPath)
+{
+    LocalScan result;
+    const QDir rootDir(root);
+    QDirIterator it(root, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden | QDir::NoSymLinks, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString filePath = it.next();
+        const QFileInfo info = it.fileInfo();
+        const QString path = rootDir.relativeFilePath(filePath);
+        if (info.isDir()) {
+            result.dirs.append(path);
+            continue;
+        }
+        if (info.absoluteFilePath() == excludedPath) {
+            continue;
+        }
+
+        LocalEntry entry;
+        entry.size = info.size();
+        entry.mtime = info.lastModified().toMSecsSinceEpoch();
+
+        // Only hash files that may have changed
+        const auto state = known.constFind(path);
+        if (state != known.cend() && state->size == entry.size && state->mtime == entry.mtime) {
+            entry.md5 = state->md5;
+        } else {
+            entry.md5 = FileHashIndex::md5Checksum(filePath);
+            if (entry.md5.isEmpty()) {
+                qCWarning(KGAPIDebug) << "Skipping unreadable file" << filePath;
+                continue;
+            }
+        }
+        result.files.insert(path, entry);
+    }
+    return result;
+}
+
+void FolderSync::Private::reconcile(const LocalScan &scan)
+{
+    if (!synchronizing) {
+        return;
+    }
+
+    local = scan;
+    resolveRemotePaths();
+
+    for (auto it = remoteFolders.cbegin(), end = remoteFolders.cend(); it != end; ++it) {
+        if (!it.key().isEmpty() && !QDir(localPath).mkpath(it.key())) {
+            qCWarning(KGAPIDebug) << "Failed to create local folder" << absolutePath(it.key());
+        }
+    }
+
+    foldersToCreate.clear();
+    for (const QString &dir : std::as_const(local.dirs)) {
+        if (!remoteFolders.contains(dir)) {
+            foldersToCreate.append(dir);
+        }
+    }
+    // The scan order depends on the file system
+    std::sort(foldersToCreate.begin(), foldersToCreate.end());
+
+    QSet<QString> allPaths;
+    for (auto it = entries.cbegin(), end = entries.cend(); it != end; ++it) {
+        allPaths.insert(it.key());
+    }
+    for (auto it = local.files.cbegin(), end = local.files.cend(); it != end; ++it) {
+        allPaths.insert(it.key());
+    }
+    for (auto it = remoteByPath.cbegin(), end = remoteByPath.cend(); it != end; ++it) {
+        allPaths.insert(it.key());
+    }
+    QStringList paths(allPaths.cbegin(), allPaths.cend());
+    std::sort(paths.begin(), paths.end());
+
+    QHash<QString, QString> toTrash;
+    for (const QString &path : std::as_const(paths)) {
+        const auto localIt = local.files.constFind(path);
+        const bool hasLocal = localIt != local.files.cend();
+        const FilePtr remote = remoteByPath.value(path);
+        const auto state = entries.constFind(path);
+        const bool hasState = state != entries.cend();
+
+        if (hasLocal && remote && localIt->md5 == remote->md5Checksum()) {
+            entries.insert(path, {remote->id(), localIt->md5, localIt->size, localIt->mtime});
+            continue;
+        }
+
+        const bool localChanged = hasLocal && (!hasState || localIt->md5 != state->md5);
+        const bool remoteChanged = remote && (!hasState || remote->md5Checksum() != state->md5 || remote->id() != state->fileId);
+        if (hasLocal && remote) {
+            if (localChanged && remoteChanged) {
+                resolveConflict(path, remote);
+            } else if (localChanged) {
+                transfers.enqueue({Transfer::Upload, path, remote});
+            } else {
+                transfers.enqueue({Transfer::Download, path, remote});
+            }
+        } else if (hasLocal) {
+            if (hasState && unresolvedFiles.contains(state->fileId)) {
+                // The file still exists, only its path is not known, e.g. because
+                // of an incomplete state. Never delete data on such grounds.
+                fileFailed(path, KGAPI2::UnknownError, tr("Path of the remote file of %1 could not be resolved").arg(path));
+            } else if (hasState && !localChanged) {
+                removeLocal(path);
+            } else {
+                transfers.enqueue({Transfer::Upload, path, FilePtr()});
+            }
+        } else if (remote) {
+            if (hasState && !remoteChanged) {
+                toTrash.insert(remote->id(), path);
+            } else {
+                transfers.enqueue({Transfer::Download, path, remote});
+            }
+        } else {
+            entries.remove(path);
+        }
+    }
+
+    qCDebug(KGAPIDebug) << "Folder synchronization:" << transfers.size() << "transfers," << toTrash.size() << "remote removals,"
+                        << foldersToCreate.size() << "new remote folders";
+    trashRemote(toTrash);
+    createFolders();
+}
+
+void FolderSync::Private::resolveRemotePaths()
+{
+    remoteByPath.clear();
+    unresolvedFiles.clear();
+    remoteFolders = {{QString(), rootId}};
+
+    QSet<QString> documents;
+    QHash<QString, QString> paths;
+    for (const FilePtr &file : std::as_const(remoteFiles)) {
+        const QString path = remotePath(file->id(), paths);
+        if (path.isEmpty()) {
+            unresolvedFiles.insert(file->id());
+            continue;
+        }
+        if (file->isFolder()) {
+            remoteFolders.insert(path, file->id());
+            continue;
+        }
+        // Google Docs have no content that could be synchronized
+        if (file->md5Checksum().isEmpty()) {
+            documents.insert(path);
+            continue;
+        }
+
+        auto existing = remoteByPath.find(path);
+        if (existing != remoteByPath.end()) {
+            // Drive allows several files with the same title, always pick the same one
+            const QString knownId = entries.value(path).fileId;
+            if ((*existing)->id() == knownId || (file->id() != knownId && (*existing)->id() < file->id())) {
+                continue;
+            }
+            *existing = file;
+        } else {
+            remoteByPath.insert(path, file);
+        }
+    }
+
+    for (const QString &path : std::as_const(documents)) {
+        remoteByPath.remove(path);
+        local.files.remove(path);
+        entries.remove(path);
+    }
+}
+
+void FolderSync::Private::resolveConflict(const QString &path, const FilePtr &remote)
+{
+    const QString conflict = conflictPath(path);
+    if (!QFile::rename(absolutePath(path), absolutePath(conflict))) {
+        fileFailed(path, KGAPI2::Conflict, tr("File %1 was modified on both sides and could not be renamed").arg(path));
+        return;
+    }
+
+    qCDebug(KGAPIDebug) << "Conflicting changes of" << path << ", local version moved to" << conflict;
+    Q_EMIT q->conflictDetected(q, path, conflict);
+    local.files.insert(conflict, local.files.take(path));
+    transfers.enqueue({Transfer::Download, path, remote});
+    transfers.enqueue({Transfer::Upload, conflict, FilePtr()});
+}
+
+void FolderSync::Private::removeLocal(const QString &path)
+{
+    // Keep the file recoverable, it may have been removed from Drive by mistake
+    const QString filePath = absolutePath(path);
+    if (!QFile::moveToTrash(filePath) && !QFile::remove(filePath)) {
+        fileFailed(path, KGAPI2::UnknownError, tr("Failed to remove %1").arg(filePath));
+        return;
+    }
+
+    entries.remove(path);
+    Q_EMIT q->fileSynchronized(q, path, RemovedLocally);
+}
+
+void FolderSync::Private::trashRemote(const QHash<QString, QString> &files)
+{
+    if (files.isEmpty()) {
+        return;
+    }
+
+    auto job = new FileTrashJob(QStringList(files.keyBegin(), files.keyEnd()), account, q);
+    QObject::connect(job, &Job::finished, q, [this, job, files]() {
+        job->deleteLater();
+        trashing = false;
+        for (auto it = files.cbegin(), end = files.cend(); it != end; ++it) {
+            const Error error = job->error() != KGAPI2::NoError ? job->error() : job->fileError(it.key());
+            if (error != KGAPI2::NoError) {
+                fileFailed(it.value(), error, job->error() != KGAPI2::NoError ? job->errorString() : job->fileErrorString(it.key()));
+                continue;
+            }
+            remoteFiles.remove(it.key());
+            entries.remove(it.value());
+            Q_EMIT q->fileSynchronized(q, it.value(), RemovedRemotely);
+        }
+        maybeFinish();
+    });
+    trashing = true;
+}
+
+void FolderSync::Private::createFolders()
+{
+    // A folder needs the ID of its parent. Create all folders whose parent
+    // exists at once, their subfolders follow as soon as they are created.
+    for (auto it = foldersToCreate.begin(); it != foldersToCreate.end();) {
+        const QString parentId = remoteFolders.value(parentPath(*it));
+        if (parentId.isEmpty()) {
+            ++it;
+            continue;
+        }
+        createFolder(*it, parentId);
+        it = foldersToCreate.erase(it);
+    }
+
+    if (foldersInFlight == 0) {
+        // Creating the parents of the remaining folders failed, uploads into
+        // them fail as well
+        foldersToCreate.clear();
+        startTransfers();
+    }
+}
+
+void FolderSync::Private::createFolder(const QString &path, const QString &parentId)
+{
+    FilePtr folder(new File());
+    folder->setTitle(QFileInfo(path).fileName());
+    folder->setMimeType(File::folderMimeType());
+    folder->setParents({ParentReferencePtr(new ParentReference(parentId))});
+
+    auto job = new FileCreateJob(folder, account, q);
+    QObject::connect(job, &Job::finished, q, [this, job, path]() {
+        job->deleteLater();
+        --foldersInFlight;
+        const auto created = job->files();
+        if (job->error() != KGAPI2::NoError || created.isEmpty()) {
+            qCWarning(KGAPIDebug) << "Failed to create folder" << path << ":" << job->errorString();
+        } else {
+            const FilePtr createdFolder = created.first();
+            remoteFiles.insert(createdFolder->id(), createdFolder);
+            remoteFolders.insert(path, createdFolder->id());
+        }
+        createFolders();
+    });
+    ++foldersInFlight;
+}
+
+void FolderSync::Private::startTransfers()
+{
+    while ((maxConcurrentTransfers <= 0 || transfersInFlight < maxConcurrentTransfers) && !transfers.isEmpty()) {
+        const Transfer transfer = transfers.dequeue();
+        if (transfer.type == Transfer::Download ? download(transfer) : upload(transfer)) {
+            ++transfersInFlight;
+        }
+    }
+
+    maybeFinish();
+}
+
+bool FolderSync::Private::download(const Transfer &transfer)
+{
+    const QString filePath = absolutePath(transfer.path);
+    if (!QDir().mkpath(QFileInfo(filePath).path())) {
+        fileFailed(transfer.path, KGAPI2::UnknownError, tr("Failed to create folder for %1").arg(filePath));
+        return false;
+    }
+
+    // The local file is only replaced once the download succeeds
+    auto saveFile = new QSaveFile(filePath);
+    if (!saveFile->open(QIODevice::WriteOnly)) {
+        fileFailed(transfer.path, KGAPI2::UnknownError, tr("Failed to open %1 for writing: %2").arg(filePath, saveFile->errorString()));
+        delete saveFile;
+        return false;
+    }
+
+    auto job = new FileFetchContentJob(transfer.remote, account, q);
+    saveFile->setParent(job);
+    job->setDestination(saveFile);
+    QObject::connect(job, &Job::finished, q, [this, job, transfer, saveFile]() {
+        downloadFinished(job, transfer, saveFile);
+    });
+    return true;
+}
+
+void FolderSync::Private::downloadFinished(FileFetchContentJob *job, const Transfer &transfer, QSaveFile *saveFile)
+{
+    job->deleteLater();
+    --transfersInFlight;
+
+    if (job->error() != KGAPI2::NoError) {
+        fileFailed(transfer.path, job->error(), job->errorString());
+    } else if (changedSinceScan(transfer.path)) {
+        // Don't overwrite changes the user made in the meantime, the next
+        // synchronization will handle them
+        saveFile->cancelWriting();
+        fileFailed(transfer.path, KGAPI2::Conflict, tr("File %1 was modified during synchronization").arg(transfer.path));
+    } else if (!saveFile->commit()) {
+        fileFailed(transfer.path, KGAPI2::UnknownError, tr("Failed to write %1: %2").arg(saveFile->fileName(), saveFile->errorString()));
+    } else {
+        const QFileInfo info(absolutePath(transfer.path));
+        entries.insert(transfer.path, {transfer.remote->id(), transfer.remote->md5Checksum(), info.size(), info.lastModified().toMSecsSinceEpoch()});
+        Q_EMIT q->fileSynchronized(q, transfer.path, Downloaded);
+    }
+
+    startTransfers();
+}
+
+bool FolderSync::Private::upload(const Transfer &transfer)
+{
+    const QString filePath = absolutePath(transfer.path);
+    const QString parentId = remoteFolders.value(parentPath(transfer.path));
+    if (!transfer.remote && parentId.isEmpty()) {
+        fileFailed(transfer.path, KGAPI2::NotFound, tr("Folder of %1 could not be created in Drive").arg(transfer.path));
+        return false;
+    }
+
+    auto file = new QFile(filePath);
+    if (!file->open(QIODevice::ReadOnly)) {
+        fileFailed(transfer.path, KGAPI2::UnknownError, tr("Failed to open %1: %2").arg(filePath, file->errorString()));
+        delete file;
+        return false;
+    }
+
+    FileAbstractResumableJob *job = nullptr;
+    if (transfer.remote) {
+        job = new FileResumableModifyJob(file, transfer.remote->id(), account, q);
+    } else {
+        FilePtr metadata(new File());
+        metadata->setTitle(QFileInfo(filePath).fileName());
+        metadata->setMimeType(QMimeDatabase().mimeTypeForFile(filePath).name());
+        metadata->setParents({ParentReferencePtr(new ParentReference(parentId))});
+        job = new FileResumableCreateJob(file, metadata, account, q);
+    }
+    file->setParent(job);
+    job->setUploadSize(file->size());
+    QObject::connect(job, &Job::finished, q, [this, job, transfer]() {
+        uploadFinished(job, transfer);
+    });
+    return true;
+}
+
+void FolderSync::Private::uploadFinished(FileAbstractResumableJob *job, const Transfer &transfer)
+{
+    job->deleteLater();
+    --transfersInFlight;
+
+    const FilePtr uploaded = job->metadata();
+    if (job->error() != KGAPI2::NoError || !uploaded || uploaded->id().isEmpty()) {
+        fileFailed(transfer.path, job->error() != KGAPI2::NoError ? job->error() : KGAPI2::InvalidResponse, job->errorString());
+    } else {
+        // The file may have changed while it was being uploaded. Store what
+        // Drive has, the next scan then uploads the file again if needed.
+        const LocalEntry scanned = local.files.value(transfer.path);
+        const QString md5 = uploaded->md5Checksum().isEmpty() ? scanned.md5 : uploaded->md5Checksum();
+        remoteFiles.insert(uploaded->id(), uploaded);
+        entries.insert(transfer.path, {uploaded->id(), md5, scanned.size, scanned.mtime});
+        Q_EMIT q->fileSynchronized(q, transfer.path, Uploaded);
+    }
+
+    startTransfers();
+}
+
+void FolderSync::Private::fileFailed(const QString &path, Error error, const QString &errorString)
+{
+    qCWarning(KGAPIDebug) << "Failed to synchronize" << path << ":" << errorString;
+    errors.insert(path, error, errorString);
+}
+
+void FolderSync::Private::maybeFinish()
+{
+    if (!synchronizing || foldersInFlight > 0 || trashing || transfersInFlight > 0 || !transfers.isEmpty()) {
+        return;
+    }
+
+    synchronizing = false;
+    local = LocalScan();
+    remoteByPath.clear();
+    unresolvedFiles.clear();
+    remoteFolders.clear();
+
+    if (!save()) {
+        Q_EMIT q->error(q, KGAPI2::UnknownError, tr("Failed to store synchronization state in %1").arg(statePath));
+        return;
+    }
+    Q_EMIT q->synchronized(q);
+}
+
+bool FolderSync::Private::isInTree(const FilePtr &file) const
+{
+    const auto parents = file->parents();
+    return std::any_of(parents.cbegin(), parents.cend(), [this](const ParentReferencePtr &parent) {
+        if (!parent) {
+            return false;
+        }
+        const FilePtr folder = remoteFiles.value(parent->id());
+        return parent->id() == rootId || (folder && folder->isFolder());
+    });
+}
+
+QString FolderSync::Private::remotePath(const QString &fileId, QHash<QString, QString> &paths) const
+{
+    const auto known = paths.constFind(fileId);
+    if (known != paths.cend()) {
+        return *known;
+    }
+
+    // Empty path for files outside of the tree
+    paths.insert(fileId, QString());
+    const FilePtr file = remoteFiles.value(fileId);
+    if (!file) {
+        return QString();
+    }
+
+    QString title = file->title();
+    title.replace(QLatin1Char('/'), QLatin1Char('_'));
+    if (title.isEmpty()) {
+        return QString();
+    }
+
+    QString path;
+    const auto parents = file->parents();
+    for (const ParentReferencePtr &parent : parents) {
+        if (!parent) {
+            continue;
+        }
+        if (parent->id() == rootId) {
+            path = title;
+            break;
+        }
+        const FilePtr folder = remoteFiles.value(parent->id());
+        if (!folder || !folder->isFolder()) {
+            continue;
+        }
+        const QString folderPath = remotePath(parent->id(), paths);
+        if (!folderPath.isEmpty()) {
+            path = folderPath + QLatin1Char('/') + title;
+            break;
+        }
+    }
+
+    paths.insert(fileId, path);
+    return path;
+}
+
+bool FolderSync::Private::changedSinceScan(const QString &path) const
+{
+    const QFileInfo info(absolutePath(path));
+    const auto scanned = local.files.constFind(path);
+    if (scanned == local.files.cend()) {
+        return info.exists();
+    }
+    return !info.exists() || info.size() != scanned->size || info.lastModified().toMSecsSinceEpoch() != scanned->mtime;
+}
+
+QString FolderSync::Private::conflictPath(const QString &path) const
+{
+    const int slash = path.lastIndexOf(QLatin1Char('/'));
+    const QString dir = path.left(slash + 1);
+    const QString name = path.mid(slash + 1);
+    const int dot = name.lastIndexOf(QLatin1Char('.'));
+    const QString base = dot > 0 ? name.left(dot) : name;
+    const QString suffix = dot > 0 ? name.mid(dot) : QString();
+
+    // Not translated, the name must not depend on the locale of the machine
+    for (int i = 1;; ++i) {
+        const QString marker = i == 1 ? QStringLiteral(" (conflicted copy)") : QStringLiteral(" (conflicted copy %1)").arg(i);
+        const QString candidate = dir + base + marker + suffix;
+        if (!QFileInfo::exists(absolutePath(candidate)) && !entries.contains(candidate) && !remoteByPath.contains(candidate)) {
+            return candidate;
+        }
+    }
+}
+
+QString FolderSync::Private::absolutePath(const QString &path) const
+{
+    return QDir(localPath).filePath(path);
+}
+
+QString FolderSync::Private::parentPath(const QString &path)
+{
+    const int slash = path.lastIndexOf(QLatin1Char('/'));
+    return slash < 0 ? QString() : path.left(slash);
+}
+
+void FolderSync::Private::load()
+{
+    QFile store(statePath);
+    if (!store.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(store.readAll()).object();
+    if (root.value(QLatin1StringView("localPath")).toString() != localPath
+        || root.value(QLatin1StringView("remoteFolderId")).toString() != remoteFolderId) {
+        qCWarning(KGAPIDebug) << "Ignoring state" << statePath << "of a different synchronization";
+        return;
+    }
+
+    largestChangeId = root.value(QLatin1StringView("largestChangeId")).toVariant().toLongLong();
+    rootId = root.value(QLatin1StringView("rootFolderId")).toString();
+
+    const QJsonObject states = root.value(QLatin1StringView("entries")).toObject();
+    for (auto it = states.constBegin(); it != states.constEnd(); ++it) {
+        const QJsonObject state = it.value().toObject();
+        StateEntry entry;
+        entry.fileId = state.value(QLatin1StringView("id")).toString();
+        entry.md5 = state.value(QLatin1StringView("md5")).toString();
+        entry.size = state.value(QLatin1StringView("size")).toVariant().toLongLong();
+        entry.mtime = state.value(QLatin1StringView("mtime")).toVariant().toLongLong();
+        entries.insert(it.key(), entry);
+    }
+
+    const QJsonArray items = root.value(QLatin1StringView("remote")).toArray();
+    for (const QJsonValue &item : items) {
+        const FilePtr file = File::fromJSON(item.toObject().toVariantMap());
+        if (file && !file->id().isEmpty()) {
+            remoteFiles.insert(file->id(), file);
+        }
+    }
+    qCDebug(KGAPIDebug) << "Loaded" << entries.count() << "synchronized files from" << statePath;
+}
+
+void FolderSync::Private::restore()
+{
+    rootId.clear();
+    largestChangeId = 0;
+    entries.clear();
+    remoteFiles.clear();
+    load();
+}
+
+bool FolderSync::Private::save()
+{
+    QJsonObject states;
+    for (auto it = entries.cbegin(), end = entries.cend(); it != end; ++it) {
+        // Same as in the API, int64 values are stored as strings
+        states.insert(it.key(),
+                      QJsonObject{{QStringLiteral("id"), it->fileId},
+                                  {QStringLiteral("md5"), it->md5},
+                                  {QStringLiteral("size"), QString::number(it->size)},
+                                  {QStringLiteral("mtime"), QString::number(it->mtime)}});
+    }
+
+    QJsonArray items;
+    for (const FilePtr &file : std::as_const(remoteFiles)) {
+        const QVariantMap data = StoredFile::toJSON(file);
+        if (!data.isEmpty()) {
+            items.append(QJsonObject::fromVariantMap(data));
+        }
+    }
+
+    QJsonObject root;
+    root.insert(QLatin1StringView("localPath"), localPath);
+    root.insert(QLatin1StringView("remoteFolderId"), remoteFolderId);
+    root.insert(QLatin1StringView("rootFolderId"), rootId);
+    root.insert(QLatin1StringView("largestChangeId"), QString::number(largestChangeId));
+    root.insert(QLatin1StringView("entries"), states);
+    root.insert(QLatin1StringView("remote"), items);
+
+    QSaveFile store(statePath);
+    if (!store.open(QIODevice::WriteOnly)) {
+        qCWarning(KGAPIDebug) << "Failed to open synchronization state" << statePath << store.errorString();
+        return false;
+    }
+    store.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return store.commit();
+}
+
+FolderSync::FolderSync(const AccountPtr &account, const QString &localPath, const QString &remoteFolderId, const QString &statePath, QObject *parent)
+    : QObject(parent)
+    , d(new Private(this))
+{
+    d->account = account;
+    d->localPath = localPath;
+    d->remoteFolderId = remoteFolderId;
+    d->statePath = statePath;
+
+    d->load();
+}
+
+FolderSync::~FolderSync()
+{
+    // The scan posts its result to this object, it must not outlive it
+    d->pool.waitForDone();
+}
+
+AccountPtr FolderSync::account() const
+{
+    return d->account;
+}
+
+void FolderSync::setAccount(const AccountPtr &account)
+{
+    d->account = account;
+}
+
+QString FolderSync::localPath() const
+{
+    return d->localPath;
+}
+
+QString FolderSync::remoteFolderId() const
+{
+    return d->remoteFolderId;
+}
+
+QString FolderSync::statePath() const
+{
+    return d->statePath;
+}
+
+int FolderSync::maxConcurrentTransfers() const
+{
+    return d->maxConcurrentTransfers;
+}
+
+void FolderSync::setMaxConcurrentTransfers(int count)
+{
+    d->maxConcurrentTransfers = count;
+}
+
+bool FolderSync::isSynchronizing() const
+{
+    return d->synchronizing;
+}
+
+QStringList FolderSync::failedPaths() const
+{
+    QStringList paths = d->errors.keys();
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+Error FolderSync::fileError(const QString &path) const
+{
+    return d->errors.error(path);
+}
+
+QString FolderSync::fileErrorString(const QString &path) const
+{
+    return d->errors.errorString(path);
+}
+
+void FolderSync::synchronize()
+{
+    if (d->synchronizing) {
+        return;
+    }
+
+    d->synchronizing = true;
+    d->errors.clear();
+    d->transfers.clear();
+    if (d->largestChangeId > 0 && !d->rootId.isEmpty()) {
+        d->fetchChanges();
+    } else {
+        d->fetchAbout();
+    }
+}
+
+#include "moc_foldersync.cpp"
@@ -0,0 +1,159 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "kgapidrive_export.h"
+#include "types.h"
+
+#include <QObject>
+#include <QScopedPointer>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @brief Two-way synchronization of a local directory with a Drive folder
+ *
+ * Each synchronize() compares both sides with the state of the last
+ * synchronization, which is persisted in a JSON file:
+ *
+ * @li Local changes are detected by modification time and size, the content
+ *     is only hashed when those differ, to rule out files that were merely
+ *     touched.
+ * @li Remote changes are fetched from the changes feed. Only the first
+ *     synchronization, and folders that are moved into the synchronized
+ *     folder, are listed in full.
+ *
+ * Only files that changed are transferred, up to maxConcurrentTransfers()
+ * at once. Uploads use resumable upload sessions and all transfers obey the
+ * limits set in BandwidthLimiter.
+ *
+ * Conflicts are resolved the same way on every run:
+ * @li When both sides modified a file, the remote version keeps the name and
+ *     the local version is renamed to "name (conflicted copy).ext" and
+ *     uploaded as a new file.
+ * @li A modification wins over a deletion, the deleted side gets the file back.
+ *
+ * Google Docs have no binary content and are skipped, as are local files at
+ * their paths. Folders are created on both sides as needed, but never deleted.
+ * Renamed and moved files are transferred again.
+ *
+ * A file that fails to transfer is reported via failedPaths() and retried by
+ * the next synchronize().
+ *
+ * @since 6.9.0
+ */
+class KGAPIDRIVE_EXPORT FolderSync : public QObject
+{
+    Q_OBJECT
+
+    /**
+     * Maximum number of files uploaded or downloaded at once.
+     * Default value is 4.
+     */
+    Q_PROPERTY(int maxConcurrentTransfers READ maxConcurrentTransfers WRITE setMaxConcurrentTransfers)
+
+public:
+    enum Action {
+        Uploaded, ///< Local file was uploaded to Drive
+        Downloaded, ///< Remote file was downloaded
+        RemovedLocally, ///< Local file was deleted because it was removed from Drive
+        RemovedRemotely, ///< Remote file was trashed because it was deleted locally
+    };
+    Q_ENUM(Action)
+
+    /**
+     * @brief Constructs synchronization of @p localPath with folder @p remoteFolderId
+     *
+     * The "root" alias can be used for the root folder. If @p statePath exists
+     * and belongs to the same pair of folders, the state of the last
+     * synchronization is loaded from it.
+     */
+    explicit FolderSync(const AccountPtr &account,
+                        const QString &localPath,
+                        const QString &remoteFolderId,
+                        const QString &statePath,
+                        QObject *parent = nullptr);
+    ~FolderSync() override;
+
+    [[nodiscard]] AccountPtr account() const;
+    void setAccount(const AccountPtr &account);
+
+    [[nodiscard]] QString localPath() const;
+    [[nodiscard]] QString remoteFolderId() const;
+    [[nodiscard]] QString statePath() const;
+
+    [[nodiscard]] int maxConcurrentTransfers() const;
+    void setMaxConcurrentTransfers(int count);
+
+    /**
+     * @brief Returns whether a synchronization is in progress
+     */
+    [[nodiscard]] bool isSynchronizing() const;
+
+    /**
+     * @brief Returns paths of files that failed to synchronize in the last run
+     *
+     * Paths are relative to localPath() and separated by "/".
+     */
+    [[nodiscard]] QStringList failedPaths() const;
+
+    /**
+     * @brief Returns the error that occurred on file @p path
+     */
+    [[nodiscard]] KGAPI2::Error fileError(const QString &path) const;
+    [[nodiscard]] QString fileErrorString(const QString &path) const;
+
+public Q_SLOTS:
+    /**
+     * @brief Synchronizes both sides
+     *
+     * Emits synchronized() when done, or error() when the remote state could
+     * not be fetched. Does nothing when a synchronization is already in
+     * progress.
+     */
+    void synchronize();
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted when file @p path was synchronized
+     */
+    void fileSynchronized(KGAPI2::Drive::FolderSync *sync, const QString &path, KGAPI2::Drive::FolderSync::Action action);
+
+    /**
+     * @brief Emitted when file @p path was modified on both sides
+     *
+     * The local version was moved to @p conflictPath.
+     */
+    void conflictDetected(KGAPI2::Drive::FolderSync *sync, const QString &path, const QString &conflictPath);
+
+    /**
+     * @brief Emitted when the synchronization finished and the state was stored
+     *
+     * Files that failed to synchronize are listed by failedPaths().
+     */
+    void synchronized(KGAPI2::Drive::FolderSync *sync);
+
+    /**
+     * @brief Emitted when the synchronization fails as a whole
+     */
+    void error(KGAPI2::Drive::FolderSync *sync, KGAPI2::Error error, const QString &errorString);
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
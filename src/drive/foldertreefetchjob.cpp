@@ -0,0 +1,256 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "foldertreefetchjob.h"
+#include "account.h"
+#include "debug.h"
+#include "driveservice.h"
+#include "file.h"
+#include "filesearchquery.h"
+#include "parentreference.h"
+#include "utils.h"
+
+#include <QHash>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QQueue>
+#include <QUrlQuery>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+static constexpr int DefaultConcurrentListings = 4;
+static constexpr int DefaultFolderBatchSize = 10;
+// Largest page size supported by the API
+static constexpr int PageSize = 1000;
+static const QString RootAlias = QStringLiteral("root");
+}
+
+class Q_DECL_HIDDEN FolderTreeFetchJob::Private
+{
+public:
+    Private(FolderTreeFetchJob *parent);
+
+    void processNext();
+    void enqueueListing(const QStringList &folderIds);
+    FilesList processFiles(const FilesList &files);
+    QString parentKey(const ParentReferencePtr &parent) const;
+
+    QString folderId;
+    int maxDepth = -1;
+    int folderBatchSize = DefaultFolderBatchSize;
+    QStringList fields;
+
+    // Folders waiting to be listed, in breadth-first order
+    QQueue<QString> pendingFolders;
+    QHash<QString /* folder ID */, int /* depth */> folderDepths;
+    QHash<QString /* file ID */, QString /* path */> paths;
+    int listingsInFlight = 0;
+
+private:
+    FolderTreeFetchJob *const q;
+};
+
+FolderTreeFetchJob::Private::Private(FolderTreeFetchJob *parent)
+    : q(parent)
+{
+}
+
+void FolderTreeFetchJob::Private::processNext()
+{
+    const int window = q->maxConcurrentRequests() > 0 ? q->maxConcurrentRequests() : DefaultConcurrentListings;
+    while (listingsInFlight < window && !pendingFolders.isEmpty()) {
+        QStringList batch;
+        while (batch.size() < folderBatchSize && !pendingFolders.isEmpty()) {
+            batch.append(pendingFolders.dequeue());
+        }
+        enqueueListing(batch);
+    }
+}
+
+void FolderTreeFetchJob::Private::enqueueListing(const QStringList &folderIds)
+{
+    FileSearchQuery query(FileSearchQuery::Or);
+    for (const QString &id : folderIds) {
+        query.addQuery(FileSearchQuery::Parents, FileSearchQuery::In, id);
+    }
+
+    QUrl url = DriveService::fetchFilesUrl();
+    QUrlQuery urlQuery(url);
+    urlQuery.addQueryItem(QStringLiteral("q"), query.serialize());
+    urlQuery.addQueryItem(QStringLiteral("maxResults"), QString::number(PageSize));
+    urlQuery.addQueryItem(QStringLiteral("includeItemsFromAllDrives"), Utils::bool2Str(true));
+    urlQuery.addQueryItem(QStringLiteral("supportsAllDrives"), Utils::bool2Str(true));
+    url.setQuery(urlQuery);
+
+    q->enqueueRequest(QNetworkRequest(url));
+    ++listingsInFlight;
+}
+
+FilesList FolderTreeFetchJob::Private::processFiles(const FilesList &files)
+{
+    FilesList result;
+    result.reserve(files.size());
+    for (const FilePtr &file : files) {
+        if (paths.contains(file->id()) || (file->labels() && file->labels()->trashed())) {
+            continue;
+        }
+
+        // The file may be in several folders, use the first one we are listing
+        const auto parents = file->parents();
+        for (const ParentReferencePtr &parent : parents) {
+            const QString key = parentKey(parent);
+            const auto depth = folderDepths.constFind(key);
+            if (depth == folderDepths.cend()) {
+                continue;
+            }
+
+            const QString parentPath = paths.value(key);
+            const QString path = parentPath.isEmpty() ? file->title() : parentPath + QLatin1Char('/') + file->title();
+            paths.insert(file->id(), path);
+            result.append(file);
+
+            if (file->isFolder() && !folderDepths.contains(file->id()) && (maxDepth < 0 || *depth + 1 < maxDepth)) {
+                folderDepths.insert(file->id(), *depth + 1);
+                pendingFolders.enqueue(file->id());
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+QString FolderTreeFetchJob::Private::parentKey(const ParentReferencePtr &parent) const
+{
+    // Files in the root folder refer to it by its real ID, not by the alias
+    return parent->isRoot() && folderId == RootAlias ? RootAlias : parent->id();
+}
+
+FolderTreeFetchJob::FolderTreeFetchJob(const QString &folderId, const AccountPtr &account, QObject *parent)
+    : FetchJob(account, parent)
+    , d(new Private(this))
+{
+    d->folderId = folderId;
+    setMaxConcurrentRequests(DefaultConcurrentListings);
+}
+
+FolderTreeFetchJob::~FolderTreeFetchJob() = default;
+
+QString FolderTreeFetchJob::folderId() const
+{
+    return d->folderId;
+}
+
+int FolderTreeFetchJob::maxDepth() const
+{
+    return d->maxDepth;
+}
+
+void FolderTreeFetchJob::setMaxDepth(int maxDepth)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify maxDepth property when job is running";
+        return;
+    }
+
+    d->maxDepth = maxDepth;
+}
+
+int FolderTreeFetchJob::folderBatchSize() const
+{
+    return d->folderBatchSize;
+}
+
+void FolderTreeFetchJob::setFolderBatchSize(int folderBatchSize)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify folderBatchSize property when job is running";
+        return;
+    }
+
+    d->folderBatchSize = qMax(1, folderBatchSize);
+}
+
+void FolderTreeFetchJob::setFields(const QStringList &fields)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify fields property when job is running";
+        return;
+    }
+
+    d->fields = fields;
+}
+
+QStringList FolderTreeFetchJob::fields() const
+{
+    return d->fields;
+}
+
+QString FolderTreeFetchJob::relativePath(const QString &fileId) const
+{
+    return d->paths.value(fileId);
+}
+
+void FolderTreeFetchJob::start()
+{
+    d->pendingFolders.clear();
+    d->folderDepths.clear();
+    d->paths.clear();
+    d->listingsInFlight = 0;
+
+    if (!d->fields.isEmpty()) {
+        QStringList fields = d->fields;
+        for (const QString &field : {File::Fields::Kind, File::Fields::Id, File::Fields::Title, File::Fields::MimeType, File::Fields::Labels, File::Fields::Parents}) {
+            if (!fields.contains(field)) {
+                fields << field;
+            }
+        }
+        Job::setFields({File::Fields::Kind, File::Fields::NextLink, File::Fields::NextPageToken, Job::buildSubfields(File::Fields::Items, fields)});
+    }
+
+    d->folderDepths.insert(d->folderId, 0);
+    d->pendingFolders.enqueue(d->folderId);
+    d->processNext();
+}
+
+ObjectsList FolderTreeFetchJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
+{
+    const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+    if (Utils::stringToContentType(contentType) != KGAPI2::JSON) {
+        setError(KGAPI2::InvalidResponse);
+        setErrorString(tr("Invalid response content type"));
+        emitFinished();
+        return ObjectsList();
+    }
+
+    FeedData feedData;
+    const FilesList files = d->processFiles(File::fromJSONFeed(rawData, feedData));
+
+    if (feedData.nextPageUrl.isValid()) {
+        // The listing keeps its slot until all its pages are fetched
+        enqueueRequest(QNetworkRequest(feedData.nextPageUrl));
+    } else {
+        --d->listingsInFlight;
+        d->processNext();
+    }
+
+    if (!files.isEmpty()) {
+        Q_EMIT filesFetched(this, files);
+    }
+
+    ObjectsList items;
+    items.reserve(files.size());
+    for (const FilePtr &file : files) {
+        items.append(file);
+    }
+    return items;
+}
+
+#include "moc_foldertreefetchjob.cpp"
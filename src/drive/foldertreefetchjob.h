@@ -0,0 +1,106 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "fetchjob.h"
+#include "kgapidrive_export.h"
+
+#include <QScopedPointer>
+#include <QStringList>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @brief Lists all files in a folder and its subfolders
+ *
+ * The folder hierarchy is walked breadth-first. At most
+ * Job::maxConcurrentRequests() folder listings (4 by default) are in flight at
+ * once, and up to folderBatchSize() folders are listed by a single query, so
+ * trees with many small folders need only a fraction of the requests.
+ *
+ * Files are reported via filesFetched() as soon as they are received, and
+ * their paths relative to the listed folder are available via relativePath().
+ * Trashed files are skipped.
+ *
+ * @since 6.9.0
+ */
+class KGAPIDRIVE_EXPORT FolderTreeFetchJob : public KGAPI2::FetchJob
+{
+    Q_OBJECT
+
+    /**
+     * Maximum number of folder levels to list below the folder.
+     * Default value is -1, i.e. the whole tree is listed.
+     *
+     * This property can be modified only when the job is not running.
+     */
+    Q_PROPERTY(int maxDepth READ maxDepth WRITE setMaxDepth)
+
+    /**
+     * Maximum number of folders listed by a single query.
+     * Default value is 10.
+     *
+     * This property can be modified only when the job is not running.
+     */
+    Q_PROPERTY(int folderBatchSize READ folderBatchSize WRITE setFolderBatchSize)
+
+public:
+    explicit FolderTreeFetchJob(const QString &folderId, const AccountPtr &account, QObject *parent = nullptr);
+    ~FolderTreeFetchJob() override;
+
+    [[nodiscard]] QString folderId() const;
+
+    [[nodiscard]] int maxDepth() const;
+    void setMaxDepth(int maxDepth);
+
+    [[nodiscard]] int folderBatchSize() const;
+    void setFolderBatchSize(int folderBatchSize);
+
+    /**
+     * @brief Sets file fields to fetch
+     *
+     * ID, title, MIME type, labels and parents are always fetched, as the job
+     * needs them to walk the tree.
+     */
+    void setFields(const QStringList &fields);
+    [[nodiscard]] QStringList fields() const;
+
+    /**
+     * @brief Returns path of file @p fileId relative to the listed folder
+     *
+     * Path components are separated by "/". Returns an empty string for files
+     * that have not been listed (yet).
+     */
+    [[nodiscard]] QString relativePath(const QString &fileId) const;
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted for every received page of @p files
+     *
+     * The files are also available from items() once the job finishes.
+     */
+    void filesFetched(KGAPI2::Drive::FolderTreeFetchJob *job, const KGAPI2::Drive::FilesList &files);
+
+protected:
+    void start() override;
+    KGAPI2::ObjectsList handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData) override;
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
@@ -0,0 +1,325 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "permissionbulkjob.h"
+#include "account.h"
+#include "debug.h"
+#include "driveservice.h"
+#include "fileerrors_p.h"
+#include "permission.h"
+#include "utils.h"
+
+#include <QHash>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QUrlQuery>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+static constexpr int DefaultConcurrentRequests = 8;
+static const auto RemovalRequestAttribute = static_cast<QNetworkRequest::Attribute>(QNetworkRequest::User + 1);
+
+struct FileResult {
+    int pendingRequests = 0;
+    int pendingRemovals = 0;
+    PermissionsList created;
+};
+}
+
+class Q_DECL_HIDDEN PermissionBulkJob::Private
+{
+public:
+    Private(PermissionBulkJob *parent);
+
+    void enqueueCreate(const QString &fileId, const PermissionPtr &permission);
+    void enqueueRemove(const QString &fileId, const QString &permissionId);
+    void enqueueCreates(const QString &fileId);
+    void requestFinished(const QString &fileId, bool isRemoval);
+
+    QStringList filesIds;
+    PermissionsList permissions;
+    QStringList removedPermissionsIds;
+    QString emailMessage;
+    bool sendNotificationEmails = true;
+    bool useDomainAdminAccess = false;
+
+    QHash<QString /* file ID */, FileResult> results;
+    FileErrors errors;
+    int processedRequests = 0;
+    int totalRequests = 0;
+
+private:
+    PermissionBulkJob *const q;
+};
+
+PermissionBulkJob::Private::Private(PermissionBulkJob *parent)
+    : q(parent)
+{
+}
+
+void PermissionBulkJob::Private::enqueueCreate(const QString &fileId, const PermissionPtr &permission)
+{
+    QUrl url = DriveService::createPermissionUrl(fileId);
+    QUrlQuery query(url);
+    query.addQueryItem(QStringLiteral("supportsAllDrives"), Utils::bool2Str(true));
+    if (!sendNotificationEmails) {
+        query.addQueryItem(QStringLiteral("sendNotificationEmails"), Utils::bool2Str(sendNotificationEmails));
+    } else if (!emailMessage.isEmpty()) {
+        query.addQueryItem(QStringLiteral("emailMessage"), emailMessage);
+    }
+    if (useDomainAdminAccess) {
+        query.addQueryItem(QStringLiteral("useDomainAdminAccess"), Utils::bool2Str(useDomainAdminAccess));
+    }
+    url.setQuery(query);
+
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::User, fileId);
+    q->enqueueRequest(request, Permission::toJSON(permission), QStringLiteral("application/json"));
+}
+
+void PermissionBulkJob::Private::enqueueRemove(const QString &fileId, const QString &permissionId)
+{
+    QUrl url = DriveService::deletePermissionUrl(fileId, permissionId);
+    QUrlQuery query(url);
+    query.addQueryItem(QStringLiteral("supportsAllDrives"), Utils::bool2Str(true));
+    if (useDomainAdminAccess) {
+        query.addQueryItem(QStringLiteral("useDomainAdminAccess"), Utils::bool2Str(useDomainAdminAccess));
+    }
+    url.setQuery(query);
+
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::User, fileId);
+    request.setAttribute(RemovalRequestAttribute, true);
+    q->enqueueRequest(request);
+}
+
+void PermissionBulkJob::Private::enqueueCreates(const QString &fileId)
+{
+    for (const PermissionPtr &permission : std::as_const(permissions)) {
+        enqueueCreate(fileId, permission);
+    }
+}
+
+void PermissionBulkJob::Private::requestFinished(const QString &fileId, bool isRemoval)
+{
+    q->emitProgress(++processedRequests, totalRequests);
+
+    auto it = results.find(fileId);
+    if (it == results.end()) {
+        return;
+    }
+    if (isRemoval && --it->pendingRemovals == 0) {
+        enqueueCreates(fileId);
+    }
+    if (--it->pendingRequests == 0) {
+        Q_EMIT q->fileProcessed(q, fileId);
+    }
+}
+
+PermissionBulkJob::PermissionBulkJob(const QStringList &filesIds, const AccountPtr &account, QObject *parent)
+    : Job(account, parent)
+    , d(new Private(this))
+{
+    d->filesIds = filesIds;
+    d->filesIds.removeDuplicates();
+    setMaxConcurrentRequests(DefaultConcurrentRequests);
+}
+
+PermissionBulkJob::~PermissionBulkJob() = default;
+
+QStringList PermissionBulkJob::filesIds() const
+{
+    return d->filesIds;
+}
+
+PermissionsList PermissionBulkJob::permissions() const
+{
+    return d->permissions;
+}
+
+void PermissionBulkJob::setPermissions(const PermissionsList &permissions)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify permissions property when job is running";
+        return;
+    }
+
+    d->permissions = permissions;
+}
+
+QStringList PermissionBulkJob::removedPermissionsIds() const
+{
+    return d->removedPermissionsIds;
+}
+
+void PermissionBulkJob::setRemovedPermissionsIds(const QStringList &permissionsIds)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify removedPermissionsIds property when job is running";
+        return;
+    }
+
+    d->removedPermissionsIds = permissionsIds;
+}
+
+bool PermissionBulkJob::sendNotificationEmails() const
+{
+    return d->sendNotificationEmails;
+}
+
+void PermissionBulkJob::setSendNotificationEmails(bool sendNotificationEmails)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify sendNotificationEmails property when job is running";
+        return;
+    }
+
+    d->sendNotificationEmails = sendNotificationEmails;
+}
+
+QString PermissionBulkJob::emailMessage() const
+{
+    return d->emailMessage;
+}
+
+void PermissionBulkJob::setEmailMessage(const QString &emailMessage)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify emailMessage property when job is running";
+        return;
+    }
+
+    d->emailMessage = emailMessage;
+}
+
+bool PermissionBulkJob::useDomainAdminAccess() const
+{
+    return d->useDomainAdminAccess;
+}
+
+void PermissionBulkJob::setUseDomainAdminAccess(bool useDomainAdminAccess)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify useDomainAdminAccess property when job is running";
+        return;
+    }
+
+    d->useDomainAdminAccess = useDomainAdminAccess;
+}
+
+PermissionsList PermissionBulkJob::createdPermissions(const QString &fileId) const
+{
+    return d->results.value(fileId).created;
+}
+
+QStringList PermissionBulkJob::failedFilesIds() const
+{
+    QStringList ids;
+    for (const QString &fileId : std::as_const(d->filesIds)) {
+        if (d->errors.contains(fileId)) {
+            ids << fileId;
+        }
+    }
+    return ids;
+}
+
+Error PermissionBulkJob::fileError(const QString &fileId) const
+{
+    return d->errors.error(fileId);
+}
+
+QString PermissionBulkJob::fileErrorString(const QString &fileId) const
+{
+    return d->errors.errorString(fileId);
+}
+
+void PermissionBulkJob::start()
+{
+    d->results.clear();
+    d->errors.clear();
+    d->processedRequests = 0;
+
+    const int requestsPerFile = d->permissions.size() + d->removedPermissionsIds.size();
+    d->totalRequests = d->filesIds.size() * requestsPerFile;
+    if (d->totalRequests == 0) {
+        emitFinished();
+        return;
+    }
+
+    for (const QString &fileId : std::as_const(d->filesIds)) {
+        FileResult &result = d->results[fileId];
+        result.pendingRequests = requestsPerFile;
+        result.pendingRemovals = d->removedPermissionsIds.size();
+        // Permissions are added once the removals from the file are done
+        if (result.pendingRemovals == 0) {
+            d->enqueueCreates(fileId);
+        }
+        for (const QString &permissionId : std::as_const(d->removedPermissionsIds)) {
+            d->enqueueRemove(fileId, permissionId);
+        }
+    }
+}
+
+void PermissionBulkJob::dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType)
+{
+    if (request.attribute(RemovalRequestAttribute).toBool()) {
+        accessManager->deleteResource(request);
+        return;
+    }
+
+    QNetworkRequest r = request;
+    if (!r.hasRawHeader("Content-Type")) {
+        r.setHeader(QNetworkRequest::ContentTypeHeader, contentType);
+    }
+    accessManager->post(r, data);
+}
+
+void PermissionBulkJob::handleReply(const QNetworkReply *reply, const QByteArray &rawData)
+{
+    const QNetworkRequest request = currentRequest();
+    const QString fileId = request.attribute(QNetworkRequest::User).toString();
+    const bool isRemoval = request.attribute(RemovalRequestAttribute).toBool();
+
+    if (!isRemoval) {
+        const QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+        if (Utils::stringToContentType(contentType) == KGAPI2::JSON) {
+            d->results[fileId].created << Permission::fromJSON(rawData);
+        } else if (!d->errors.contains(fileId)) {
+            d->errors.insert(fileId, KGAPI2::InvalidResponse, tr("Invalid response content type"));
+        }
+    }
+
+    d->requestFinished(fileId, isRemoval);
+}
+
+bool PermissionBulkJob::handleError(int statusCode, const QByteArray &rawData)
+{
+    if (!FileErrors::isFileError(statusCode, rawData)) {
+        // Errors that are not specific to a single file abort the whole job
+        return Job::handleError(statusCode, rawData);
+    }
+
+    const QNetworkRequest request = currentRequest();
+    const QString fileId = request.attribute(QNetworkRequest::User).toString();
+    const bool isRemoval = request.attribute(RemovalRequestAttribute).toBool();
+
+    // Removing a permission that does not exist is not an error, only the first error of a file is kept
+    if (!(isRemoval && statusCode == KGAPI2::NotFound) && !d->errors.contains(fileId)) {
+        d->errors.insertReply(fileId, statusCode, rawData);
+        qCWarning(KGAPIDebug) << "Failed to change permissions of file" << fileId << ":" << d->errors.errorString(fileId);
+    }
+
+    d->requestFinished(fileId, isRemoval);
+    return true;
+}
+
+#include "moc_permissionbulkjob.cpp"
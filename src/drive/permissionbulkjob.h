@@ -0,0 +1,124 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "job.h"
+#include "kgapidrive_export.h"
+#include "types.h"
+
+#include <QScopedPointer>
+#include <QStringList>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @brief Adds and removes permissions of many files at once
+ *
+ * Every permission set by setPermissions() is added to, and every permission
+ * set by setRemovedPermissionsIds() is removed from, each of the files. Up to
+ * Job::maxConcurrentRequests() requests (8 by default) are in flight at once.
+ * Permissions are only added to a file once the removals from it are done,
+ * so replacing a permission of a user does not race with removing the old one.
+ *
+ * A failure on one file does not abort the job. Results are collected per
+ * file, see createdPermissions(), failedFilesIds() and fileError(), and
+ * fileProcessed() is emitted as soon as all changes of a file are done.
+ *
+ * @since 6.9.0
+ */
+class KGAPIDRIVE_EXPORT PermissionBulkJob : public KGAPI2::Job
+{
+    Q_OBJECT
+
+public:
+    explicit PermissionBulkJob(const QStringList &filesIds, const AccountPtr &account, QObject *parent = nullptr);
+    ~PermissionBulkJob() override;
+
+    [[nodiscard]] QStringList filesIds() const;
+
+    /**
+     * @brief Permissions to add to each file
+     */
+    [[nodiscard]] PermissionsList permissions() const;
+    void setPermissions(const PermissionsList &permissions);
+
+    /**
+     * @brief IDs of permissions to remove from each file
+     *
+     * The permission ID of a user or a group is the same for all files, so
+     * this can be used to revoke someone's access to all of the files.
+     * Files that do not have the permission are not reported as failed.
+     */
+    [[nodiscard]] QStringList removedPermissionsIds() const;
+    void setRemovedPermissionsIds(const QStringList &permissionsIds);
+
+    /**
+     * @brief Whether to send notification emails when sharing to users or
+     * groups. (Default: true)
+     *
+     * Disabling notifications avoids sending an email for each of the files.
+     */
+    [[nodiscard]] bool sendNotificationEmails() const;
+    void setSendNotificationEmails(bool sendNotificationEmails);
+
+    /**
+     * @brief The plain text custom message to include in notification emails.
+     */
+    [[nodiscard]] QString emailMessage() const;
+    void setEmailMessage(const QString &emailMessage);
+
+    /**
+     * @brief Issue the requests as a domain administrator. (Default: false)
+     */
+    [[nodiscard]] bool useDomainAdminAccess() const;
+    void setUseDomainAdminAccess(bool useDomainAdminAccess);
+
+    /**
+     * @brief Returns permissions that were added to file @p fileId
+     */
+    [[nodiscard]] PermissionsList createdPermissions(const QString &fileId) const;
+
+    /**
+     * @brief Returns IDs of files on which at least one change failed
+     */
+    [[nodiscard]] QStringList failedFilesIds() const;
+
+    /**
+     * @brief Returns the first error that occurred on file @p fileId
+     */
+    [[nodiscard]] KGAPI2::Error fileError(const QString &fileId) const;
+    [[nodiscard]] QString fileErrorString(const QString &fileId) const;
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted when all changes of file @p fileId are done
+     *
+     * Use fileError() to check whether they succeeded.
+     */
+    void fileProcessed(KGAPI2::Drive::PermissionBulkJob *job, const QString &fileId);
+
+protected:
+    void start() override;
+    void dispatchRequest(QNetworkAccessManager *accessManager, const QNetworkRequest &request, const QByteArray &data, const QString &contentType) override;
+    void handleReply(const QNetworkReply *reply, const QByteArray &rawData) override;
+    bool handleError(int statusCode, const QByteArray &rawData) override;
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
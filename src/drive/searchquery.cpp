@@ -23,6 +23,9 @@ public:
     static QString compareOperatorToString(CompareOperator op);
     static QString logicOperatorToString(LogicOperator op);
 
+    static QList<SearchQuery> splitDisjunction(const SearchQuery &query, int maxLength);
+    static QList<SearchQuery> splitConjunction(const SearchQuery &query, int maxLength);
+
     QList<SearchQuery> subqueries;
     QString field;
     QString value;
@@ -70,6 +73,79 @@ QString SearchQuery::Private::logicOperatorToString(SearchQuery::LogicOperator o
     return QString();
 }
 
+QList<SearchQuery> SearchQuery::Private::splitDisjunction(const SearchQuery &query, int maxLength)
+{
+    const QString separator = logicOperatorToString(Or);
+    QList<SearchQuery> result;
+    SearchQuery chunk(Or);
+    // Length of the serialized chunk, including the enclosing parentheses
+    int chunkLength = 2;
+
+    for (const SearchQuery &subquery : std::as_const(query.d->subqueries)) {
+        const int length = subquery.serialize().size();
+        if (!chunk.d->subqueries.isEmpty() && chunkLength + separator.size() + length > maxLength) {
+            result.append(chunk);
+            chunk = SearchQuery(Or);
+            chunkLength = 2;
+        }
+
+        if (chunk.d->subqueries.isEmpty() && 2 + length > maxLength) {
+            // A single term is too long, any of its parts matches as well
+            result.append(subquery.split(maxLength));
+            continue;
+        }
+
+        if (!chunk.d->subqueries.isEmpty()) {
+            chunkLength += separator.size();
+        }
+        chunk.d->subqueries.append(subquery);
+        chunkLength += length;
+    }
+
+    if (!chunk.d->subqueries.isEmpty()) {
+        result.append(chunk);
+    }
+    return result;
+}
+
+QList<SearchQuery> SearchQuery::Private::splitConjunction(const SearchQuery &query, int maxLength)
+{
+    // Only the longest disjunction is split, the rest of the conjunction is
+    // repeated in every part
+    int longest = -1;
+    int longestLength = 0;
+    for (int i = 0; i < query.d->subqueries.size(); ++i) {
+        const SearchQuery &subquery = query.d->subqueries.at(i);
+        if (subquery.d->logicOp != Or || subquery.d->subqueries.size() < 2) {
+            continue;
+        }
+        const int length = subquery.serialize().size();
+        if (length > longestLength) {
+            longest = i;
+            longestLength = length;
+        }
+    }
+
+    if (longest < 0) {
+        return {query};
+    }
+
+    const int budget = maxLength - (query.serialize().size() - longestLength);
+    const QList<SearchQuery> parts = splitDisjunction(query.d->subqueries.at(longest), budget);
+    if (parts.size() < 2) {
+        return {query};
+    }
+
+    QList<SearchQuery> result;
+    for (const SearchQuery &part : parts) {
+        SearchQuery conjunction = query;
+        conjunction.d->subqueries[longest] = part;
+        // Another disjunction may still be too long
+        result.append(conjunction.split(maxLength));
+    }
+    return result;
+}
+
 SearchQuery::SearchQuery(SearchQuery::LogicOperator op)
     : d(new Private)
 {
@@ -129,3 +205,15 @@ QString SearchQuery::serialize() const
 
     return r;
 }
+
+QList<SearchQuery> SearchQuery::split(int maxLength) const
+{
+    if (isEmpty() || d->subqueries.isEmpty() || serialize().size() <= maxLength) {
+        return {*this};
+    }
+
+    if (d->logicOp == Or) {
+        return Private::splitDisjunction(*this, maxLength);
+    }
+    return Private::splitConjunction(*this, maxLength);
+}
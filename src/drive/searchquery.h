@@ -40,6 +40,21 @@ public:
 
     [[nodiscard]] QString serialize() const;
 
+    /**
+     * @brief Splits the query into queries that serialize to at most @p maxLength characters
+     *
+     * Disjunctions that are too long are split into several smaller
+     * disjunctions, a conjunction is split by splitting its longest
+     * disjunction. Together the returned queries match the same items as this
+     * query, but an item may be matched by more than one of them.
+     *
+     * Queries that cannot be split are returned as they are, even when they
+     * are longer than @p maxLength.
+     *
+     * @since 6.9.0
+     */
+    [[nodiscard]] QList<SearchQuery> split(int maxLength) const;
+
 private:
     class Private;
     QSharedDataPointer<Private> d;
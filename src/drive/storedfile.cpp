@@ -0,0 +1,269 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "storedfile_p.h"
+#include "file.h"
+#include "parentreference.h"
+#include "permission.h"
+#include "user.h"
+
+#include <QBuffer>
+#include <QDateTime>
+#include <QImage>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+
+QString dateToString(const QDateTime &date)
+{
+    return date.isValid() ? date.toString(Qt::ISODateWithMs) : QString();
+}
+
+QString roleToName(Permission::Role role)
+{
+    switch (role) {
+    case Permission::OwnerRole:
+        return QStringLiteral("owner");
+    case Permission::ReaderRole:
+        return QStringLiteral("reader");
+    case Permission::WriterRole:
+        return QStringLiteral("writer");
+    case Permission::CommenterRole:
+        return QStringLiteral("commenter");
+    case Permission::OrganizerRole:
+        return QStringLiteral("organizer");
+    case Permission::FileOrganizerRole:
+        return QStringLiteral("fileOrganizer");
+    default:
+        return QString();
+    }
+}
+
+QString typeToName(Permission::Type type)
+{
+    switch (type) {
+    case Permission::TypeUser:
+        return QStringLiteral("user");
+    case Permission::TypeGroup:
+        return QStringLiteral("group");
+    case Permission::TypeDomain:
+        return QStringLiteral("domain");
+    case Permission::TypeAnyone:
+        return QStringLiteral("anyone");
+    default:
+        return QString();
+    }
+}
+
+QString permissionTypeToName(Permission::PermissionDetails::PermissionType permissionType)
+{
+    switch (permissionType) {
+    case Permission::PermissionDetails::TypeFile:
+        return QStringLiteral("file");
+    case Permission::PermissionDetails::TypeMember:
+        return QStringLiteral("member");
+    default:
+        return QString();
+    }
+}
+
+QStringList rolesToNames(const QList<Permission::Role> &roles)
+{
+    QStringList names;
+    names.reserve(roles.size());
+    for (Permission::Role role : roles) {
+        names << roleToName(role);
+    }
+    return names;
+}
+
+QVariantMap permissionToJSON(const PermissionPtr &permission)
+{
+    QVariantList details;
+    const auto permissionDetails = permission->permissionDetails();
+    for (const Permission::PermissionDetailsPtr &detail : permissionDetails) {
+        details << QVariantMap{{QStringLiteral("permissionType"), permissionTypeToName(detail->permissionType())},
+                               {QStringLiteral("role"), roleToName(detail->role())},
+                               {QStringLiteral("additionalRoles"), rolesToNames(detail->additionalRoles())},
+                               {QStringLiteral("inheritedFrom"), detail->inheritedFrom()},
+                               {QStringLiteral("inherited"), detail->inherited()}};
+    }
+
+    return {{QStringLiteral("kind"), QStringLiteral("drive#permission")},
+            {QStringLiteral("etag"), permission->etag()},
+            {QStringLiteral("id"), permission->id()},
+            {QStringLiteral("selfLink"), permission->selfLink()},
+            {QStringLiteral("name"), permission->name()},
+            {QStringLiteral("role"), roleToName(permission->role())},
+            {QStringLiteral("additionalRoles"), rolesToNames(permission->additionalRoles())},
+            {QStringLiteral("type"), typeToName(permission->type())},
+            {QStringLiteral("authKey"), permission->authKey()},
+            {QStringLiteral("withLink"), permission->withLink()},
+            {QStringLiteral("photoLink"), permission->photoLink()},
+            {QStringLiteral("value"), permission->value()},
+            {QStringLiteral("emailAddress"), permission->emailAddress()},
+            {QStringLiteral("domain"), permission->domain()},
+            {QStringLiteral("expirationDate"), dateToString(permission->expirationDate())},
+            {QStringLiteral("deleted"), permission->deleted()},
+            {QStringLiteral("permissionDetails"), details}};
+}
+
+QVariantMap userToJSON(const UserPtr &user)
+{
+    return {{QStringLiteral("kind"), QStringLiteral("drive#user")},
+            {QStringLiteral("displayName"), user->displayName()},
+            {QStringLiteral("picture"), QVariantMap{{QStringLiteral("url"), user->pictureUrl()}}},
+            {QStringLiteral("isAuthenticatedUser"), user->isAuthenticatedUser()},
+            {QStringLiteral("permissionId"), user->permissionId()}};
+}
+
+QVariantMap imageMediaMetadataToJSON(const File::ImageMediaMetadataPtr &metadata)
+{
+    QVariantMap map{{QStringLiteral("width"), metadata->width()},
+                    {QStringLiteral("height"), metadata->height()},
+                    {QStringLiteral("rotation"), metadata->rotation()},
+                    {QStringLiteral("date"), metadata->date()},
+                    {QStringLiteral("cameraMake"), metadata->cameraMake()},
+                    {QStringLiteral("cameraModel"), metadata->cameraModel()},
+                    {QStringLiteral("exposureTime"), metadata->exposureTime()},
+                    {QStringLiteral("aperture"), metadata->aperture()},
+                    {QStringLiteral("flashUsed"), metadata->flashUsed()},
+                    {QStringLiteral("focalLength"), metadata->focalLength()},
+                    {QStringLiteral("isoSpeed"), metadata->isoSpeed()},
+                    {QStringLiteral("meteringMode"), metadata->meteringMode()},
+                    {QStringLiteral("sensor"), metadata->sensor()},
+                    {QStringLiteral("exposureMode"), metadata->exposureMode()},
+                    {QStringLiteral("colorSpace"), metadata->colorSpace()},
+                    {QStringLiteral("whiteBalance"), metadata->whiteBalance()},
+                    {QStringLiteral("exposureBias"), metadata->exposureBias()},
+                    {QStringLiteral("maxApertureValue"), metadata->maxApertureValue()},
+                    {QStringLiteral("subjectDistance"), metadata->subjectDistance()},
+                    {QStringLiteral("lens"), metadata->lens()}};
+    if (const auto location = metadata->location()) {
+        map[QStringLiteral("location")] = QVariantMap{{QStringLiteral("latitude"), location->latitude()},
+                                                      {QStringLiteral("longitude"), location->longitude()},
+                                                      {QStringLiteral("altitude"), location->altitude()}};
+    }
+    return map;
+}
+
+QVariantMap thumbnailToJSON(const File::ThumbnailPtr &thumbnail)
+{
+    QVariantMap map{{File::Thumbnail::Fields::MimeType, thumbnail->mimeType()}};
+    if (!thumbnail->image().isNull()) {
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        thumbnail->image().save(&buffer, "PNG");
+        map[File::Thumbnail::Fields::Image] = QString::fromLatin1(data.toBase64());
+    }
+    return map;
+}
+
+} // namespace
+
+QVariantMap StoredFile::toJSON(const FilePtr &file)
+{
+    QVariantMap map;
+    map[File::Fields::Kind] = QStringLiteral("drive#file");
+    map[File::Fields::Etag] = file->etag();
+    map[File::Fields::Id] = file->id();
+    map[File::Fields::SelfLink] = file->selfLink();
+    map[File::Fields::Title] = file->title();
+    map[File::Fields::MimeType] = file->mimeType();
+    map[File::Fields::Description] = file->description();
+
+    if (const auto labels = file->labels()) {
+        map[File::Fields::Labels] = QVariantMap{{QStringLiteral("starred"), labels->starred()},
+                                                {QStringLiteral("hidden"), labels->hidden()},
+                                                {QStringLiteral("trashed"), labels->trashed()},
+                                                {QStringLiteral("restricted"), labels->restricted()},
+                                                {QStringLiteral("viewed"), labels->viewed()}};
+    }
+
+    map[File::Fields::CreatedDate] = dateToString(file->createdDate());
+    map[File::Fields::ModifiedDate] = dateToString(file->modifiedDate());
+    map[File::Fields::ModifiedByMeDate] = dateToString(file->modifiedByMeDate());
+    map[File::Fields::DownloadUrl] = file->downloadUrl();
+
+    if (const auto indexableText = file->indexableText()) {
+        map[File::Fields::IndexableText] = QVariantMap{{QStringLiteral("text"), indexableText->text()}};
+    }
+    if (const auto userPermission = file->userPermission()) {
+        map[File::Fields::UserPermission] = permissionToJSON(userPermission);
+    }
+
+    // Same as in the API, int64 values are stored as strings
+    map[File::Fields::FileExtension] = file->fileExtension();
+    map[File::Fields::Md5Checksum] = file->md5Checksum();
+    map[File::Fields::FileSize] = QString::number(file->fileSize());
+    map[File::Fields::AlternateLink] = file->alternateLink();
+    map[File::Fields::EmbedLink] = file->embedLink();
+    map[File::Fields::Version] = QString::number(file->version());
+    map[File::Fields::SharedWithMeDate] = dateToString(file->sharedWithMeDate());
+
+    QVariantList parents;
+    const auto parentReferences = file->parents();
+    parents.reserve(parentReferences.size());
+    for (const ParentReferencePtr &parent : parentReferences) {
+        parents << QVariantMap{{QStringLiteral("kind"), QStringLiteral("drive#parentReference")},
+                               {QStringLiteral("id"), parent->id()},
+                               {QStringLiteral("selfLink"), parent->selfLink()},
+                               {QStringLiteral("parentLink"), parent->parentLink()},
+                               {QStringLiteral("isRoot"), parent->isRoot()}};
+    }
+    map[File::Fields::Parents] = parents;
+
+    QVariantMap exportLinks;
+    const auto links = file->exportLinks();
+    for (auto it = links.cbegin(), end = links.cend(); it != end; ++it) {
+        exportLinks.insert(it.key(), it.value());
+    }
+    map[File::Fields::ExportLinks] = exportLinks;
+
+    map[QStringLiteral("originalFileName")] = file->originalFileName();
+    map[QStringLiteral("quotaBytesUsed")] = QString::number(file->quotaBytesUsed());
+    map[File::Fields::OwnerNames] = file->ownerNames();
+    map[QStringLiteral("lastModifyingUserName")] = file->lastModifyingUserName();
+    map[File::Fields::Editable] = file->editable();
+    map[File::Fields::WritersCanShare] = file->writersCanShare();
+    map[File::Fields::ThumbnailLink] = file->thumbnailLink();
+    map[File::Fields::LastViewedByMeDate] = dateToString(file->lastViewedByMeDate());
+    map[File::Fields::WebContentLink] = file->webContentLink();
+    map[File::Fields::ExplicitlyTrashed] = file->explicitlyTrashed();
+
+    if (const auto metadata = file->imageMediaMetadata()) {
+        map[File::Fields::ImageMediaMetadata] = imageMediaMetadataToJSON(metadata);
+    }
+    if (const auto thumbnail = file->thumbnail()) {
+        map[File::Fields::Thumbnail] = thumbnailToJSON(thumbnail);
+    }
+
+    map[File::Fields::WebViewLink] = file->webViewLink();
+    map[File::Fields::IconLink] = file->iconLink();
+    map[File::Fields::Shared] = file->shared();
+
+    QVariantList owners;
+    const auto users = file->owners();
+    owners.reserve(users.size());
+    for (const UserPtr &owner : users) {
+        if (owner) {
+            owners << userToJSON(owner);
+        }
+    }
+    map[File::Fields::Owners] = owners;
+
+    if (const auto lastModifyingUser = file->lastModifyingUser()) {
+        map[File::Fields::LastModifyingUser] = userToJSON(lastModifyingUser);
+    }
+
+    return map;
+}
@@ -0,0 +1,41 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "types.h"
+
+#include <QVariantMap>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @internal
+ *
+ * Serialization of files for the local stores of DriveMirror and FolderSync.
+ *
+ * File::toJSON() only serializes the properties that can be sent to the
+ * server. The stores need the read-only ones as well, so that File::fromJSON()
+ * restores the file exactly as it was received.
+ */
+class Q_DECL_HIDDEN StoredFile
+{
+public:
+    /**
+     * Returns @p file as a "drive#file" resource including all its properties
+     */
+    static QVariantMap toJSON(const FilePtr &file);
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
@@ -0,0 +1,341 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "thumbnailcache.h"
+#include "debug.h"
+
+#include <QCache>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QPointer>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+#include <QThreadPool>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+static constexpr qint64 DefaultMemoryBudget = 64 * 1024 * 1024;
+static constexpr qint64 DefaultDiskBudget = 256 * 1024 * 1024;
+}
+
+class Q_DECL_HIDDEN ThumbnailCache::Private
+{
+public:
+    Private(ThumbnailCache *parent);
+
+    static QString key(const QString &fileId, const QString &etag);
+    QString diskPath(const QString &fileId, const QString &etag) const;
+    static QStringList diskNameFilters(const QString &fileId);
+
+    [[nodiscard]] bool loadFromDisk(const QString &fileId, const QString &etag);
+    void store(const QString &fileId, const QString &etag, const QByteArray &data);
+    void loadFinished(const QString &fileId, const QString &etag, const QImage &image);
+
+    // Called from the thread pool
+    void writeToDisk(const QString &directory, const QString &fileId, const QString &path, const QByteArray &data);
+    void trimDisk(const QString &directory);
+
+    QCache<QString, QImage> images;
+    QSet<QString> loading;
+    QString diskDirectory;
+    QThreadPool pool;
+
+    QMutex diskMutex;
+    // Guarded by diskMutex
+    qint64 diskBudget = DefaultDiskBudget;
+    qint64 diskSize = -1;
+
+private:
+    ThumbnailCache *const q;
+};
+
+ThumbnailCache::Private::Private(ThumbnailCache *parent)
+    : q(parent)
+{
+    images.setMaxCost(DefaultMemoryBudget);
+}
+
+QString ThumbnailCache::Private::key(const QString &fileId, const QString &etag)
+{
+    return fileId + QLatin1Char('/') + etag;
+}
+
+QString ThumbnailCache::Private::diskPath(const QString &fileId, const QString &etag) const
+{
+    if (diskDirectory.isEmpty()) {
+        return QString();
+    }
+
+    // Etags contain quotes and slashes, they can't be used in file names directly
+    const QByteArray etagHash = QCryptographicHash::hash(etag.toUtf8(), QCryptographicHash::Md5).toHex();
+    return diskDirectory + QLatin1Char('/') + fileId + QLatin1Char('.') + QString::fromLatin1(etagHash);
+}
+
+QStringList ThumbnailCache::Private::diskNameFilters(const QString &fileId)
+{
+    // File IDs contain dashes but never dots, so the filter does not match
+    // files whose ID only starts with this one
+    return {fileId + QLatin1StringView(".*")};
+}
+
+bool ThumbnailCache::Private::loadFromDisk(const QString &fileId, const QString &etag)
+{
+    const QString path = diskPath(fileId, etag);
+    if (path.isEmpty() || !QFileInfo::exists(path)) {
+        return false;
+    }
+
+    loading.insert(key(fileId, etag));
+    pool.start([this, fileId, etag, path]() {
+        QImage image;
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly)) {
+            image = QImage::fromData(file.readAll());
+            // Keep recently used thumbnails when trimming the disk cache
+            file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+            file.close();
+        }
+        if (image.isNull()) {
+            qCWarning(KGAPIDebug) << "Removing unreadable thumbnail" << path;
+            QMutexLocker locker(&diskMutex);
+            const qint64 size = QFileInfo(path).size();
+            if (QFile::remove(path) && diskSize >= 0) {
+                diskSize -= size;
+            }
+        }
+
+        QMetaObject::invokeMethod(
+            q,
+            [this, fileId, etag, image]() {
+                loadFinished(fileId, etag, image);
+            },
+            Qt::QueuedConnection);
+    });
+    return true;
+}
+
+void ThumbnailCache::Private::store(const QString &fileId, const QString &etag, const QByteArray &data)
+{
+    loading.insert(key(fileId, etag));
+    const QString directory = diskDirectory;
+    const QString path = diskPath(fileId, etag);
+    pool.start([this, directory, fileId, etag, path, data]() {
+        if (!path.isEmpty()) {
+            writeToDisk(directory, fileId, path, data);
+        }
+        const QImage image = QImage::fromData(data);
+
+        QMetaObject::invokeMethod(
+            q,
+            [this, fileId, etag, image]() {
+                loadFinished(fileId, etag, image);
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+void ThumbnailCache::Private::loadFinished(const QString &fileId, const QString &etag, const QImage &image)
+{
+    loading.remove(key(fileId, etag));
+    if (!image.isNull()) {
+        q->insert(fileId, etag, image);
+    }
+
+    Q_EMIT q->imageLoaded(fileId, etag, image);
+}
+
+void ThumbnailCache::Private::writeToDisk(const QString &directory, const QString &fileId, const QString &path, const QByteArray &data)
+{
+    QMutexLocker locker(&diskMutex);
+
+    QDir dir(directory);
+    if (!dir.mkpath(QStringLiteral("."))) {
+        qCWarning(KGAPIDebug) << "Failed to create thumbnail cache directory" << directory;
+        return;
+    }
+
+    if (diskSize < 0) {
+        diskSize = 0;
+        const auto entries = dir.entryInfoList(QDir::Files);
+        for (const QFileInfo &entry : entries) {
+            diskSize += entry.size();
+        }
+    }
+
+    // Older versions of the thumbnail are not needed anymore
+    const auto oldVersions = dir.entryInfoList(diskNameFilters(fileId), QDir::Files);
+    for (const QFileInfo &entry : oldVersions) {
+        if (QFile::remove(entry.absoluteFilePath())) {
+            diskSize -= entry.size();
+        }
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCWarning(KGAPIDebug) << "Failed to write thumbnail" << path << file.errorString();
+        return;
+    }
+    diskSize += data.size();
+
+    if (diskSize > diskBudget) {
+        trimDisk(directory);
+    }
+}
+
+void ThumbnailCache::Private::trimDisk(const QString &directory)
+{
+    // Oldest first
+    const auto entries = QDir(directory).entryInfoList(QDir::Files, QDir::Time | QDir::Reversed);
+    for (const QFileInfo &entry : entries) {
+        if (diskSize <= diskBudget) {
+            break;
+        }
+        if (QFile::remove(entry.absoluteFilePath())) {
+            diskSize -= entry.size();
+        }
+    }
+}
+
+ThumbnailCache::ThumbnailCache(QObject *parent)
+    : QObject(parent)
+    , d(new Private(this))
+{
+}
+
+ThumbnailCache::~ThumbnailCache()
+{
+    // Workers post their results to this object, they must not outlive it
+    d->pool.waitForDone();
+}
+
+ThumbnailCache *ThumbnailCache::globalCache()
+{
+    static QPointer<ThumbnailCache> cache;
+    if (!cache) {
+        cache = new ThumbnailCache(QCoreApplication::instance());
+        cache->setDiskCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1StringView("/kgapi/thumbnails"));
+    }
+    return cache;
+}
+
+qint64 ThumbnailCache::memoryBudget() const
+{
+    return d->images.maxCost();
+}
+
+void ThumbnailCache::setMemoryBudget(qint64 bytes)
+{
+    d->images.setMaxCost(qMax<qint64>(0, bytes));
+}
+
+QString ThumbnailCache::diskCacheDirectory() const
+{
+    return d->diskDirectory;
+}
+
+void ThumbnailCache::setDiskCacheDirectory(const QString &directory)
+{
+    QMutexLocker locker(&d->diskMutex);
+    d->diskDirectory = directory;
+    d->diskSize = -1;
+}
+
+qint64 ThumbnailCache::diskBudget() const
+{
+    QMutexLocker locker(&d->diskMutex);
+    return d->diskBudget;
+}
+
+void ThumbnailCache::setDiskBudget(qint64 bytes)
+{
+    QMutexLocker locker(&d->diskMutex);
+    d->diskBudget = qMax<qint64>(0, bytes);
+}
+
+QImage ThumbnailCache::image(const QString &fileId, const QString &etag) const
+{
+    const QImage *image = d->images.object(Private::key(fileId, etag));
+    return image ? *image : QImage();
+}
+
+void ThumbnailCache::insert(const QString &fileId, const QString &etag, const QImage &image)
+{
+    if (image.isNull()) {
+        return;
+    }
+
+    d->images.insert(Private::key(fileId, etag), new QImage(image), image.sizeInBytes());
+}
+
+bool ThumbnailCache::load(const QString &fileId, const QString &etag)
+{
+    const QString key = Private::key(fileId, etag);
+    if (d->loading.contains(key) || d->loadFromDisk(fileId, etag)) {
+        return true;
+    }
+
+    // The caller downloads the thumbnail, everyone else waits for store()
+    d->loading.insert(key);
+    return false;
+}
+
+void ThumbnailCache::store(const QString &fileId, const QString &etag, const QByteArray &data)
+{
+    if (data.isEmpty()) {
+        d->loadFinished(fileId, etag, QImage());
+        return;
+    }
+
+    d->store(fileId, etag, data);
+}
+
+void ThumbnailCache::remove(const QString &fileId)
+{
+    const QString prefix = fileId + QLatin1Char('/');
+    const auto keys = d->images.keys();
+    for (const QString &key : keys) {
+        if (key.startsWith(prefix)) {
+            d->images.remove(key);
+        }
+    }
+
+    QMutexLocker locker(&d->diskMutex);
+    if (!d->diskDirectory.isEmpty()) {
+        const auto entries = QDir(d->diskDirectory).entryInfoList(Private::diskNameFilters(fileId), QDir::Files);
+        for (const QFileInfo &entry : entries) {
+            if (QFile::remove(entry.absoluteFilePath()) && d->diskSize >= 0) {
+                d->diskSize -= entry.size();
+            }
+        }
+    }
+}
+
+void ThumbnailCache::clear()
+{
+    d->images.clear();
+
+    QMutexLocker locker(&d->diskMutex);
+    if (!d->diskDirectory.isEmpty()) {
+        const auto entries = QDir(d->diskDirectory).entryInfoList(QDir::Files);
+        for (const QFileInfo &entry : entries) {
+            QFile::remove(entry.absoluteFilePath());
+        }
+        d->diskSize = -1;
+    }
+}
+
+#include "moc_thumbnailcache.cpp"
@@ -0,0 +1,137 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "kgapidrive_export.h"
+
+#include <QImage>
+#include <QObject>
+#include <QScopedPointer>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @brief Two-level cache of file thumbnails
+ *
+ * Decoded thumbnails are kept in memory until the memory budget is exceeded,
+ * then the least recently used ones are dropped. The original image data is
+ * also stored in a disk cache directory, so thumbnails survive restarts of
+ * the application. Entries are keyed by file ID and etag, so a thumbnail is
+ * fetched again when the file changes.
+ *
+ * Disk access and image decoding happen in a thread pool, the cache itself
+ * must only be used from the thread it lives in.
+ *
+ * @see ThumbnailFetchJob
+ * @since 6.9.0
+ */
+class KGAPIDRIVE_EXPORT ThumbnailCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ThumbnailCache(QObject *parent = nullptr);
+    ~ThumbnailCache() override;
+
+    /**
+     * @brief Returns the cache shared by all ThumbnailFetchJobs by default
+     *
+     * The shared cache stores thumbnails in the application's cache location.
+     */
+    [[nodiscard]] static ThumbnailCache *globalCache();
+
+    /**
+     * @brief Maximum size of decoded images kept in memory, in bytes
+     *
+     * Defaults to 64 MiB.
+     */
+    [[nodiscard]] qint64 memoryBudget() const;
+    void setMemoryBudget(qint64 bytes);
+
+    /**
+     * @brief Directory where the thumbnails are stored
+     *
+     * An empty path, the default, disables the disk cache.
+     */
+    [[nodiscard]] QString diskCacheDirectory() const;
+    void setDiskCacheDirectory(const QString &directory);
+
+    /**
+     * @brief Maximum size of the disk cache, in bytes
+     *
+     * When exceeded, the least recently used thumbnails are removed from the
+     * disk. Defaults to 256 MiB.
+     */
+    [[nodiscard]] qint64 diskBudget() const;
+    void setDiskBudget(qint64 bytes);
+
+    /**
+     * @brief Returns thumbnail of file @p fileId in version @p etag if it is in memory
+     *
+     * Returns a null image otherwise. The disk cache is not consulted, use
+     * ThumbnailFetchJob to load thumbnails that are not in memory.
+     */
+    [[nodiscard]] QImage image(const QString &fileId, const QString &etag) const;
+
+    /**
+     * @brief Stores @p image as thumbnail of file @p fileId in memory
+     */
+    void insert(const QString &fileId, const QString &etag, const QImage &image);
+
+    /**
+     * @brief Starts loading thumbnail of file @p fileId in version @p etag
+     *
+     * Returns true when the thumbnail is being loaded from the disk cache, or
+     * is already being loaded for someone else, imageLoaded() is emitted once
+     * it is ready. Returns false when the thumbnail has to be downloaded. The
+     * caller must then pass the downloaded data to store(), everyone else
+     * waits for it instead of downloading the thumbnail again.
+     */
+    [[nodiscard]] bool load(const QString &fileId, const QString &etag);
+
+    /**
+     * @brief Stores downloaded thumbnail @p data of file @p fileId in version @p etag
+     *
+     * The data is written to the disk cache and decoded in a thread pool,
+     * imageLoaded() is emitted when done. Empty @p data means the download
+     * failed, imageLoaded() is emitted right away with a null image.
+     */
+    void store(const QString &fileId, const QString &etag, const QByteArray &data);
+
+    /**
+     * @brief Removes all versions of thumbnail of file @p fileId from memory and disk
+     */
+    void remove(const QString &fileId);
+
+    /**
+     * @brief Removes all thumbnails from memory and disk
+     */
+    void clear();
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted when loading of a thumbnail from disk or network finishes
+     *
+     * @p image is null when the thumbnail could not be loaded.
+     */
+    void imageLoaded(const QString &fileId, const QString &etag, const QImage &image);
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
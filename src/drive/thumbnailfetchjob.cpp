@@ -0,0 +1,233 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "thumbnailfetchjob.h"
+#include "account.h"
+#include "debug.h"
+#include "file.h"
+#include "filefetchcontentjob.h"
+#include "thumbnailcache.h"
+
+#include <QHash>
+#include <QQueue>
+
+using namespace KGAPI2;
+using namespace KGAPI2::Drive;
+
+namespace
+{
+static constexpr int DefaultConcurrentRequests = 8;
+}
+
+class Q_DECL_HIDDEN ThumbnailFetchJob::Private
+{
+public:
+    Private(ThumbnailFetchJob *parent);
+
+    void processFile(const FilePtr &file);
+    void startDownloads();
+    void downloadFinished(FileFetchContentJob *job, const FilePtr &file);
+    void imageLoaded(const QString &fileId, const QString &etag, const QImage &image);
+    void thumbnailReady(const QString &fileId, const QImage &image);
+    void checkFinished();
+
+    FilesList files;
+    ThumbnailCache *cache = nullptr;
+    QMetaObject::Connection cacheConnection;
+
+    QHash<QString /* file ID */, QImage> thumbnails;
+    // Thumbnails being loaded by the cache, either for this or for another job
+    QHash<QString /* file ID */, QString /* etag */> waiting;
+    // Downloads owned by this job, the cache is notified when they finish
+    QHash<QString /* file ID */, QString /* etag */> downloading;
+    QQueue<FilePtr> pendingDownloads;
+    int downloadsInFlight = 0;
+    int processedFiles = 0;
+
+private:
+    ThumbnailFetchJob *const q;
+};
+
+ThumbnailFetchJob::Private::Private(ThumbnailFetchJob *parent)
+    : q(parent)
+{
+}
+
+void ThumbnailFetchJob::Private::processFile(const FilePtr &file)
+{
+    const QString fileId = file->id();
+    const QString etag = file->etag();
+
+    if (file->thumbnailLink().isEmpty()) {
+        // Thumbnails uploaded by the application are embedded in the metadata
+        const File::ThumbnailPtr embedded = file->thumbnail();
+        thumbnailReady(fileId, embedded ? embedded->image() : QImage());
+        return;
+    }
+
+    const QImage cached = cache->image(fileId, etag);
+    if (!cached.isNull()) {
+        thumbnailReady(fileId, cached);
+        return;
+    }
+
+    waiting.insert(fileId, etag);
+    if (cache->load(fileId, etag)) {
+        return;
+    }
+
+    // Other jobs wait for this download instead of starting their own
+    downloading.insert(fileId, etag);
+    pendingDownloads.enqueue(file);
+}
+
+void ThumbnailFetchJob::Private::startDownloads()
+{
+    const int window = q->maxConcurrentRequests();
+    while ((window <= 0 || downloadsInFlight < window) && !pendingDownloads.isEmpty()) {
+        const FilePtr file = pendingDownloads.dequeue();
+        auto job = new FileFetchContentJob(file->thumbnailLink(), q->account(), q);
+        QObject::connect(job, &Job::finished, q, [this, job, file]() {
+            downloadFinished(job, file);
+        });
+        ++downloadsInFlight;
+    }
+}
+
+void ThumbnailFetchJob::Private::downloadFinished(FileFetchContentJob *job, const FilePtr &file)
+{
+    job->deleteLater();
+    if (!q->isRunning()) {
+        return;
+    }
+
+    --downloadsInFlight;
+    const QString etag = downloading.take(file->id());
+    if (job->error() == KGAPI2::NoError) {
+        // The thumbnail is reported back by the cache once it's decoded
+        cache->store(file->id(), etag, job->data());
+    } else {
+        qCWarning(KGAPIDebug) << "Failed to download thumbnail of file" << file->id() << ":" << job->errorString();
+        if (job->error() != KGAPI2::NotFound && job->error() != KGAPI2::Forbidden) {
+            // Not specific to this file, report it
+            q->setError(job->error());
+            q->setErrorString(job->errorString());
+        }
+        cache->store(file->id(), etag, QByteArray());
+    }
+
+    startDownloads();
+}
+
+void ThumbnailFetchJob::Private::imageLoaded(const QString &fileId, const QString &etag, const QImage &image)
+{
+    const auto it = waiting.constFind(fileId);
+    if (it == waiting.cend() || *it != etag) {
+        return;
+    }
+
+    waiting.erase(it);
+    thumbnailReady(fileId, image);
+    checkFinished();
+}
+
+void ThumbnailFetchJob::Private::thumbnailReady(const QString &fileId, const QImage &image)
+{
+    q->emitProgress(++processedFiles, files.size());
+    if (image.isNull()) {
+        return;
+    }
+
+    thumbnails.insert(fileId, image);
+    Q_EMIT q->thumbnailFetched(q, fileId, image);
+}
+
+void ThumbnailFetchJob::Private::checkFinished()
+{
+    if (q->isRunning() && waiting.isEmpty()) {
+        q->emitFinished();
+    }
+}
+
+ThumbnailFetchJob::ThumbnailFetchJob(const FilePtr &file, const AccountPtr &account, QObject *parent)
+    : ThumbnailFetchJob(FilesList{file}, account, parent)
+{
+}
+
+ThumbnailFetchJob::ThumbnailFetchJob(const FilesList &files, const AccountPtr &account, QObject *parent)
+    : FetchJob(account, parent)
+    , d(new Private(this))
+{
+    d->files = files;
+    setMaxConcurrentRequests(DefaultConcurrentRequests);
+}
+
+ThumbnailFetchJob::~ThumbnailFetchJob() = default;
+
+FilesList ThumbnailFetchJob::files() const
+{
+    return d->files;
+}
+
+ThumbnailCache *ThumbnailFetchJob::cache() const
+{
+    return d->cache ? d->cache : ThumbnailCache::globalCache();
+}
+
+void ThumbnailFetchJob::setCache(ThumbnailCache *cache)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify cache property when job is running";
+        return;
+    }
+
+    d->cache = cache;
+}
+
+QImage ThumbnailFetchJob::thumbnail(const QString &fileId) const
+{
+    return d->thumbnails.value(fileId);
+}
+
+void ThumbnailFetchJob::start()
+{
+    d->thumbnails.clear();
+    d->waiting.clear();
+    d->downloading.clear();
+    d->pendingDownloads.clear();
+    d->downloadsInFlight = 0;
+    d->processedFiles = 0;
+
+    if (!d->cache) {
+        d->cache = ThumbnailCache::globalCache();
+    }
+    d->cacheConnection = connect(d->cache, &ThumbnailCache::imageLoaded, this, [this](const QString &fileId, const QString &etag, const QImage &image) {
+        d->imageLoaded(fileId, etag, image);
+    });
+
+    for (const FilePtr &file : std::as_const(d->files)) {
+        d->processFile(file);
+    }
+    d->startDownloads();
+    d->checkFinished();
+}
+
+void ThumbnailFetchJob::aboutToFinish()
+{
+    disconnect(d->cacheConnection);
+
+    // Don't leave other jobs waiting for downloads that will never finish
+    const auto downloading = std::exchange(d->downloading, {});
+    for (auto it = downloading.cbegin(); it != downloading.cend(); ++it) {
+        d->cache->store(it.key(), it.value(), QByteArray());
+    }
+
+    FetchJob::aboutToFinish();
+}
+
+#include "moc_thumbnailfetchjob.cpp"
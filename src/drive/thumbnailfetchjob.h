@@ -0,0 +1,85 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "fetchjob.h"
+#include "kgapidrive_export.h"
+
+#include <QImage>
+#include <QScopedPointer>
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+class ThumbnailCache;
+
+/**
+ * @brief Fetches thumbnails of files
+ *
+ * Thumbnails are looked up in a ThumbnailCache first: thumbnails in memory
+ * are reported right when the job starts, thumbnails on disk are decoded in
+ * a background thread and only the remaining ones are downloaded from
+ * File::thumbnailLink(), up to Job::maxConcurrentRequests() (8 by default)
+ * at once. When another job is already loading the thumbnail of the same
+ * file version, the job waits for it instead of downloading it again.
+ *
+ * Files without a thumbnail, and files whose thumbnail can't be downloaded,
+ * do not fail the job, their thumbnail() is a null image.
+ *
+ * The files must have been fetched with the ID, etag and thumbnailLink
+ * fields.
+ *
+ * @since 6.9.0
+ */
+class KGAPIDRIVE_EXPORT ThumbnailFetchJob : public KGAPI2::FetchJob
+{
+    Q_OBJECT
+
+public:
+    explicit ThumbnailFetchJob(const FilePtr &file, const AccountPtr &account, QObject *parent = nullptr);
+    explicit ThumbnailFetchJob(const FilesList &files, const AccountPtr &account, QObject *parent = nullptr);
+    ~ThumbnailFetchJob() override;
+
+    [[nodiscard]] FilesList files() const;
+
+    /**
+     * @brief Cache to load the thumbnails from and store them to
+     *
+     * Defaults to ThumbnailCache::globalCache(). The cache must outlive the job.
+     */
+    [[nodiscard]] ThumbnailCache *cache() const;
+    void setCache(ThumbnailCache *cache);
+
+    /**
+     * @brief Returns thumbnail of file @p fileId
+     */
+    [[nodiscard]] QImage thumbnail(const QString &fileId) const;
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted as soon as thumbnail of file @p fileId is available
+     */
+    void thumbnailFetched(KGAPI2::Drive::ThumbnailFetchJob *job, const QString &fileId, const QImage &thumbnail);
+
+protected:
+    void start() override;
+    void aboutToFinish() override;
+
+private:
+    class Private;
+    QScopedPointer<Private> const d;
+    friend class Private;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
@@ -0,0 +1,133 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#include "uploadbodydevice_p.h"
+#include "debug.h"
+
+#include <QFile>
+#include <QTimer>
+
+using namespace KGAPI2::Drive;
+
+UploadBodyDevice::UploadBodyDevice(QObject *parent)
+    : QIODevice(parent)
+{
+}
+
+UploadBodyDevice::~UploadBodyDevice()
+{
+    for (const Part &part : std::as_const(mParts)) {
+        delete part.file;
+    }
+}
+
+void UploadBodyDevice::prependData(const QByteArray &data)
+{
+    mParts.prepend({data, nullptr, data.size()});
+    mSize += data.size();
+}
+
+void UploadBodyDevice::appendData(const QByteArray &data)
+{
+    mParts.append({data, nullptr, data.size()});
+    mSize += data.size();
+}
+
+bool UploadBodyDevice::appendFile(const QString &filePath)
+{
+    auto file = new QFile(filePath);
+    if (!file->open(QIODevice::ReadOnly)) {
+        qCWarning(KGAPIDebug) << "Failed to access" << filePath;
+        delete file;
+        return false;
+    }
+
+    mParts.append({QByteArray(), file, file->size()});
+    mSize += file->size();
+    return true;
+}
+
+void UploadBodyDevice::setThrottle(const QString &accountName, BandwidthLimiter::Priority priority)
+{
+    mThrottled = true;
+    mAccountName = accountName;
+    mPriority = priority;
+}
+
+bool UploadBodyDevice::isSequential() const
+{
+    return false;
+}
+
+qint64 UploadBodyDevice::size() const
+{
+    return mSize;
+}
+
+bool UploadBodyDevice::seek(qint64 pos)
+{
+    if (pos < 0 || pos > mSize || !QIODevice::seek(pos)) {
+        return false;
+    }
+
+    mPos = pos;
+    return true;
+}
+
+qint64 UploadBodyDevice::readData(char *data, qint64 maxSize)
+{
+    if (mThrottled && maxSize > 0) {
+        auto limiter = BandwidthLimiter::instance();
+        maxSize = limiter->acquire(mAccountName, BandwidthLimiter::Upload, mPriority, qMin(maxSize, mSize - mPos));
+        if (maxSize == 0) {
+            if (!mWakeUpScheduled) {
+                mWakeUpScheduled = true;
+                QTimer::singleShot(limiter->msecsUntilAvailable(mAccountName, BandwidthLimiter::Upload), this, [this]() {
+                    mWakeUpScheduled = false;
+                    Q_EMIT readyRead();
+                });
+            }
+            return 0;
+        }
+    }
+
+    qint64 read = 0;
+    qint64 partStart = 0;
+    for (const Part &part : std::as_const(mParts)) {
+        if (read == maxSize) {
+            break;
+        }
+
+        const qint64 partEnd = partStart + part.size;
+        if (mPos < partEnd) {
+            const qint64 offset = mPos - partStart;
+            const qint64 toRead = qMin(maxSize - read, part.size - offset);
+            if (part.file) {
+                if (!part.file->seek(offset) || part.file->read(data + read, toRead) != toRead) {
+                    qCWarning(KGAPIDebug) << "Failed reading" << part.file->fileName() << part.file->errorString();
+                    return read > 0 ? read : -1;
+                }
+            } else {
+                memcpy(data + read, part.data.constData() + offset, toRead);
+            }
+            read += toRead;
+            mPos += toRead;
+        }
+        partStart = partEnd;
+    }
+
+    return read;
+}
+
+qint64 UploadBodyDevice::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data)
+    Q_UNUSED(maxSize)
+
+    return -1;
+}
@@ -0,0 +1,75 @@
+/*
+ * This file is part of LibKGAPI library
+ *
+ * SPDX-FileCopyrightText: 2026 LibKGAPI Developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+ */
+
+#pragma once
+
+#include "bandwidthlimiter.h"
+
+#include <QIODevice>
+#include <QList>
+
+class QFile;
+
+namespace KGAPI2
+{
+
+namespace Drive
+{
+
+/**
+ * @internal
+ *
+ * Read-only random-access device that presents in-memory parts and files
+ * as one continuous upload body. File content is read from disk on demand,
+ * so the body is never held in memory as a whole and can be rewound when
+ * the request has to be sent again.
+ *
+ * When throttled, reads are limited by BandwidthLimiter::instance(). Once
+ * the limit is exhausted the device returns no data and emits readyRead()
+ * when more can be sent.
+ */
+class Q_DECL_HIDDEN UploadBodyDevice : public QIODevice
+{
+public:
+    explicit UploadBodyDevice(QObject *parent = nullptr);
+    ~UploadBodyDevice() override;
+
+    void prependData(const QByteArray &data);
+    void appendData(const QByteArray &data);
+    bool appendFile(const QString &filePath);
+
+    void setThrottle(const QString &accountName, BandwidthLimiter::Priority priority);
+
+    bool isSequential() const override;
+    qint64 size() const override;
+    bool seek(qint64 pos) override;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    struct Part {
+        QByteArray data;
+        QFile *file = nullptr;
+        qint64 size = 0;
+    };
+
+    QList<Part> mParts;
+    qint64 mSize = 0;
+    qint64 mPos = 0;
+
+    bool mThrottled = false;
+    bool mWakeUpScheduled = false;
+    QString mAccountName;
+    BandwidthLimiter::Priority mPriority = BandwidthLimiter::Background;
+};
+
+} // namespace Drive
+
+} // namespace KGAPI2
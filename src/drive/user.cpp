@@ -81,6 +81,13 @@ QString User::permissionId() const
     return d->permissionId;
 }
 
+const QString User::Fields::Kind = QStringLiteral("kind");
+const QString User::Fields::DisplayName = QStringLiteral("displayName");
+const QString User::Fields::PictureUrl = QStringLiteral("picture/url");
+const QString User::Fields::IsAuthenticatedUser = QStringLiteral("isAuthenticatedUser");
+const QString User::Fields::PermissionId = QStringLiteral("permissionId");
+const QString User::Fields::EmailAddress = QStringLiteral("emailAddress");
+
 UserPtr User::fromJSON(const QVariantMap &map)
 {
     if (!map.contains(QStringLiteral("kind")) || map[QStringLiteral("kind")].toString() != QLatin1StringView("drive#user")) {
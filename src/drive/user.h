@@ -55,6 +55,24 @@ public:
      */
     [[nodiscard]] QString permissionId() const;
 
+    /**
+     * @brief Names of the user properties
+     *
+     * Use with Job::buildSubfields() to fetch only some properties of
+     * the file owners, e.g. Job::buildSubfields(File::Fields::Owners, {User::Fields::Kind, User::Fields::DisplayName}).
+     * The kind property is needed to parse the user.
+     *
+     * @since 6.9.0
+     */
+    struct Fields {
+        static const QString Kind;
+        static const QString DisplayName;
+        static const QString PictureUrl;
+        static const QString IsAuthenticatedUser;
+        static const QString PermissionId;
+        static const QString EmailAddress;
+    };
+
     static UserPtr fromJSON(const QVariantMap &jsonMap);
 
 private:
@@ -7,6 +7,7 @@
  */
 
 #include "taskmodifyjob.h"
+#include "debug.h"
 #include "private/queuehelper_p.h"
 #include "task.h"
 #include "tasksservice.h"
@@ -22,6 +23,7 @@ class Q_DECL_HIDDEN TaskModifyJob::Private
 public:
     QueueHelper<TaskPtr> tasks;
     QString taskListId;
+    QHash<QString, TaskPtr> originals;
 };
 
 TaskModifyJob::TaskModifyJob(const TaskPtr &task, const QString &taskListId, const AccountPtr &account, QObject *parent)
@@ -42,6 +44,24 @@ TaskModifyJob::TaskModifyJob(const TasksList &tasks, const QString &taskListId,
 
 TaskModifyJob::~TaskModifyJob() = default;
 
+void TaskModifyJob::setOriginalTasks(const TasksList &originals)
+{
+    if (isRunning()) {
+        qCWarning(KGAPIDebug) << "Can't modify originalTasks property when job is running";
+        return;
+    }
+
+    d->originals.clear();
+    for (const TaskPtr &original : originals) {
+        d->originals.insert(original->uid(), original);
+    }
+}
+
+TasksList TaskModifyJob::originalTasks() const
+{
+    return d->originals.values();
+}
+
 void TaskModifyJob::start()
 {
     if (d->tasks.atEnd()) {
@@ -62,7 +82,12 @@ void TaskModifyJob::start()
         headers << QLatin1StringView(str) + QLatin1StringView(": ") + QLatin1StringView(request.rawHeader(str));
     }
 
-    enqueueRequest(request, rawData, QStringLiteral("application/json"));
+    const TaskPtr original = d->originals.value(task->uid());
+    if (original) {
+        enqueuePatchRequest(request, TasksService::taskToJSON(original), rawData, original->etag());
+    } else {
+        enqueueRequest(request, rawData, QStringLiteral("application/json"));
+    }
 }
 
 ObjectsList TaskModifyJob::handleReplyWithItems(const QNetworkReply *reply, const QByteArray &rawData)
@@ -54,6 +54,18 @@ public:
      */
     ~TaskModifyJob() override;
 
+    /**
+     * @brief Sets the last fetched state of the modified tasks
+     *
+     * Tasks that have a snapshot with the same UID are updated with a PATCH
+     * request carrying only the changed fields, conditional on the snapshot's
+     * ETag. Tasks without a snapshot are replaced as a whole.
+     *
+     * @since 6.9.0
+     */
+    void setOriginalTasks(const TasksList &originals);
+    [[nodiscard]] TasksList originalTasks() const;
+
 protected:
     /**
      * @brief KGAPI2::Job::start implementation